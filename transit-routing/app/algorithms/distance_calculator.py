@@ -1,27 +1,25 @@
 import math
 from typing import Dict, Tuple, List
-import pickle
-import os
 
+import numpy as np
 
-class DistanceCalculator:
-    EARTH_RADIUS = 6371000  # meters
+try:
+    # C++ 배치 거리 커널 (자동 벡터화, 계산 중 GIL 해제)
+    import pathfinding_cpp as _native
+except ImportError:  # 확장 모듈 미설치 환경 => NumPy 구현
+    _native = None
 
-    def __init__(self, cache_file="distance_cache.pkl"):
-        self.cache_file = cache_file
-        self.cache = self._load_cache()
 
-    def _load_cache(self) -> Dict:
-        """load cache file"""
-        if os.path.exists(self.cache_file):
-            with open(self.cache_file, "rb") as f:
-                return pickle.load(f)
-        return {}
+class DistanceCalculator:
+    """
+    좌표 간 거리 계산 (미터)
 
-    def save_cache(self):
-        """save cache"""
-        with open(self.cache_file, "wb") as f:
-            pickle.dump(self.cache, f)
+    - 단건: calculate_distance / haversine (순수 계산, 캐시 없음)
+    - 배치: one_to_many / many_to_many (pathfinding_cpp 커널, 없으면 NumPy 벡터 연산)
+    - 역 간 거리 행렬은 C++ DataContainer.distance_matrix로 메모리에 유지됨
+    """
+
+    EARTH_RADIUS = 6371000  # meters
 
     def calculate_distance(
         self, lat1: float, lon1: float, lat2: float, lon2: float
@@ -36,11 +34,6 @@ class DistanceCalculator:
         lat1, lon1 = coord1
         lat2, lon2 = coord2
 
-        # create cache key
-        cache_key = (lat1, lon1, lat2, lon2)
-        if cache_key in self.cache:
-            return self.cache[cache_key]
-
         # radian convertion
         lat1, lon1, lat2, lon2 = map(math.radians, [lat1, lon1, lat2, lon2])
 
@@ -52,19 +45,39 @@ class DistanceCalculator:
             + math.cos(lat1) * math.cos(lat2) * math.sin(dlon / 2) ** 2
         )
         c = 2 * math.asin(math.sqrt(a))
-        distance = self.EARTH_RADIUS * c
+        return self.EARTH_RADIUS * c
 
-        # save cache
-        self.cache[cache_key] = distance
+    def one_to_many(self, lat: float, lon: float, lats, lons) -> np.ndarray:
+        """한 좌표에서 여러 좌표까지의 거리 배열 (len(lats),)"""
+        lats = np.ascontiguousarray(lats, dtype=np.float64)
+        lons = np.ascontiguousarray(lons, dtype=np.float64)
+        if _native is not None:
+            return _native.haversine_one_to_many(lat, lon, lats, lons)
+        return self._haversine_np(lat, lon, lats, lons)
 
-        return distance
+    def many_to_many(self, lats_a, lons_a, lats_b, lons_b) -> np.ndarray:
+        """좌표 집합 A, B 간 거리 행렬 (len(lats_a), len(lats_b))"""
+        lats_a = np.ascontiguousarray(lats_a, dtype=np.float64)
+        lons_a = np.ascontiguousarray(lons_a, dtype=np.float64)
+        lats_b = np.ascontiguousarray(lats_b, dtype=np.float64)
+        lons_b = np.ascontiguousarray(lons_b, dtype=np.float64)
+        if _native is not None:
+            return _native.haversine_many_to_many(lats_a, lons_a, lats_b, lons_b)
+        return self._haversine_np(
+            lats_a[:, np.newaxis], lons_a[:, np.newaxis], lats_b, lons_b
+        )
 
-    def precompute_station_distances(self, stations: List[Dict]):
-        """모든 역 간 거리 사전 계산"""
-        for i, station1 in enumerate(stations):
-            coord1 = (station1["lat"], station1["lng"])
-            for station2 in stations[i + 1 :]:
-                coord2 = (station2["lat"], station2["lng"])
-                self.haversine(coord1, coord2)
+    def precompute_station_distances(self, stations: List[Dict]) -> np.ndarray:
+        """역 목록(lat/lng) 간 거리 행렬 (입력 순서 기준)"""
+        lats = [s["lat"] for s in stations]
+        lons = [s["lng"] for s in stations]
+        return self.many_to_many(lats, lons, lats, lons)
 
-        self.save_cache()
+    def _haversine_np(self, lat1, lon1, lat2, lon2) -> np.ndarray:
+        """NumPy 브로드캐스팅 haversine (pathfinding_cpp 미설치 시)"""
+        lat1, lon1, lat2, lon2 = map(np.radians, (lat1, lon1, lat2, lon2))
+        a = (
+            np.sin((lat2 - lat1) / 2) ** 2
+            + np.cos(lat1) * np.cos(lat2) * np.sin((lon2 - lon1) / 2) ** 2
+        )
+        return 2 * self.EARTH_RADIUS * np.arcsin(np.sqrt(np.minimum(a, 1.0)))
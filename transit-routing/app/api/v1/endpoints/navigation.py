@@ -8,7 +8,7 @@ from functools import lru_cache
 from app.models.requests import NavigationStartRequest
 from app.models.responses import RouteCalculatedResponse
 from app.services.pathfinding_factory import get_pathfinding_service, get_engine_info
-from app.core.exceptions import KindMapException
+from app.core.exceptions import KindMapException, ServiceOverloadedException
 from app.api.deps import get_current_user
 from app.models.domain import User
 from typing import Optional
@@ -75,14 +75,21 @@ async def calculate_route(
 
         start_time = time.time()
 
-        # Run CPU-intensive pathfinding in thread pool to avoid blocking event loop
-        # This allows FastAPI to handle other concurrent requests while pathfinding runs
-        result = await asyncio.to_thread(
-            service.calculate_route,
-            origin_name=request.origin,
-            destination_name=request.destination,
-            disability_type=final_disability_type,
-        )
+        # C++ 엔진: 네이티브 워커 풀에서 탐색 후 await (요청마다 스레드를 점유하지 않음)
+        # 그 외: CPU-intensive pathfinding을 thread pool에서 실행해 event loop 블로킹 방지
+        if getattr(service, "SUPPORTS_ASYNC", False):
+            result = await service.calculate_route_async(
+                origin_name=request.origin,
+                destination_name=request.destination,
+                disability_type=final_disability_type,
+            )
+        else:
+            result = await asyncio.to_thread(
+                service.calculate_route,
+                origin_name=request.origin,
+                destination_name=request.destination,
+                disability_type=final_disability_type,
+            )
 
         elapsed_time = time.time() - start_time
         logger.info(
@@ -100,6 +107,13 @@ async def calculate_route(
 
         return result
 
+    except ServiceOverloadedException as e:
+        logger.warning(f"경로 계산 거절 (과부하): {e.message}")
+        raise HTTPException(
+            status_code=503,
+            detail={"message": e.message, "code": e.code},
+            headers={"Retry-After": "1"},
+        )
     except KindMapException as e:
         logger.error(f"경로 계산 실패: {e.message}")
         raise HTTPException(
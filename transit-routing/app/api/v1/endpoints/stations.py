@@ -23,6 +23,7 @@ async def search_stations(
     
     - **q**: 검색 키워드 (1-50자)
     - **limit**: 최대 결과 수 (1-50, 기본값 10)
+    - 한글 초성 검색 지원 (예: q=ㄱㄴ -> 강남)
     
     Example:
         GET /api/v1/stations/search?q=강남&limit=5
@@ -6,7 +6,7 @@ import asyncio
 import logging
 import uuid
 import time
-from typing import Dict
+from typing import Dict, List, Optional, Tuple
 from fastapi import APIRouter, WebSocket, WebSocketDisconnect, Query, status
 from pydantic import ValidationError
 
@@ -17,8 +17,12 @@ from jose import JWTError
 from app.models.requests import NavigationStartRequest  # rest api에서 쓰던 모델 재사용
 from app.services.auth_service import AuthService  # user 정보 조회
 from app.services.pathfinding_service import PathfindingService
+from app.services.pathfinding_factory import (
+    get_pathfinding_service as get_engine_service,
+)
 from app.services.guidance_service import GuidanceService
 from app.db.redis_client import init_redis
+from app.core.config import settings
 from app.core.exceptions import KindMapException
 from app.tasks.tasks import save_location_history, save_navigation_event
 from app.auth.security import decode_token  # JWT 디코딩 함수 임포트
@@ -47,10 +51,10 @@ def get_redis_client():
 
 
 def get_pathfinding_service():
-    """PathfindingService 인스턴스를 반환 (싱글톤)"""
+    """경로 탐색 서비스 인스턴스를 반환 (싱글톤, USE_CPP_ENGINE에 따라 C++/Python)"""
     global _pathfinding_service
     if _pathfinding_service is None:
-        _pathfinding_service = PathfindingService()
+        _pathfinding_service = get_engine_service()
     return _pathfinding_service
 
 
@@ -368,18 +372,28 @@ async def handle_start_navigation(
     if not final_disability_type:
         final_disability_type = "PHY"  # default -> PHY
 
+    # C++ 엔진: 탐색 라운드마다 발견된 경로를 route_progress로 먼저 전송
+    progress = RouteProgressStreamer(
+        user_id, pathfinding_service, request_model.origin, request_model.destination
+    )
+
     try:
         # ThreadPoolExecutor에서 실행 (이벤트 루프 블로킹 방지)
         # 타임아웃 60초 설정
-        route_data = await asyncio.wait_for(
-            run_in_threadpool(
-                pathfinding_service.calculate_route,
-                origin_name=request_model.origin,
-                destination_name=request_model.destination,
-                disability_type=final_disability_type,
-            ),
-            timeout=60.0,
-        )
+        try:
+            route_data = await asyncio.wait_for(
+                run_in_threadpool(
+                    pathfinding_service.calculate_route,
+                    origin_name=request_model.origin,
+                    destination_name=request_model.destination,
+                    disability_type=final_disability_type,
+                    **progress.kwargs,
+                    **_session_kwargs(pathfinding_service, user_id),
+                ),
+                timeout=60.0,
+            )
+        finally:
+            await progress.finish()
 
         route_id = str(uuid.uuid4())
         route_data["route_id"] = route_id
@@ -431,11 +445,175 @@ async def handle_start_navigation(
         logger.error(f"예상치 못한 오류 (user={user_id}): {e}", exc_info=True)
 
 
+def _session_kwargs(pathfinding_service, user_id: str) -> dict:
+    """세션 단위 재탐색을 지원하는 서비스(C++)에만 session_id 전달"""
+    if getattr(pathfinding_service, "SUPPORTS_SESSION_REROUTE", False):
+        return {"session_id": user_id}
+    return {}
+
+
+def _location_kwargs(pathfinding_service, lat: float, lon: float) -> dict:
+    """현재 위치 주변 역 다중 출발을 지원하는 서비스(C++)에만 origin_location 전달"""
+    if getattr(pathfinding_service, "SUPPORTS_LOCATION_ORIGIN", False):
+        return {"origin_location": (lat, lon)}
+    return {}
+
+
+def _supports_priority(pathfinding_service) -> bool:
+    """우선순위 큐 비동기 탐색 지원 서비스(C++) 여부 (Mock 등 bool이 아닌 속성은 미지원으로 간주)"""
+    return getattr(pathfinding_service, "SUPPORTS_PRIORITY", False) is True
+
+
+class RouteProgressStreamer:
+    """
+    점진적 경로 전송기 (calculate_route의 on_update를 지원하는 서비스만 활성화)
+
+    on_update는 C++ 탐색 스레드에서 호출되므로 call_soon_threadsafe로
+    이벤트 루프의 큐에 넣고, 별도 태스크가 순서대로 route_progress 메시지를 전송합니다.
+    """
+
+    def __init__(self, user_id: str, pathfinding_service, origin: str, destination: str):
+        self.user_id = user_id
+        self.origin = origin
+        self.destination = destination
+        self.enabled = getattr(pathfinding_service, "SUPPORTS_PROGRESSIVE", False)
+        self._queue: asyncio.Queue = asyncio.Queue()
+        self._loop = asyncio.get_running_loop()
+        self._task = asyncio.create_task(self._push()) if self.enabled else None
+
+    @property
+    def kwargs(self) -> dict:
+        """calculate_route에 추가로 전달할 인자"""
+        return {"on_update": self._on_update} if self.enabled else {}
+
+    def _on_update(self, partial: dict):
+        self._loop.call_soon_threadsafe(self._queue.put_nowait, partial)
+
+    async def _push(self):
+        while True:
+            partial = await self._queue.get()
+            if partial is None:  # 종료 신호
+                break
+            await manager.send_message(
+                self.user_id,
+                {
+                    "type": "route_progress",
+                    "origin": self.origin,
+                    "destination": self.destination,
+                    "round": partial["round"],
+                    "routes": partial["routes"],
+                    "total_routes_found": partial["total_routes_found"],
+                },
+            )
+
+    async def finish(self):
+        """대기 중인 중간 결과를 모두 전송한 뒤 전송 태스크 종료"""
+        if self._task is None:
+            return
+        self._queue.put_nowait(None)
+        await self._task
+
+
+# (안내 서비스, user_id, 위도, 경도, 클라이언트 route_id, 결과 future)
+_TickItem = Tuple[GuidanceService, str, float, float, Optional[str], asyncio.Future]
+
+
+def _guide_tick(items: List[_TickItem]) -> list:
+    """
+    틱 배치 1회 (스레드 풀): 세션 MGET 1회 -> route_id 검증 -> 안내 일괄 계산
+
+    Returns:
+        입력 순서대로 (세션, 안내 정보 또는 예외),
+        세션이 없거나 route_id가 다르면 안내는 None
+    """
+    sessions = get_redis_client().get_sessions([item[1] for item in items])
+    results = []
+    pending = []
+    for i, (_, user_id, _, _, route_id, _) in enumerate(items):
+        session = sessions.get(user_id)
+        results.append((session, None))
+        if session and (not route_id or session.get("route_id") == route_id):
+            pending.append(i)
+
+    if pending:
+        guidance = items[0][0].get_navigation_guidance_batch(
+            [(items[i][1], items[i][2], items[i][3]) for i in pending],
+            sessions=sessions,
+        )
+        for i, result in zip(pending, guidance):
+            results[i] = (results[i][0], result)
+    return results
+
+
+class LocationTickBatcher:
+    """
+    위치 업데이트 틱 배치기
+
+    handle_location_update는 업데이트를 큐에 넣고 결과를 기다리며, 배치 태스크가
+    NAV_TICK_MS마다 큐를 비워 세션 일괄 조회(MGET 1회)와
+    get_navigation_guidance_batch 1회로 그 틱의 업데이트를 모두 처리합니다.
+    """
+
+    def __init__(self, tick_ms: float):
+        self.tick_seconds = max(tick_ms, 0.0) / 1000.0
+        self._queue: Optional[asyncio.Queue] = None
+        self._task: Optional[asyncio.Task] = None
+        self._loop = None
+
+    async def submit(
+        self,
+        guidance_service: GuidanceService,
+        user_id: str,
+        lat: float,
+        lon: float,
+        route_id: Optional[str],
+    ) -> tuple:
+        """업데이트를 다음 틱에 넣고 (세션, 안내 정보 또는 예외) 반환"""
+        loop = asyncio.get_running_loop()
+        if self._task is None or self._task.done() or self._loop is not loop:
+            self._loop = loop
+            self._queue = asyncio.Queue()
+            self._task = asyncio.create_task(self._run())
+
+        future = loop.create_future()
+        self._queue.put_nowait((guidance_service, user_id, lat, lon, route_id, future))
+        return await future
+
+    async def _run(self):
+        while True:
+            batch = [await self._queue.get()]
+            await asyncio.sleep(self.tick_seconds)
+            while not self._queue.empty():
+                batch.append(self._queue.get_nowait())
+
+            # 안내 서비스별로 묶어 처리 (운영에서는 싱글톤 1개)
+            groups: Dict[int, List[_TickItem]] = {}
+            for item in batch:
+                groups.setdefault(id(item[0]), []).append(item)
+
+            for items in groups.values():
+                try:
+                    results = await run_in_threadpool(_guide_tick, items)
+                except Exception as e:
+                    logger.error(f"위치 업데이트 배치 실패: count={len(items)}, {e}")
+                    for item in items:
+                        if not item[-1].done():
+                            item[-1].set_exception(e)
+                    continue
+                for item, result in zip(items, results):
+                    # 연결 종료 등으로 취소된 요청은 건너뜀
+                    if not item[-1].done():
+                        item[-1].set_result(result)
+
+
+location_batcher = LocationTickBatcher(settings.NAV_TICK_MS)
+
+
 async def handle_location_update(
     user_id: str, data: dict, guidance_service: GuidanceService
 ):
     """
-    위치 업데이트 및 실시간 경로 안내
+    위치 업데이트 및 실시간 경로 안내 (틱 단위 배치 처리)
 
     - 현재 위치 파악
     - 다음 역까지 거리 계산
@@ -454,8 +632,16 @@ async def handle_location_update(
         )
         return
 
-    # 세션 확인
-    session = get_redis_client().get_session(user_id)
+    # 세션 확인 + 실시간 경로 안내 계산 (같은 틱의 업데이트와 함께 일괄 처리)
+    try:
+        session, guidance = await location_batcher.submit(
+            guidance_service, user_id, lat, lon, route_id_from_client
+        )
+    except Exception as e:
+        await manager.send_error(user_id, "경로 안내 중 오류 발생", "NAVIGATION_ERROR")
+        logger.error(f"경로 안내 오류 (user={user_id}): {e}", exc_info=True)
+        return
+
     if not session:
         await manager.send_error(
             user_id,
@@ -466,7 +652,7 @@ async def handle_location_update(
 
     # route_id 검증 추가
     # client <-> session 경로가 동일한지 확인
-    # 데이터 무결성 유지
+    # 데이터 무결성 유지 (불일치 시 배치에서 안내 계산을 건너뜀)
     if route_id_from_client:
         session_route_id = session.get("route_id")
         if session_route_id != route_id_from_client:
@@ -487,8 +673,8 @@ async def handle_location_update(
     )
 
     try:
-        # 실시간 경로 안내 계산
-        guidance = guidance_service.get_navigation_guidance(user_id, lat, lon)
+        if isinstance(guidance, Exception):
+            raise guidance
 
         # 경로 이탈 감지
         if guidance.get("recalculate"):
@@ -549,6 +735,7 @@ async def handle_location_update(
                 "transfer_to_line": guidance.get("transfer_to_line"),
                 "message": guidance["message"],
                 "progress_percent": guidance.get("progress_percent", 0),
+                "eta_seconds": guidance.get("eta_seconds"),
             },
         )
 
@@ -647,16 +834,34 @@ async def handle_recalculate_route(
 
         logger.info(f"재계산 시작: {current_station_name} → {destination_name}")
 
-        # 새 경로 계산 (ThreadPoolExecutor에서 실행하여 이벤트 루프 블로킹 방지)
-        route_data = await asyncio.wait_for(
-            run_in_threadpool(
-                pathfinding_service.calculate_route,
-                origin_name=current_station_name,
-                destination_name=destination_name,
-                disability_type=disability_type,
-            ),
-            timeout=60.0,
+        # 새 경로 계산 (워커 풀 또는 ThreadPoolExecutor에서 실행하여 이벤트 루프 블로킹 방지)
+        # C++ 엔진: 현재 위치 주변 역들을 도보 접근 시간과 함께 동시에 출발역으로 탐색하고,
+        # 세션에 보관된 직전 탐색 트리에서 현재 역 이후 경로를 복구하여
+        # route_progress(round 0)로 즉시 전송한 뒤 개선된 경로를 이어서 전송
+        # 안내 중 사용자 재탐색은 우선순위 high로 네이티브 워커 풀에서 경로 조회보다 먼저 실행
+        progress = RouteProgressStreamer(
+            user_id, pathfinding_service, current_station_name, destination_name
         )
+        route_kwargs = dict(
+            origin_name=current_station_name,
+            destination_name=destination_name,
+            disability_type=disability_type,
+            **progress.kwargs,
+            **_session_kwargs(pathfinding_service, user_id),
+            **_location_kwargs(pathfinding_service, lat, lon),
+        )
+        try:
+            if _supports_priority(pathfinding_service):
+                calculation = pathfinding_service.calculate_route_async(
+                    priority="high", **route_kwargs
+                )
+            else:
+                calculation = run_in_threadpool(
+                    pathfinding_service.calculate_route, **route_kwargs
+                )
+            route_data = await asyncio.wait_for(calculation, timeout=60.0)
+        finally:
+            await progress.finish()
 
         route_id = str(uuid.uuid4())
         route_data["route_id"] = route_id
@@ -700,6 +905,13 @@ async def handle_end_navigation(user_id: str):
     """
     세션 삭제 및 종료 이벤트 기록
     """
+    # 재탐색용으로 보관한 탐색 트리 해제
+    pathfinding_service = get_pathfinding_service()
+    if getattr(pathfinding_service, "SUPPORTS_SESSION_REROUTE", False):
+        pathfinding_service.release_session(user_id)
+    # 네이티브 안내 추적 세션 해제
+    get_guidance_service().end_tracking(user_id)
+
     session = get_redis_client().get_session(user_id)
 
     if session:
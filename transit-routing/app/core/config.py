@@ -34,11 +34,18 @@ class Settings:
         os.getenv("SESSION_TTL_SECONDS", 1800)
     )  # 30 m => 모니터링하면서 수정 필
 
+    # 위치 업데이트 틱 배치 간격(ms): 틱마다 세션 일괄 조회 + 안내 일괄 계산
+    NAV_TICK_MS: float = float(os.getenv("NAV_TICK_MS", "50"))
+
     # 경로 캐시 TTL (시연용 서버: 14일)
     ROUTE_CACHE_TTL_SECONDS: int = int(
         os.getenv("ROUTE_CACHE_TTL_SECONDS", 1209600)
     )  # 14일 (1209600초)
 
+    # 경로 캐시 저장 형식 (C++ 엔진): "binary"(역 ID varint + 양자화 기준 값) 또는 "json"
+    # binary는 역 데이터가 바뀌면(네트워크 지문 불일치) 캐시 미스로 처리
+    ROUTE_CACHE_FORMAT: str = os.getenv("ROUTE_CACHE_FORMAT", "binary").lower()
+
     # 캐시 메트릭 활성화 플래그
     ENABLE_CACHE_METRICS: bool = (
         os.getenv("ENABLE_CACHE_METRICS", "true").lower() == "true"
@@ -48,6 +55,66 @@ class Settings:
     # 환경변수를 읽어오도록 설정
     USE_CPP_ENGINE: bool = os.getenv("USE_CPP_ENGINE", "false").lower() == "true"
 
+    # C++ 엔진 탐색 라운드 수 (경로 미발견 시 이전 탐색을 이어서 ESCALATED까지 확장)
+    CPP_MAX_ROUNDS: int = int(os.getenv("CPP_MAX_ROUNDS", "5"))
+    CPP_MAX_ROUNDS_ESCALATED: int = int(os.getenv("CPP_MAX_ROUNDS_ESCALATED", "8"))
+    # 경로 이탈 재탐색용으로 보관할 세션별 탐색 트리 수 (0이면 비활성화)
+    CPP_REROUTE_SESSIONS: int = int(os.getenv("CPP_REROUTE_SESSIONS", "256"))
+    # 재탐색 목표 가지치기: 복구 경로를 상한으로 라벨 감소 (평균 편의도/혼잡도 기준 순위는 근사, 기본 비활성화)
+    CPP_REROUTE_TARGET_PRUNING: bool = (
+        os.getenv("CPP_REROUTE_TARGET_PRUNING", "false").lower() == "true"
+    )
+    # 네이티브 안내 추적(NavigationTracker)에 등록해 둘 최대 세션 수 (초과 시 오래된 세션부터 해제)
+    CPP_NAV_SESSIONS: int = int(os.getenv("CPP_NAV_SESSIONS", "50000"))
+    # 위치 기반 출발: 현재 위치 반경 내 역들을 도보 접근 출발역으로 동시 탐색 (가까운 순 최대 개수)
+    CPP_ACCESS_RADIUS_M: float = float(os.getenv("CPP_ACCESS_RADIUS_M", "600"))
+    CPP_ACCESS_MAX_ORIGINS: int = int(os.getenv("CPP_ACCESS_MAX_ORIGINS", "6"))
+    # 이름이 다른 인접 역 간 도보 연결: 장애 유형별 보행 속도로 이 시간(분) 이내인 역 쌍 (0이면 비활성화)
+    CPP_FOOTPATH_MAX_MINUTES: float = float(os.getenv("CPP_FOOTPATH_MAX_MINUTES", "6"))
+    # 비동기 경로 탐색(calculate_route_async) 네이티브 워커 수 (0이면 CPU 코어 수)
+    CPP_QUERY_THREADS: int = int(os.getenv("CPP_QUERY_THREADS", "0"))
+    # 워커 풀 과부하 제어: 대기열 상한(전체 우선순위 합), 대기 시간 예산(ms) 초과 요청은 즉시 거절(503) (0이면 제한 없음)
+    CPP_QUERY_MAX_QUEUE: int = int(os.getenv("CPP_QUERY_MAX_QUEUE", "256"))
+    CPP_QUERY_MAX_WAIT_MS: float = float(os.getenv("CPP_QUERY_MAX_WAIT_MS", "2000"))
+    # 부하 적응 탐색 강도 정책 (JSON 목록, 낮은 단계부터, 비우면 항상 전체 탐색)
+    # 작업 시작 시 대기열/워커 >= queue_per_worker 또는 최근 p99 대기 >= wait_p99_ms 인 가장 높은 단계 적용
+    CPP_EFFORT_POLICY: str = os.getenv(
+        "CPP_EFFORT_POLICY",
+        '[{"queue_per_worker": 1, "wait_p99_ms": 250, "epsilon": 0.02, "max_bag_size": 32},'
+        ' {"queue_per_worker": 4, "wait_p99_ms": 1000, "epsilon": 0.05, "max_bag_size": 12, "max_rounds": 4}]',
+    )
+    # 프로세스 내 경로 결과 캐시 항목 수 (Redis 조회 전에 확인, 0이면 비활성화)
+    CPP_RESULT_CACHE_SIZE: int = int(os.getenv("CPP_RESULT_CACHE_SIZE", "4096"))
+    # 결과 캐시 파일 (재시작 후 같은 네트워크/데이터면 복원, 비어 있으면 비활성화)
+    # 주기(초)마다 변경이 있을 때 저장하고 종료 시 마지막으로 저장
+    CPP_RESULT_CACHE_PATH: str = os.getenv("CPP_RESULT_CACHE_PATH", "")
+    CPP_RESULT_CACHE_CHECKPOINT_SECONDS: float = float(
+        os.getenv("CPP_RESULT_CACHE_CHECKPOINT_SECONDS", "300")
+    )
+    # 시작 시 캐시 예열: 조회 통계(stats:od_pair) 상위 N개 출발-도착 쌍 x 장애 유형 (0이면 비활성화)
+    # 워커 풀에서 낮은 우선순위로 계산하며, 역 데이터/점수 갱신 시 다시 예열
+    CPP_WARMUP_PAIRS: int = int(os.getenv("CPP_WARMUP_PAIRS", "200"))
+    CPP_WARMUP_PROFILES: str = os.getenv("CPP_WARMUP_PROFILES", "PHY,VIS,AUD,ELD")
+    # 예열 대상 갱신 주기(초): 질의 빈도 집계 상위 항목 + 조회 통계로 대상 교체 (0이면 시작 시 1회만)
+    CPP_WARMUP_REFRESH_SECONDS: float = float(
+        os.getenv("CPP_WARMUP_REFRESH_SECONDS", "300")
+    )
+    # 질의 빈도 집계 (출발, 도착, 장애 유형, 30분 슬롯): 최근 창(초) 기준 상위 K개 유지
+    CPP_QUERY_SKETCH_TOP_K: int = int(os.getenv("CPP_QUERY_SKETCH_TOP_K", "64"))
+    CPP_QUERY_SKETCH_WINDOW_SECONDS: float = float(
+        os.getenv("CPP_QUERY_SKETCH_WINDOW_SECONDS", "3600")
+    )
+    # 동기 경로 계산(calculate_route) 1건의 라운드 내 병렬 스캔 스레드 수 (1이면 비활성화, 대형 프런티어에서만 동작)
+    # 보조 스레드(값 - 1개)는 프로세스 공용으로 모든 동기 요청이 나눠 씀
+    # 비동기 경로(calculate_route_async)는 CPP_QUERY_THREADS 워커가 이미 코어를 쓰므로 항상 순차 스캔
+    # => 최대 네이티브 탐색 스레드: CPP_QUERY_THREADS + (CPP_INTRA_QUERY_THREADS - 1) + 동기 요청 스레드
+    CPP_INTRA_QUERY_THREADS: int = int(os.getenv("CPP_INTRA_QUERY_THREADS", "1"))
+
+    # C++ 엔진 오프라인 재생용 (tools/replay_driver)
+    # 비어 있으면 비활성화
+    CPP_SNAPSHOT_PATH: str = os.getenv("CPP_SNAPSHOT_PATH", "")  # 네트워크 스냅샷 저장 경로
+    CPP_QUERY_LOG_PATH: str = os.getenv("CPP_QUERY_LOG_PATH", "")  # 쿼리 로그(CSV) 기록 경로
+
     # 성능 모니터링 설정
     ENABLE_PERFORMANCE_MONITORING: bool = (
         os.getenv("ENABLE_PERFORMANCE_MONITORING", "true").lower() == "true"
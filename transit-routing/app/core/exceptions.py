@@ -23,6 +23,11 @@ class SessionNotFoundException(KindMapException):
         super().__init__(message, code="SESSION_NOT_FOUND")
 
 
+class ServiceOverloadedException(KindMapException):
+    def __init__(self, message: str = "요청이 많아 잠시 후 다시 시도해주세요"):
+        super().__init__(message, code="SERVICE_OVERLOADED")
+
+
 class InvalidLocationException(KindMapException):
     def __init__(self, message: str = "유효하지 않은 위치입니다"):
         super().__init__(message, code="INVALID_LOCATION")
@@ -28,6 +28,12 @@ _facility_cache: Dict[str, Dict] = {}  # {station_name: facility_info}
 _congestion_cache: Dict[Tuple[str, str, str, str], Dict[str, float]] = {}
 # {(station_cd, line, direction, day_type): {time_slot: congestion_value}}
 
+# 역 이름 자동완성 인덱스 (pathfinding_cpp.StationNameIndex, 미설치 시 None => Python 검색)
+_station_name_index = None
+
+# 한글 초성 (호환 자모, 음절 초성 순서)
+_CHOSUNG = "ㄱㄲㄴㄷㄸㄹㅁㅂㅃㅅㅆㅇㅈㅉㅊㅋㅌㅍㅎ"
+
 
 def initialize_cache():
     """
@@ -38,7 +44,7 @@ def initialize_cache():
 
     global _cache_init
     global _stations_cache, _stations_list_cache, _station_name_map_cache
-    global _lines_cache, _transfer_conv_cache
+    global _lines_cache, _transfer_conv_cache, _station_name_index
 
     with _cache_lock:
         if _cache_init:
@@ -76,6 +82,8 @@ def initialize_cache():
                 _lines_cache[line].append(station_cd)
 
         logger.info(f"✓ 역 데이터 로드 완료: {len(_stations_cache)}개")
+
+        _station_name_index = _build_station_name_index(_stations_list_cache)
         logger.info(f"✓ 호선 데이터 로드 완료: {len(_lines_cache)}개 노선")
 
         # 2. 구간 정보 로드
@@ -191,28 +199,99 @@ def get_station_cd_by_name(station_name: str) -> Optional[str]:
 
 
 def search_stations_by_name(keyword: str, limit: int = 10) -> List[Dict]:
+    """
+    역 이름 자동완성 검색
+
+    - 정규화 이름(괄호 이후, 끝의 "역" 제거)과 원래 이름 중 좋은 순위로 비교 (괄호 안 별칭 "이수"도 일치)
+    - 정규화로 비는 질의(한 글자 "역" 등)는 원래 질의로 검색
+    - 한글 초성 검색 지원 (예: "ㄱㄴ" -> 강남, "강ㄴ" -> 강남)
+    - 순위: 정확 일치 > 접두 일치 > 부분 일치 > 초성 접두 > 초성 부분, 같은 순위는 이름 길이, 이름, 역 코드 순
+    - pathfinding_cpp.StationNameIndex가 있으면 C++ 인덱스, 없으면 같은 규칙의 Python 검색
+    """
     if not _cache_init:
         initialize_cache()
 
-    keyword = keyword.strip().lower()
-    results = []
+    keyword = keyword.strip()
+    if _station_name_index is not None:
+        codes = _station_name_index.search(keyword, limit)
+        return [{**_stations_cache[cd]} for cd in codes if cd in _stations_cache]
+
+    return _search_stations_py(keyword, limit)
+
+
+def _build_station_name_index(stations: List[Dict]):
+    try:
+        import pathfinding_cpp
+    except ImportError:
+        return None
+    if not hasattr(pathfinding_cpp, "StationNameIndex"):
+        return None
+
+    index = pathfinding_cpp.StationNameIndex(
+        [s["station_cd"] for s in stations], [s["name"] for s in stations]
+    )
+    logger.info(f"✓ 역 이름 검색 인덱스 구축 완료: {index.key_count}개 이름")
+    return index
 
+
+def _normalize_station_name(name: str) -> str:
+    """C++ PathfindingUtils::normalize_station_name과 동일 (괄호 이후, 끝의 "역", 앞뒤 공백 제거)"""
+    name = name.split("(", 1)[0]
+    if name.endswith("역"):
+        name = name[:-1]
+    return name.strip()
+
+
+def _chosung(ch: str) -> str:
+    """한글 음절이면 초성 자모, 아니면 그대로"""
+    if "가" <= ch <= "힣":
+        return _CHOSUNG[(ord(ch) - ord("가")) // 588]
+    return ch
+
+
+def _chosung_find(keyword: str, name: str) -> int:
+    """초성 포함 일치 위치 (질의의 자모 자음은 같은 초성의 음절과 일치), 없으면 -1"""
+    for start in range(len(name) - len(keyword) + 1):
+        if all(
+            q == c or q == _chosung(c)
+            for q, c in zip(keyword, name[start : start + len(keyword)])
+        ):
+            return start
+    return -1
+
+
+def _search_stations_py(keyword: str, limit: int) -> List[Dict]:
+    """StationNameIndex와 같은 순위 규칙의 Python 검색 (pathfinding_cpp 미설치 시)"""
+    # 정규화로 비는 질의 ("역", "(이수)")는 원래 질의로 검색
+    query = (_normalize_station_name(keyword) or keyword.strip()).lower()
+    if not query or limit <= 0:
+        return []
+    has_jamo = any(ch in _CHOSUNG for ch in query)
+
+    results = []
     for station in _stations_list_cache:
-        name_lower = station["name"].lower()
-        if keyword in name_lower:
-            if name_lower == keyword:
-                priority = 1
-            elif name_lower.startswith(keyword):
-                priority = 2
-            else:
+        # 정규화 이름과 원래 이름 중 순위가 좋은 쪽 (괄호 안 별칭, "역"으로 시작하는 이름 일치)
+        name_key = _normalize_station_name(station["name"]) or station["name"]
+        best = None
+        for name in dict.fromkeys((name_key, station["name"])):
+            key = name.lower()
+            pos = key.find(query)
+            if pos == 0:
+                priority = 1 if key == query else 2
+            elif pos > 0:
                 priority = 3
-            results.append({**station, "_priority": priority})
-
-    results.sort(key=lambda x: (x["_priority"], len(x["name"]), x["name"]))
-    for r in results:
-        r.pop("_priority", None)
+            elif has_jamo and (pos := _chosung_find(query, key)) >= 0:
+                priority = 4 if pos == 0 else 5
+            else:
+                continue
+            rank = (priority, len(key), name, station["station_cd"])
+            if best is None or rank < best:
+                best = rank
+        if best is not None:
+            results.append((*best, station))
 
-    return results[:limit]
+    results.sort(key=lambda x: x[:4])
+    return [{**r[4]} for r in results[:limit]]
 
 
 def get_transfer_conv_by_code(station_cd: str) -> Optional[Dict]:
@@ -243,6 +322,7 @@ def clear_cache():
     global _stations_cache, _stations_list_cache, _station_name_map_cache
     global _sections_cache, _transfer_conv_cache
     global _lines_cache, _facility_cache, _congestion_cache
+    global _station_name_index
 
     with _cache_lock:
         _stations_cache.clear()
@@ -253,6 +333,7 @@ def clear_cache():
         _lines_cache.clear()
         _facility_cache.clear()
         _congestion_cache.clear()
+        _station_name_index = None
 
         _cache_init = False
         logger.info("캐시 초기화됨")
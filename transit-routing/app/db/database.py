@@ -28,7 +28,7 @@ _distance_calculator = None
 def get_distance_calculator() -> DistanceCalculator:
     global _distance_calculator
     if _distance_calculator is None:
-        _distance_calculator = DistanceCalculator(cache_file="distance_cache.pkl")
+        _distance_calculator = DistanceCalculator()
     return _distance_calculator
 
 
@@ -1,6 +1,6 @@
 import redis
 import json
-from typing import Optional, Dict, Any, Tuple, List
+from typing import Optional, Dict, Any, Tuple, List, Callable
 from datetime import datetime
 import logging
 
@@ -8,6 +8,10 @@ from app.core.config import settings
 
 logger = logging.getLogger(__name__)
 
+# C++ 경로 캐시 바이너리 페이로드 머리 (pathfinding_cpp.ROUTE_PAYLOAD_MAGIC과 동일)
+# 첫 바이트가 NUL이므로 JSON 페이로드와 겹치지 않음
+ROUTE_PAYLOAD_MAGIC = b"\x00RSB"
+
 
 class RedisSessionManager:
     def __init__(self):
@@ -24,6 +28,18 @@ class RedisSessionManager:
             retry_on_timeout=True,
         )
         self.redis_client = redis.Redis(connection_pool=self.pool)
+        # 경로 캐시 조회용 (바이너리 페이로드는 UTF-8 디코딩 불가 -> decode_responses=False)
+        self.binary_pool = redis.ConnectionPool(
+            host=settings.REDIS_HOST,
+            port=settings.REDIS_PORT,
+            db=0,
+            max_connections=settings.REDIS_MAX_CONNECTIONS,
+            decode_responses=False,
+            socket_keepalive=True,
+            socket_connect_timeout=5,
+            retry_on_timeout=True,
+        )
+        self.binary_client = redis.Redis(connection_pool=self.binary_pool)
 
     def create_session(self, user_id: str, route_data: dict) -> bool:
         """session 생성 <- 에러 처리 추가"""
@@ -122,31 +138,7 @@ class RedisSessionManager:
     def get_session(self, user_id: str) -> Optional[Dict]:
         """session 조회 및 역직렬화"""
         try:
-            session_key = f"session:{user_id}"
-            data = self.redis_client.get(session_key)
-
-            if not data:
-                return None
-
-            session = json.loads(data)
-
-            # JSON 필드 역직렬화 <- 안전을 위해 .get 사용
-            json_fields = [
-                "route_sequence",
-                "route_lines",
-                "transfer_stations",
-                "transfer_info",
-                "all_routes",
-            ]
-
-            for field in json_fields:
-                if field in session and isinstance(session[field], str):
-                    try:
-                        session[field] = json.loads(session[field])
-                    except json.JSONDecodeError:
-                        session[field] = []  # parsing 실패 => 빈 리스트
-
-            return session
+            return self._decode_session(self.redis_client.get(f"session:{user_id}"))
 
         except redis.RedisError as e:
             logger.error(f"세션 조회 실패: user_id={user_id}, 오류:{e}")
@@ -155,6 +147,57 @@ class RedisSessionManager:
             logger.error(f"세션 데이터 파싱 실패: user_id={user_id}, 오류: {e}")
             return None
 
+    def get_sessions(self, user_ids: List[str]) -> Dict[str, Optional[Dict]]:
+        """
+        여러 session 일괄 조회 (MGET 1회, 위치 업데이트 틱 배치용)
+
+        Returns:
+            user_id -> 세션 (없거나 파싱 실패 시 None), 조회 실패 시 전부 None
+        """
+        unique_ids = list(dict.fromkeys(user_ids))
+        sessions: Dict[str, Optional[Dict]] = dict.fromkeys(unique_ids)
+        if not unique_ids:
+            return sessions
+
+        try:
+            values = self.redis_client.mget([f"session:{uid}" for uid in unique_ids])
+        except redis.RedisError as e:
+            logger.error(f"세션 일괄 조회 실패: count={len(unique_ids)}, 오류:{e}")
+            return sessions
+
+        for user_id, data in zip(unique_ids, values):
+            try:
+                sessions[user_id] = self._decode_session(data)
+            except json.JSONDecodeError as e:
+                logger.error(f"세션 데이터 파싱 실패: user_id={user_id}, 오류: {e}")
+        return sessions
+
+    @staticmethod
+    def _decode_session(data) -> Optional[Dict]:
+        """저장된 session JSON 역직렬화 (없으면 None)"""
+        if not data:
+            return None
+
+        session = json.loads(data)
+
+        # JSON 필드 역직렬화 <- 안전을 위해 .get 사용
+        json_fields = [
+            "route_sequence",
+            "route_lines",
+            "transfer_stations",
+            "transfer_info",
+            "all_routes",
+        ]
+
+        for field in json_fields:
+            if field in session and isinstance(session[field], str):
+                try:
+                    session[field] = json.loads(session[field])
+                except json.JSONDecodeError:
+                    session[field] = []  # parsing 실패 => 빈 리스트
+
+        return session
+
     def update_location(self, user_id: str, current_station: str):
         """현재 위치 업데이트 (TTL 갱신 포함)"""
         try:
@@ -183,32 +226,63 @@ class RedisSessionManager:
 
     # cashing and analystics
     # 경로 캐싱을 위한 메서드 추가
-    def get_cached_route(self, cache_key: str) -> Optional[Dict[str, Any]]:
+    def get_cached_route(
+        self,
+        cache_key: str,
+        decode_binary: Optional[Callable[[bytes], Dict[str, Any]]] = None,
+    ) -> Optional[Dict[str, Any]]:
         """
         캐시된 경로 조회 => 캐시 hit/miss 로그로 기록
+
+        Args:
+            decode_binary: C++ 바이너리 페이로드(ROUTE_PAYLOAD_MAGIC) 디코더.
+                없거나 디코딩에 실패하면(역 데이터 변경 등) 캐시 미스로 처리
         """
         try:
-            cached_data = self.redis_client.get(cache_key)
-            if cached_data:
-                logger.debug(f"캐시 HIT:{cache_key}")
-                return json.loads(cached_data)
-            logger.debug(f"캐시 MISS: {cache_key}")
-            return None
+            cached_data = self.binary_client.get(cache_key)
+            if not cached_data:
+                logger.debug(f"캐시 MISS: {cache_key}")
+                return None
+            if cached_data.startswith(ROUTE_PAYLOAD_MAGIC):
+                if decode_binary is None:
+                    logger.debug(f"캐시 MISS (바이너리 디코더 없음): {cache_key}")
+                    return None
+                try:
+                    result = decode_binary(cached_data)
+                except (RuntimeError, ValueError) as e:
+                    logger.warning(f"캐시 페이로드 디코딩 실패 (재계산): {cache_key}, {e}")
+                    return None
+                logger.debug(f"캐시 HIT (binary):{cache_key}")
+                return result
+            logger.debug(f"캐시 HIT:{cache_key}")
+            return json.loads(cached_data)
         except redis.RedisError as e:
             logger.warning(f"Redis 캐시 조회 실패 (fallback: 재계산): {e}")
             return None
-        except json.JSONDecodeError as e:
+        except (json.JSONDecodeError, UnicodeDecodeError) as e:
             logger.error(f"캐시 데이터 파싱 실패: {cache_key}, 오류: {e}")
             return None
 
     def cache_route(
-        self, cache_key: str, route_data: Dict[str, Any], ttl: int = 1209600
+        self,
+        cache_key: str,
+        route_data: Dict[str, Any],
+        ttl: int = 1209600,
+        payload: Optional[bytes] = None,
     ) -> bool:
         """
         경로 계산 결과 redis에 캐싱
+
+        Args:
+            payload: 미리 직렬화된 값 (C++ RouteSet.encode / to_json 결과).
+                없으면 route_data를 JSON으로 직렬화, 통계 집계는 항상 route_data 사용
         """
         try:
-            serialized_data = json.dumps(route_data, ensure_ascii=False)
+            serialized_data = (
+                payload
+                if payload is not None
+                else json.dumps(route_data, ensure_ascii=False)
+            )
             self.redis_client.setex(cache_key, ttl, serialized_data)
 
             try:
@@ -29,7 +29,11 @@ from app.middleware.performance_monitoring import (
 )
 
 # 경로 탐색 서비스
-from app.services.pathfinding_factory import get_engine_info
+from app.services.pathfinding_factory import (
+    close_pathfinding_service,
+    get_engine_info,
+    get_pathfinding_service,
+)
 
 # 로깅 설정
 logging.basicConfig(
@@ -53,6 +57,7 @@ async def lifespan(app: FastAPI):
     - Websocket 메시지 핸들러 등록 및 리스너 시
 
     서버 종료 시 실행:
+    - 경로 탐색 서비스 정리 (결과 캐시 파일 저장)
     - Redis Pub/Sub 종료
     - PostgreSQL 연결 풀 종
     """
@@ -101,13 +106,17 @@ async def lifespan(app: FastAPI):
     logger.info("=" * 60)
 
     try:
-        # 1. Redis Pub/Sub 종료
-        logger.info("1/2 Redis Pub/Sub 종료 중...")
+        # 1. 경로 탐색 서비스 정리 (캐시 예열 중단, 결과 캐시 파일 저장)
+        logger.info("1/3 경로 탐색 서비스 정리 중...")
+        close_pathfinding_service()
+
+        # 2. Redis Pub/Sub 종료
+        logger.info("2/3 Redis Pub/Sub 종료 중...")
         pubsub_manager = get_pubsub_manager()
         await pubsub_manager.close()
 
-        # 2. PostgreSQL 연결 풀 종료
-        logger.info("2/2 PostgreSQL 연결 풀 종료 중...")
+        # 3. PostgreSQL 연결 풀 종료
+        logger.info("3/3 PostgreSQL 연결 풀 종료 중...")
         close_pool()
 
         logger.info("=" * 60)
@@ -341,7 +350,7 @@ async def get_metrics():
     try:
         metrics = get_metrics_collector()
 
-        return {
+        response = {
             "summary": metrics.get_summary(),
             "top_paths": metrics.get_path_stats(top_n=10),
             "configuration": {
@@ -350,6 +359,16 @@ async def get_metrics():
             },
         }
 
+        # C++ 엔진 워커 풀 대기열/대기 시간
+        service = get_pathfinding_service()
+        if hasattr(service, "query_pool_stats"):
+            response["route_queue"] = service.query_pool_stats()
+        # C++ 엔진 최근 상위 빈도 질의 (출발-도착-장애 유형-시간대)
+        if hasattr(service, "query_mix_stats"):
+            response["query_mix"] = service.query_mix_stats()
+
+        return response
+
     except Exception as e:
         logger.error(f"메트릭 조회 실패: {e}", exc_info=True)
         raise HTTPException(status_code=500, detail=f"메트릭 조회 실패: {str(e)}")
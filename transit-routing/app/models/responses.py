@@ -14,6 +14,9 @@ class RouteCalculatedResponse(BaseModel):
     origin: str = Field(..., description="출발지")
     destination: str = Field(..., description="목적지")
     routes: List[Dict] = Field(..., description="경로 리스트 (최대 3개)")
+    effort_level: int = Field(
+        0, description="탐색 강도 단계 (0 = 전체 탐색, 부하가 높을 때 C++ 엔진이 낮춤)"
+    )
 
 
 # 개별 경로 정보 응답
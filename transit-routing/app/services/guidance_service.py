@@ -1,5 +1,7 @@
 import logging
-from typing import Optional, Dict, Any
+import threading
+from collections import OrderedDict
+from typing import Optional, Dict, Any, List, Sequence, Tuple, Union
 
 # NNS => KD-TREE 사용하기
 from scipy.spatial import KDTree
@@ -8,7 +10,12 @@ import numpy as np
 from app.db.redis_client import RedisSessionManager
 from app.algorithms.distance_calculator import DistanceCalculator
 from app.db.cache import get_stations_dict, get_station_name_by_code
-from app.core.exceptions import SessionNotFoundException, InvalidLocationException
+from app.core.exceptions import (
+    KindMapException,
+    SessionNotFoundException,
+    InvalidLocationException,
+)
+from app.core.config import settings
 
 logger = logging.getLogger(__name__)
 
@@ -36,7 +43,37 @@ class GuidanceService:
 
         self.kdtree = KDTree(np.array(station_coords))
 
-        logger.info("GuidanceService 초기화 완료")
+        # C++ 엔진 사용 시 엔진의 네이티브 공간 인덱스/안내 추적기 공유 (없으면 KD-Tree + Python 매칭)
+        self.spatial_index = None
+        self.data_container = None
+        self.tracker = None
+        # user_id -> (추적기 세션 핸들, route_id), 오래된 순 (LRU)
+        self._tracked: "OrderedDict[str, Tuple[int, str]]" = OrderedDict()
+        self._tracked_lock = threading.Lock()
+        self._load_native()
+
+        logger.info(
+            f"GuidanceService 초기화 완료 "
+            f"(최근접 역 조회: {'C++ SpatialIndex' if self.spatial_index is not None else 'KD-Tree'}, "
+            f"경로 매칭: {'C++ NavigationTracker' if self.tracker is not None else 'Python'})"
+        )
+
+    def _load_native(self) -> None:
+        """PathfindingServiceCPP의 SpatialIndex/DataContainer 공유 및 NavigationTracker 생성"""
+        if not settings.USE_CPP_ENGINE:
+            return
+
+        from app.services.pathfinding_factory import get_pathfinding_service
+
+        service = get_pathfinding_service()
+        if getattr(service, "spatial_index", None) is None:
+            return
+
+        self.spatial_index = service.spatial_index
+        self.data_container = service.data_container
+        self.tracker = service.cpp_module.NavigationTracker(
+            self.data_container, float(self.ROUTE_DEVIATION_THRESHOLD)
+        )
 
     def get_navigation_guidance(
         self, user_id: str, lat: float, lon: float
@@ -64,62 +101,193 @@ class GuidanceService:
             SessionNotFoundException: 세션이 없을 때
             InvalidLocationException: 유효하지 않은 위치일 때
         """
-        # 입력 검증
-        if not self._is_valid_location(lat, lon):
-            raise InvalidLocationException(f"유효하지 않은 GPS 좌표: {lat}, {lon}")
+        result = self.get_navigation_guidance_batch([(user_id, lat, lon)])[0]
+        if isinstance(result, Exception):
+            raise result
+        return result
+
+    def get_navigation_guidance_batch(
+        self,
+        updates: Sequence[Tuple[str, float, float]],
+        sessions: Optional[Dict[str, Optional[Dict[str, Any]]]] = None,
+    ) -> List[Union[Dict[str, Any], KindMapException]]:
+        """
+        위치 업데이트 일괄 처리 (틱 단위 배치용)
+
+        NavigationTracker 사용 가능 시 전체 배치의 경로 매칭/다음 역 거리/ETA를
+        한 번의 C++ 호출로 계산하고, 불가능하면 업데이트별 Python 매칭으로 처리
+
+        Args:
+            updates: (user_id, 위도, 경도) 목록
+            sessions: 이미 조회한 user_id -> 세션 (생략 시 Redis MGET 1회로 일괄 조회)
+
+        Returns:
+            입력 순서대로 안내 정보 딕셔너리 또는 실패 시 예외 객체
+            (SessionNotFoundException / InvalidLocationException)
+        """
+        results: List[Any] = [None] * len(updates)
+        native: List[Tuple[int, int, Dict[str, Any]]] = []  # (입력 인덱스, 핸들, 세션)
 
-        # 세션 확인
-        session = self.redis_client.get_session(user_id)
-        if not session:
-            raise SessionNotFoundException("활성 세션이 없습니다")
+        if sessions is None:
+            sessions = self.redis_client.get_sessions(
+                [user_id for user_id, lat, lon in updates if self._is_valid_location(lat, lon)]
+            )
 
+        for i, (user_id, lat, lon) in enumerate(updates):
+            # 입력 검증
+            if not self._is_valid_location(lat, lon):
+                results[i] = InvalidLocationException(
+                    f"유효하지 않은 GPS 좌표: {lat}, {lon}"
+                )
+                continue
+
+            # 세션 확인
+            session = sessions.get(user_id)
+            if not session:
+                results[i] = SessionNotFoundException("활성 세션이 없습니다")
+                continue
+
+            handle = self._tracked_handle(user_id, session)
+            if handle is not None:
+                native.append((i, handle, session))
+                continue
+            try:
+                results[i] = self._guide_with_python(user_id, session, lat, lon)
+            except KindMapException as e:
+                results[i] = e
+
+        if native:
+            idx = [i for i, _, _ in native]
+            matched = self.tracker.update(
+                np.array([h for _, h, _ in native], dtype=np.int32),
+                np.array([updates[i][1] for i in idx], dtype=np.float64),
+                np.array([updates[i][2] for i in idx], dtype=np.float64),
+            )
+            # 조회 이후 end_tracking/LRU 해제로 종료되었거나 다른 세션이 재사용한 핸들은
+            # 엉뚱한 경로 결과(UNKNOWN이면 progress_index=-1)이므로 Python 매칭으로 처리
+            with self._tracked_lock:
+                current = [
+                    self._tracked.get(updates[i][0]) == (handle, session.get("route_id"))
+                    for i, handle, session in native
+                ]
+            for row, (i, _, session) in enumerate(native):
+                user_id, lat, lon = updates[i]
+                try:
+                    if matched["flags"][row] & self.tracker.UNKNOWN or not current[row]:
+                        results[i] = self._guide_with_python(user_id, session, lat, lon)
+                    else:
+                        results[i] = self._guide_with_native(
+                            user_id, session, lat, lon, matched, row
+                        )
+                except KindMapException as e:
+                    results[i] = e
+
+        return results
+
+    def end_tracking(self, user_id: str) -> None:
+        """안내 종료 시 NavigationTracker 세션 해제"""
+        with self._tracked_lock:
+            entry = self._tracked.pop(user_id, None)
+        if entry is not None:
+            self.tracker.end(entry[0])
+
+    def _tracked_handle(self, user_id: str, session: Dict[str, Any]) -> Optional[int]:
+        """
+        세션의 NavigationTracker 핸들 반환 (route_id가 바뀌면 재등록)
+
+        Returns:
+            핸들, 추적기 미사용이거나 경로 등록 실패 시 None (Python 매칭으로 처리)
+        """
+        if self.tracker is None:
+            return None
+
+        route_id = session.get("route_id")
+        with self._tracked_lock:
+            entry = self._tracked.get(user_id)
+            if entry is not None and entry[1] == route_id:
+                self._tracked.move_to_end(user_id)
+                return entry[0]
+
+        try:
+            handle = self.tracker.start(list(session["route_sequence"]))
+        except RuntimeError as e:
+            # 엔진 데이터에 없는 역 코드 등 -> Python 매칭으로 처리
+            logger.warning(f"경로 추적 등록 실패: user={user_id}, {e}")
+            return None
+
+        with self._tracked_lock:
+            stale = [self._tracked.pop(user_id)] if user_id in self._tracked else []
+            self._tracked[user_id] = (handle, route_id)
+            while len(self._tracked) > max(settings.CPP_NAV_SESSIONS, 1):
+                stale.append(self._tracked.popitem(last=False)[1])
+        for old_handle, _ in stale:
+            self.tracker.end(old_handle)
+        return handle
+
+    def _guide_with_native(
+        self,
+        user_id: str,
+        session: Dict[str, Any],
+        lat: float,
+        lon: float,
+        matched: Dict[str, np.ndarray],
+        row: int,
+    ) -> Dict[str, Any]:
+        """NavigationTracker 배치 결과 1행 -> 안내 정보"""
+        if matched["flags"][row] & self.tracker.DEVIATED:
+            return self._deviation_guidance(
+                user_id,
+                self.find_nearest_station(lat, lon),
+                float(matched["distance_to_route"][row]),
+            )
+
+        return self._route_guidance(
+            user_id,
+            session,
+            int(matched["progress_index"][row]),
+            lat,
+            lon,
+            distance=float(matched["distance_to_next"][row]),
+            eta_seconds=float(matched["eta_seconds"][row]),
+        )
+
+    def _guide_with_python(
+        self, user_id: str, session: Dict[str, Any], lat: float, lon: float
+    ) -> Dict[str, Any]:
+        """Python 경로 매칭 (NavigationTracker 미사용 시)"""
         # 현재 위치에서 가장 가까운 역 찾기
         current_station_cd = self.find_nearest_station(lat, lon)
 
         # 세션에서 경로 정보 추출
         route_sequence = session["route_sequence"]
-        destination_cd = session["destination_cd"]
-        transfer_stations = session.get("transfer_stations", [])
-        transfer_info = session.get("transfer_info", [])
 
         logger.debug(
             f"안내 계산: user={user_id}, current={current_station_cd}, route_len={len(route_sequence)}"
         )
 
-        # 경로 상의 모든 역까지의 거리 계산
+        # 경로 상의 모든 역까지의 거리 계산 (배치 1회, 동률이면 경로 앞쪽 역)
         min_distance = float('inf')
         nearest_route_station = None
 
-        for station_cd in route_sequence:
-            station_info = self.stations.get(station_cd)
-            if not station_info:
-                continue
-
-            distance = self.distance_calc.calculate_distance(
-                lat, lon,
-                station_info["lat"], station_info["lng"]
+        route_infos = [
+            (station_cd, self.stations[station_cd])
+            for station_cd in route_sequence
+            if station_cd in self.stations
+        ]
+        if route_infos:
+            distances = self.distance_calc.one_to_many(
+                lat,
+                lon,
+                [info["lat"] for _, info in route_infos],
+                [info["lng"] for _, info in route_infos],
             )
-
-            if distance < min_distance:
-                min_distance = distance
-                nearest_route_station = station_cd
+            best = int(np.argmin(distances))
+            min_distance = float(distances[best])
+            nearest_route_station = route_infos[best][0]
 
         # Threshold 기반 경로 이탈 판단
         if min_distance > self.ROUTE_DEVIATION_THRESHOLD:
-            # 경로 이탈: 800m 이내에 경로 상의 역이 없음
-            nearest_overall = get_station_name_by_code(current_station_cd)
-            logger.warning(
-                f"경로 이탈: user={user_id}, nearest_overall={nearest_overall}, "
-                f"distance_to_route={min_distance:.1f}m, threshold={self.ROUTE_DEVIATION_THRESHOLD}m"
-            )
-
-            return {
-                "recalculate": True,
-                "message": "경로를 이탈했습니다. 경로를 다시 계산합니다.",
-                "current_location": current_station_cd,
-                "nearest_station": nearest_overall,
-                "deviation_distance": round(min_distance, 1),
-            }
+            return self._deviation_guidance(user_id, current_station_cd, min_distance)
 
         # 경로 유지: 가장 가까운 경로 상의 역 사용
         current_station_cd = nearest_route_station
@@ -130,6 +298,49 @@ class GuidanceService:
             logger.error(f"경로 역 인덱스 찾기 실패: {current_station_cd}")
             return {"recalculate": True, "message": "경로 오류가 발생했습니다."}
 
+        return self._route_guidance(user_id, session, current_idx, lat, lon)
+
+    def _deviation_guidance(
+        self, user_id: str, current_station_cd: str, min_distance: float
+    ) -> Dict[str, Any]:
+        """경로 이탈: 800m 이내에 경로 상의 역이 없음"""
+        nearest_overall = get_station_name_by_code(current_station_cd)
+        logger.warning(
+            f"경로 이탈: user={user_id}, nearest_overall={nearest_overall}, "
+            f"distance_to_route={min_distance:.1f}m, threshold={self.ROUTE_DEVIATION_THRESHOLD}m"
+        )
+
+        return {
+            "recalculate": True,
+            "message": "경로를 이탈했습니다. 경로를 다시 계산합니다.",
+            "current_location": current_station_cd,
+            "nearest_station": nearest_overall,
+            "deviation_distance": round(min_distance, 1),
+        }
+
+    def _route_guidance(
+        self,
+        user_id: str,
+        session: Dict[str, Any],
+        current_idx: int,
+        lat: float,
+        lon: float,
+        distance: Optional[float] = None,
+        eta_seconds: Optional[float] = None,
+    ) -> Dict[str, Any]:
+        """
+        경로 상 위치(current_idx) 기준 도착/다음 역/환승 안내
+
+        Args:
+            distance: 다음 역까지 거리 (None이면 DistanceCalculator로 계산)
+            eta_seconds: 목적지까지 예상 주행 시간 (NavigationTracker 사용 시)
+        """
+        route_sequence = session["route_sequence"]
+        destination_cd = session["destination_cd"]
+        transfer_stations = session.get("transfer_stations", [])
+        transfer_info = session.get("transfer_info", [])
+        current_station_cd = route_sequence[current_idx]
+
         # 목적지 도착 확인
         if current_station_cd == destination_cd:
             logger.info(
@@ -152,9 +363,10 @@ class GuidanceService:
                 raise InvalidLocationException("다음 역 정보를 찾을 수 없습니다")
 
             # 다음 역까지 거리 계산
-            distance = self.distance_calc.calculate_distance(
-                lat, lon, next_station_info["lat"], next_station_info["lng"]
-            )
+            if distance is None:
+                distance = self.distance_calc.calculate_distance(
+                    lat, lon, next_station_info["lat"], next_station_info["lng"]
+                )
 
             # 역 이름 조회
             current_station_name = get_station_name_by_code(current_station_cd)
@@ -174,6 +386,8 @@ class GuidanceService:
                 "route_id": session["route_id"],
                 "progress_percent": progress,
             }
+            if eta_seconds is not None:
+                guidance["eta_seconds"] = round(eta_seconds)
 
             # 환승역 확인
             if next_station_cd in transfer_stations:
@@ -221,7 +435,8 @@ class GuidanceService:
 
     def find_nearest_station(self, lat: float, lon: float) -> str:
         """
-        현재 위치에서 가장 가까운 역 찾기 => KD-Tree 사용 : O(log N)
+        현재 위치에서 가장 가까운 역 찾기
+        => C++ SpatialIndex (격자, haversine 거리) 또는 KD-Tree : O(log N)
 
         Args:
             lat: 위도
@@ -230,9 +445,44 @@ class GuidanceService:
         Returns:
             가장 가까운 역의 station_cd
         """
+        if self.spatial_index is not None:
+            return self.find_nearest_stations([lat], [lon])[0][0]
+
         distance, index = self.kdtree.query([lat, lon])
         return self.station_cd_list[index]
 
+    def find_nearest_stations(
+        self, lats: Sequence[float], lons: Sequence[float], k: int = 1
+    ) -> List[List[str]]:
+        """
+        여러 위치의 가까운 역 일괄 조회 (위치 업데이트 배치 처리용)
+
+        C++ SpatialIndex 사용 시 한 번의 호출로 전체 배치를 GIL 해제 상태에서 처리
+
+        Args:
+            lats: 위도 배열
+            lons: 경도 배열
+            k: 위치별 반환할 역 수
+
+        Returns:
+            위치별 가까운 순 station_cd 목록
+        """
+        lats = np.asarray(lats, dtype=np.float64)
+        lons = np.asarray(lons, dtype=np.float64)
+
+        if self.spatial_index is not None:
+            ids, _ = self.spatial_index.nearest(lats, lons, k)
+            codes = self.data_container.get_codes(ids.ravel())
+            return [
+                [cd for cd in codes[i * k : (i + 1) * k] if cd]
+                for i in range(len(lats))
+            ]
+
+        k = min(k, len(self.station_cd_list))
+        _, index = self.kdtree.query(np.column_stack([lats, lons]), k=k)
+        index = np.asarray(index).reshape(len(lats), k)
+        return [[self.station_cd_list[j] for j in row] for row in index]
+
     def find_nearest_station_name(self, lat: float, lon: float) -> str:
         """
         현재 위치에서 가장 가까운 역 이름 반환
@@ -59,6 +59,20 @@ def get_pathfinding_service() -> Union[PathfindingService, "PathfindingServiceCP
         return service
 
 
+def close_pathfinding_service() -> None:
+    """
+    생성된 경로 탐색 서비스의 백그라운드 작업 정리 (애플리케이션 종료 시)
+
+    C++ 엔진: 캐시 예열 중단, 결과 캐시 파일 마지막 저장
+    서비스가 아직 생성되지 않았으면 아무것도 하지 않음
+    """
+    if get_pathfinding_service.cache_info().currsize == 0:
+        return
+    service = get_pathfinding_service()
+    if hasattr(service, "close"):
+        service.close()
+
+
 def get_engine_info() -> dict:
     """
     현재 사용 중인 엔진 정보 반환
@@ -71,7 +85,7 @@ def get_engine_info() -> dict:
     engine_type = "cpp" if settings.USE_CPP_ENGINE else "python"
     engine_name = service.__class__.__name__
 
-    return {
+    info = {
         "engine_type": engine_type,
         "engine_class": engine_name,
         "cpp_enabled": settings.USE_CPP_ENGINE,
@@ -81,3 +95,9 @@ def get_engine_info() -> dict:
             else "Python McRaptor 엔진 (표준)"
         ),
     }
+
+    # C++ 엔진: 결과 캐시/예열 진행 상황 (배포 직후 캐시 준비 여부 확인용)
+    if hasattr(service, "result_cache_stats"):
+        info["result_cache"] = service.result_cache_stats()
+
+    return info
@@ -1,10 +1,14 @@
 # C++ 엔진 기반 경로 찾기 서비스
 
+import asyncio
 import logging
+import queue
+import threading
+from collections import OrderedDict
 import time
 import json
 from datetime import datetime
-from typing import Optional, Dict, Any
+from typing import Optional, Dict, Any, Callable, List, Tuple
 
 from app.db.redis_client import RedisSessionManager
 from app.db.cache import (
@@ -21,7 +25,11 @@ from app.db.database import (
     get_all_congestion_data,
     get_all_sections,
 )
-from app.core.exceptions import RouteNotFoundException, StationNotFoundException
+from app.core.exceptions import (
+    RouteNotFoundException,
+    ServiceOverloadedException,
+    StationNotFoundException,
+)
 from app.core.config import settings
 
 logger = logging.getLogger(__name__)
@@ -38,6 +46,17 @@ class PathfindingServiceCPP:
     핵심 알고리즘은 C++로 구현된 McRaptorEngine을 사용합니다.
     """
 
+    # calculate_route(on_update=...) 점진적 결과 전달 지원 (websocket route_progress)
+    SUPPORTS_PROGRESSIVE = True
+    # calculate_route(session_id=...) 세션 단위 재탐색 지원 (websocket recalculate_route)
+    SUPPORTS_SESSION_REROUTE = True
+    # calculate_route(origin_location=...) 현재 위치 주변 역 다중 출발 지원 (도보 접근 시간 반영)
+    SUPPORTS_LOCATION_ORIGIN = True
+    # calculate_route_async: 네이티브 워커 풀에서 탐색 후 await (REST 엔드포인트)
+    SUPPORTS_ASYNC = True
+    # calculate_route_async(priority="high"): 안내 중 재탐색을 경로 조회보다 먼저 실행
+    SUPPORTS_PRIORITY = True
+
     def __init__(self):
         """
         PathfindingServiceCPP 초기화
@@ -93,6 +112,67 @@ class PathfindingServiceCPP:
             logger.debug(f"   - 예외 타입: {type(e).__name__}")
             raise
 
+        # 역 좌표 공간 인덱스 (엔진과 동일한 StationID 공간, GuidanceService가 공유)
+        self.spatial_index = self.cpp_module.SpatialIndex(self.data_container)
+        logger.debug(
+            f"   - SpatialIndex 구축: {len(self.spatial_index)}개 역, "
+            f"셀 {self.spatial_index.cell_size:.0f}m"
+        )
+
+        # 이름이 다른 인접 역 간 도보 연결 (적재 시 CPP_FOOTPATH_MAX_MINUTES로 1회 구축)
+        logger.debug(
+            f"   - 도보 연결: {self.data_container.footpath_count}개 "
+            f"(최대 {settings.CPP_FOOTPATH_MAX_MINUTES:g}분)"
+        )
+
+        # 비동기 탐색 워커 풀 (calculate_route_async, 요청마다 워커가 엔진 생성)
+        # 대기열 상한/대기 시간 예산을 넘는 요청은 탐색 없이 거절 (과부하 시 지연 폭증 방지)
+        # 부하(대기열 길이/최근 p99 대기)가 높으면 단계별로 탐색 강도를 낮춤 (CPP_EFFORT_POLICY)
+        self.query_pool = self.cpp_module.QueryPool(
+            self.data_container,
+            settings.CPP_QUERY_THREADS,
+            max_queue=settings.CPP_QUERY_MAX_QUEUE,
+            max_wait_ms=settings.CPP_QUERY_MAX_WAIT_MS,
+            effort_levels=json.loads(settings.CPP_EFFORT_POLICY or "[]"),
+        )
+        logger.debug(
+            f"   - QueryPool: 워커 {self.query_pool.thread_count}개, "
+            f"대기열 {settings.CPP_QUERY_MAX_QUEUE}, 대기 예산 {settings.CPP_QUERY_MAX_WAIT_MS:g}ms, "
+            f"탐색 강도 {self.query_pool.effort_level_count}단계"
+        )
+
+        # 질의 빈도 집계 (요청마다 기록, 상위 빈도 질의는 메트릭/캐시 예열 대상으로 사용)
+        self.query_sketch = self.cpp_module.QuerySketch(
+            self.data_container,
+            top_k=settings.CPP_QUERY_SKETCH_TOP_K,
+            window_seconds=settings.CPP_QUERY_SKETCH_WINDOW_SECONDS,
+        )
+
+        # 프로세스 내 결과 캐시 (값은 바이너리 RouteSet 페이로드, 데이터 갱신 이전 항목은 조회 시 폐기)
+        self.result_cache = self.cpp_module.ResultCache(
+            self.data_container, settings.CPP_RESULT_CACHE_SIZE
+        )
+        # 재시작 간 결과 캐시 보존: 같은 네트워크/데이터로 저장된 파일이면 복원 (예열은 복원된 항목을 건너뜀)
+        self.cache_checkpointer = self._restore_result_cache()
+        # 인기 경로 예열: 워커 풀 LOW 우선순위로 백그라운드 계산 (초기화를 기다리지 않음)
+        # 대상은 CPP_WARMUP_REFRESH_SECONDS마다 질의 집계/조회 통계로 갱신 (_maybe_refresh_warmup)
+        self._closed = False
+        self._warmup_refresh_lock = threading.Lock()
+        self._warmup_refreshed_at = time.monotonic()
+        self.cache_warmer = self._start_cache_warmer()
+
+        # 세션별 직전 탐색 엔진 (경로 이탈 재탐색 시 탐색 트리 재사용, LRU)
+        self._session_engines: "OrderedDict[str, Any]" = OrderedDict()
+        self._session_lock = threading.Lock()
+
+        # 오프라인 재생 도구용 스냅샷/쿼리 로그
+        # 쿼리 로그는 요청 경로에서 큐에 넣기만 하고, 백그라운드 스레드가 열어 둔 파일 하나에 기록
+        self._query_log_queue: Optional["queue.SimpleQueue[Optional[str]]"] = None
+        self._query_log_thread: Optional[threading.Thread] = None
+        self._start_query_log()
+        if settings.CPP_SNAPSHOT_PATH:
+            self.export_snapshot(settings.CPP_SNAPSHOT_PATH)
+
         # C++ 엔진 초기화
         # logger.info("C++ McRaptorEngine 초기화 시작...")
         # self.cpp_engine = pathfinding_cpp.McRaptorEngine(self.data_container)
@@ -289,6 +369,7 @@ class PathfindingServiceCPP:
             station_order_dict,
             transfers_dict,
             congestion_dict,
+            footpath_minutes=settings.CPP_FOOTPATH_MAX_MINUTES,
         )
 
         # 6. 편의시설 데이터 로드 및 편의성 점수 계산
@@ -325,7 +406,13 @@ class PathfindingServiceCPP:
         return data_container
 
     def calculate_route(
-        self, origin_name: str, destination_name: str, disability_type: str
+        self,
+        origin_name: str,
+        destination_name: str,
+        disability_type: str,
+        on_update: Optional[Callable[[Dict[str, Any]], None]] = None,
+        session_id: Optional[str] = None,
+        origin_location: Optional[Tuple[float, float]] = None,
     ) -> Optional[Dict[str, Any]]:
         """
         C++ 엔진을 사용한 경로 계산 및 상위 3개 경로 반환 + factory pattern
@@ -334,6 +421,15 @@ class PathfindingServiceCPP:
             origin_name: 출발지 역 이름
             destination_name: 목적지 역 이름
             disability_type: 장애 유형 (PHY/VIS/AUD/ELD)
+            on_update: 점진적 결과 콜백 (선택). 지정 시 탐색 라운드마다 목적지 경로가
+                새로 발견되면 {"round", "routes", "total_routes_found"}를 전달합니다.
+                C++ 탐색 스레드에서 호출되므로 빠르게 반환해야 합니다 (캐시 히트 시 호출 없음).
+            session_id: 내비게이션 세션 ID (선택). 지정 시 탐색 트리를 세션에 보관하고,
+                같은 세션의 다음 요청(경로 이탈 후 재계산)은 보관된 트리에서 현재 역 이후
+                잔여 경로를 먼저 복구한 뒤 재탐색합니다 (round 0으로 on_update 전달).
+            origin_location: 현재 위치 (위도, 경도) (선택). 지정 시 반경 CPP_ACCESS_RADIUS_M 이내
+                역들(가까운 순 최대 CPP_ACCESS_MAX_ORIGINS개)을 도보 접근 시간만큼 늦게 출발하는
+                출발역으로 동시에 탐색합니다. 각 경로에 access_distance_m이 추가되며 캐시는 사용하지 않습니다.
 
         Returns:
             경로 데이터 딕셔너리 (상위 3개 경로 포함)
@@ -344,64 +440,37 @@ class PathfindingServiceCPP:
             RouteNotFoundException: 경로를 찾을 수 없을 때
         """
         start_time = time.time()
+        session_engine = None
+        engine_kept = False
 
         try:
-            # 장애 유형 유효성 검증
-            if disability_type not in VALID_DISABILITY_TYPES:
-                raise ValueError(
-                    f"유효하지 않은 장애 유형: {disability_type}. "
-                    f"유효한 값: {', '.join(VALID_DISABILITY_TYPES)}"
-                )
-
-            # 역 코드 조회
-            origin_cd = get_station_cd_by_name(origin_name)
-            destination_cd = get_station_cd_by_name(destination_name)
-
-            if not origin_cd:
-                raise StationNotFoundException(
-                    f"출발지 역을 찾을 수 없습니다: {origin_name}"
-                )
-
-            if not destination_cd:
-                raise StationNotFoundException(
-                    f"목적지 역을 찾을 수 없습니다: {destination_name}"
-                )
-
-            logger.info(
-                f"[C++] 경로 계산 요청: {origin_name}({origin_cd}) → "
-                f"{destination_name}({destination_cd}), 유형={disability_type}"
+            query = self._resolve_query(
+                origin_name, destination_name, disability_type, origin_location
             )
+            origin_cd = query["origin_cd"]
+            destination_cd = query["destination_cd"]
 
-            # 캐시 키 생성
-            cache_key = f"route:cpp:{origin_cd}:{destination_cd}:{disability_type}"
-
-            # 캐시 확인
-            cached_result = self.redis_client.get_cached_route(cache_key)
-
+            cached_result = self._cached_result(query, start_time)
             if cached_result:
-                elapsed_time = time.time() - start_time
-                logger.info(
-                    f"[C++] 캐시에서 경로 반환: {origin_name} → {destination_name}, "
-                    f"응답시간={elapsed_time*1000:.1f}ms"
-                )
-                self._log_cache_metrics(
-                    cache_hit=True,
-                    response_time_ms=elapsed_time * 1000,
-                    origin=origin_name,
-                    destination=destination_name,
-                    disability_type=disability_type,
-                )
                 return cached_result
 
             # 캐시 미스 -> C++ 엔진으로 경로 계산
-            logger.debug(f"[C++] 캐시 미스, 경로 계산 시작: {cache_key}")
             calculation_start = time.time()
 
             departure_time = datetime.now().timestamp()  # Unix timestamp
 
             # 요청마다 새로운 엔진 인스턴스 생성 Thread-Safe 보장
             # DataContainer는 공유되지만 Read-Only이므로 안전
-            engine = self.cpp_module.McRaptorEngine(self.data_container)
+            # (세션 재탐색: 보관된 엔진을 꺼내 단독 사용)
+            session_engine = self._take_session_engine(session_id)
+            engine = session_engine or self._new_engine()
+            if settings.CPP_INTRA_QUERY_THREADS > 1:
+                engine.parallel_threads = settings.CPP_INTRA_QUERY_THREADS
+            progress = (
+                self._progress_callback(engine, disability_type, on_update)
+                if on_update is not None
+                else None
+            )
 
             # C++ 엔진 호출
             logger.debug(
@@ -409,153 +478,912 @@ class PathfindingServiceCPP:
                 f"type={disability_type}"
             )
 
-            # local variable 사용
-            routes = engine.find_routes(
-                origin_cd,
-                {destination_cd},
+            self._record_query(
+                origin_cd, destination_cd, disability_type, departure_time
+            )
+
+            # 정수 ID 질의 (역 코드는 resolve_ids로 한 번에 변환, 엔진 호출마다 문자열 변환 없음)
+            # 탐색(세션이면 재탐색) -> 경로 미발견 시 라운드 확장 -> 정렬 -> 경로 재구성을
+            # GIL 해제 상태의 C++ 호출 한 번으로 수행 (Label 목록이 Python을 거치지 않음)
+            # 라운드 확장은 완료된 라운드를 재사용하고 추가 라운드만 수행
+            # (progress가 있으면 라운드별 점진적 결과, find_routes_streaming과 동일)
+            origin_ids, access_m, dest_ids = self._query_ids(query)
+            route_set = engine.find_route_set(
+                origin_ids,
+                dest_ids,
                 departure_time,
                 disability_type,
-                5,
+                settings.CPP_MAX_ROUNDS,
+                settings.CPP_MAX_ROUNDS_ESCALATED,
+                access_m,
+                progress,
+                reroute=session_engine is not None,
             )
+            if session_engine is not None:
+                logger.info(
+                    f"[C++] 세션 재탐색: 이전 탐색에서 "
+                    f"{engine.last_stats.routes_reused}개 경로 복구"
+                )
 
-            if not routes:
+            if len(route_set) == 0:
                 raise RouteNotFoundException(
                     f"{origin_name}에서 {destination_name}까지 경로를 찾을 수 없습니다"
                 )
 
-            # C++ 엔진으로 경로 정렬
-            ranked_routes = engine.rank_routes(routes, disability_type)
-
             calculation_time = time.time() - calculation_start
-            logger.debug(
-                f"[C++] 경로 계산 완료: {len(ranked_routes)}개 발견, "
-                f"계산시간={calculation_time:.2f}s"
+            self._keep_session_engine(session_id, engine)
+            engine_kept = True
+            return self._finish_query(
+                query, engine, route_set, start_time, calculation_time
             )
 
-            # 상위 3개 경로 선택
-            top_3_routes = ranked_routes[:3]
-
-            # 각 경로 정보 생성
-            routes_info = []
-            for rank, label in enumerate(top_3_routes, start=1):
-                # C++ Label 객체에서 정보 추출
-                route_sequence = engine.reconstruct_route(label, self.data_container)
-                route_lines = engine.reconstruct_lines(label)
-                score = label.score
-
-                # 환승 정보 추출 (Label 객체를 역추적하여 구성)
-                transfer_info = self._extract_transfer_info(label, engine)
-                transfer_stations = [t[0] for t in transfer_info]
-
-                route_info = {
-                    "rank": rank,
-                    "route_sequence": route_sequence,
-                    "route_lines": route_lines,
-                    "total_time": round(label.arrival_time, 1),
-                    "transfers": label.transfers,
-                    "transfer_stations": transfer_stations,
-                    "transfer_info": transfer_info,
-                    "score": round(score, 4),
-                    "avg_convenience": round(label.avg_convenience, 2),
-                    "avg_congestion": round(label.avg_congestion, 2),
-                    "max_transfer_difficulty": round(label.max_transfer_difficulty, 2),
-                }
-                routes_info.append(route_info)
-
-            result = {
-                "origin": origin_name,
-                "origin_cd": origin_cd,
-                "destination": destination_name,
-                "destination_cd": destination_cd,
-                "routes": routes_info,
-                "total_routes_found": len(routes),
-                "routes_returned": len(routes_info),
-            }
+        except (StationNotFoundException, RouteNotFoundException) as e:
+            logger.error(f"[C++] 경로 계산 실패: {e.message}")
+            raise
+        except Exception as e:
+            logger.error(f"[C++] 경로 계산 오류: {e}", exc_info=True)
+            raise
+        finally:
+            # 경로 없음/오류로 끝나도 꺼낸 세션 엔진은 되돌림 (다음 재탐색이 일반 탐색이 되지 않도록)
+            if session_engine is not None and not engine_kept:
+                self._restore_session_engine(session_id, session_engine)
 
-            # Redis 캐싱
-            cache_success = self.redis_client.cache_route(
-                cache_key, result, ttl=settings.ROUTE_CACHE_TTL_SECONDS
-            )
+    async def calculate_route_async(
+        self,
+        origin_name: str,
+        destination_name: str,
+        disability_type: str,
+        origin_location: Optional[Tuple[float, float]] = None,
+        on_update: Optional[Callable[[Dict[str, Any]], None]] = None,
+        session_id: Optional[str] = None,
+        priority: str = "normal",
+    ) -> Optional[Dict[str, Any]]:
+        """
+        calculate_route의 asyncio 버전 (REST 엔드포인트 / WebSocket 재탐색)
 
-            if cache_success:
-                logger.debug(f"[C++] 경로 캐싱 완료: {cache_key}")
-            else:
-                logger.warning(f"[C++] 경로 캐싱 실패 (계속 진행): {cache_key}")
+        탐색은 네이티브 워커 풀(QueryPool)에서 수행되고 완료 시 이벤트 루프로 결과가 전달되므로,
+        진행 중인 요청마다 Python 스레드(Starlette 스레드풀)를 점유하지 않습니다.
+        on_update는 워커 스레드에서 호출됩니다 (calculate_route와 동일하게 빠르게 반환).
+        역 코드 조회(DB 폴백), Redis 캐시 조회/저장은 asyncio.to_thread로 이벤트 루프 밖에서
+        수행하고, 루프에서는 워커 풀 탐색 완료만 기다립니다 (쿼리 로그는 큐에 넣기만 함).
+
+        Args:
+            priority: "high"(안내 중 재탐색) 또는 "normal"(경로 조회)
+                high 요청은 대기열에서 먼저 실행되고, 대기 중인 동안 실행 중인 normal 탐색은
+                경로를 찾은 라운드에서 종료됩니다.
+            그 외 Args / Returns / Raises: calculate_route와 동일
+            (과부하로 거절되면 ServiceOverloadedException)
+        """
+        start_time = time.time()
+        session_engine = None
+        engine_kept = False
+        future = None
 
-            # 메트릭 로깅
-            elapsed_time = time.time() - start_time
-            logger.info(
-                f"[C++] 경로 계산 및 반환: {origin_name} → {destination_name}, "
-                f"총 응답시간={elapsed_time:.2f}s, 계산시간={calculation_time:.2f}s"
+        try:
+            query = await asyncio.to_thread(
+                self._resolve_query,
+                origin_name,
+                destination_name,
+                disability_type,
+                origin_location,
+            )
+            cached_result = await asyncio.to_thread(
+                self._cached_result, query, start_time
             )
+            if cached_result:
+                return cached_result
 
-            self._log_cache_metrics(
-                cache_hit=False,
-                response_time_ms=elapsed_time * 1000,
-                calculation_time_ms=calculation_time * 1000,
-                origin=origin_name,
-                destination=destination_name,
-                disability_type=disability_type,
-                routes_found=len(ranked_routes),
+            calculation_start = time.time()
+            departure_time = datetime.now().timestamp()  # Unix timestamp
+            self._record_query(
+                query["origin_cd"],
+                query["destination_cd"],
+                disability_type,
+                departure_time,
             )
 
-            return result
+            # 세션 재탐색/점진적 결과는 엔진을 먼저 만들어 워커에 넘김 (없으면 워커가 생성)
+            session_engine = self._take_session_engine(session_id)
+            engine = session_engine
+            if engine is None and (session_id or on_update is not None):
+                engine = self._new_engine()
+            if engine is not None:
+                # 워커 풀 탐색은 순차 스캔 (동기 경로에서 만든 세션 엔진의 병렬 설정 해제)
+                engine.parallel_threads = 1
+            progress = (
+                self._progress_callback(engine, disability_type, on_update)
+                if on_update is not None
+                else None
+            )
+
+            # 라운드 확장, 정렬, 경로 재구성까지 워커에서 수행 (RouteSet 결과)
+            # (concurrent Future를 보관해 취소 시 워커가 엔진 사용을 마친 뒤 세션에 되돌림)
+            try:
+                future = self.query_pool.submit(
+                    query["origins"],
+                    {query["destination_cd"]},
+                    departure_time,
+                    disability_type,
+                    settings.CPP_MAX_ROUNDS,
+                    settings.CPP_MAX_ROUNDS_ESCALATED,
+                    priority=self._query_priority(priority),
+                    engine=engine,
+                    reroute=session_engine is not None,
+                    on_update=progress,
+                    route_set=True,
+                )
+                engine, route_set = await asyncio.wrap_future(future)
+            except self.cpp_module.QueryRejected as e:
+                logger.warning(f"[C++] 과부하로 요청 거절 ({priority}): {e}")
+                raise ServiceOverloadedException()
+            if session_engine is not None:
+                logger.info(
+                    f"[C++] 세션 재탐색: 이전 탐색에서 "
+                    f"{engine.last_stats.routes_reused}개 경로 복구"
+                )
+
+            if len(route_set) == 0:
+                raise RouteNotFoundException(
+                    f"{origin_name}에서 {destination_name}까지 경로를 찾을 수 없습니다"
+                )
+
+            calculation_time = time.time() - calculation_start
+            self._keep_session_engine(session_id, engine)
+            engine_kept = True
+            return await asyncio.to_thread(
+                self._finish_query, query, engine, route_set, start_time, calculation_time
+            )
 
         except (StationNotFoundException, RouteNotFoundException) as e:
             logger.error(f"[C++] 경로 계산 실패: {e.message}")
             raise
+        except ServiceOverloadedException:
+            raise
         except Exception as e:
             logger.error(f"[C++] 경로 계산 오류: {e}", exc_info=True)
             raise
+        finally:
+            # 거절/경로 없음/오류/취소(asyncio.wait_for 시간 초과 등)로 끝나도 꺼낸 세션 엔진은 되돌림
+            # 취소 시 워커가 아직 탐색 중이면 완료 후에 되돌림 (동시에 두 탐색이 같은 엔진을 쓰지 않도록)
+            if session_engine is not None and not engine_kept:
+                if future is not None and not future.done():
+                    future.add_done_callback(
+                        lambda _: self._restore_session_engine(
+                            session_id, session_engine
+                        )
+                    )
+                else:
+                    self._restore_session_engine(session_id, session_engine)
+
+    def _query_priority(self, priority: str):
+        """"high" / "normal" / "low" -> pathfinding_cpp.QueryPriority"""
+        if priority == "high":
+            return self.cpp_module.QueryPriority.HIGH
+        if priority == "normal":
+            return self.cpp_module.QueryPriority.NORMAL
+        if priority == "low":
+            return self.cpp_module.QueryPriority.LOW
+        raise ValueError(f"유효하지 않은 우선순위: {priority}")
+
+    def query_pool_stats(self) -> Dict[str, Any]:
+        """워커 풀 대기열/지연 통계 (최근 요청 기준 백분위수, 메트릭 엔드포인트용)"""
+        stats = self.query_pool.stats()
+        classes = {}
+        for name in ("high", "normal", "low"):
+            cls = stats.for_priority(self._query_priority(name))
+            classes[name] = {
+                "submitted": cls.submitted,
+                "completed": cls.completed,
+                "rejected": cls.rejected,
+                "shed": cls.shed,
+                "preempted": cls.preempted,
+                "queued": cls.queued,
+                "wait_ms": {
+                    "p50": round(cls.wait_ms_p50, 2),
+                    "p99": round(cls.wait_ms_p99, 2),
+                },
+                "service_ms": {
+                    "p50": round(cls.service_ms_p50, 2),
+                    "p99": round(cls.service_ms_p99, 2),
+                },
+                "latency_ms": {
+                    "p50": round(cls.latency_ms_p50, 2),
+                    "p99": round(cls.latency_ms_p99, 2),
+                },
+            }
+        return {
+            "threads": self.query_pool.thread_count,
+            "max_queue": self.query_pool.max_queue,
+            "max_wait_ms": self.query_pool.max_wait_ms,
+            "queued": stats.queued,
+            "running": stats.running,
+            "peak_queued": stats.peak_queued,
+            "submitted": stats.submitted,
+            "completed": stats.completed,
+            "failed": stats.failed,
+            "rejected": stats.rejected,
+            "shed": stats.shed,
+            "cancelled": stats.cancelled,
+            "wait_ms": {
+                "p50": round(stats.wait_ms_p50, 2),
+                "p99": round(stats.wait_ms_p99, 2),
+                "max": round(stats.wait_ms_max, 2),
+            },
+            "service_ms": {
+                "p50": round(stats.service_ms_p50, 2),
+                "p99": round(stats.service_ms_p99, 2),
+                "avg": round(stats.service_ms_avg, 2),
+            },
+            "estimated_wait_ms": round(stats.estimated_wait_ms, 2),
+            "effort_level": stats.effort_level,
+            "effort_counts": list(stats.effort_counts),
+            "classes": classes,
+            "result_cache": self.result_cache_stats(),
+        }
+
+    def result_cache_stats(self) -> Dict[str, Any]:
+        """프로세스 내 결과 캐시 / 예열 진행 통계"""
+        cache = self.result_cache.stats()
+        result = {
+            "size": cache.size,
+            "capacity": cache.capacity,
+            "bytes": cache.bytes,
+            "hits": cache.hits,
+            "misses": cache.misses,
+            "stale": cache.stale,
+            "evictions": cache.evictions,
+            "restored": cache.restored,
+            "data_version": self.data_container.data_version,
+        }
+        if self.cache_checkpointer is not None:
+            checkpoint = self.cache_checkpointer.stats()
+            result["checkpoint"] = {
+                "path": self.cache_checkpointer.path,
+                "saves": checkpoint.saves,
+                "failures": checkpoint.failures,
+                "last_entries": checkpoint.last_entries,
+                "last_save_ms": round(checkpoint.last_save_ms, 1),
+                "last_error": checkpoint.last_error,
+            }
+        if self.cache_warmer is not None:
+            warmup = self.cache_warmer.stats()
+            result["warmup"] = {
+                "targets": warmup.targets,
+                "running": warmup.running,
+                "runs": warmup.runs,
+                "submitted": warmup.submitted,
+                "cached": warmup.cached,
+                "failed": warmup.failed,
+                "data_version": warmup.data_version,
+                "last_run_ms": round(warmup.last_run_ms, 1),
+            }
+        return result
+
+    def query_mix_stats(self, limit: int = 20) -> Dict[str, Any]:
+        """최근 창 기준 상위 빈도 질의 (출발, 도착, 장애 유형, 30분 슬롯), 메트릭 엔드포인트용"""
+        top = []
+        for origin_cd, destination_cd, disability_type, slot, count in self.query_sketch.top(
+            limit
+        ):
+            top.append(
+                {
+                    "origin": self.stations.get(origin_cd, {}).get("name", origin_cd),
+                    "destination": self.stations.get(destination_cd, {}).get(
+                        "name", destination_cd
+                    ),
+                    "disability_type": disability_type,
+                    "slot": f"{slot // 2:02d}:{slot % 2 * 30:02d}",
+                    "count": count,
+                }
+            )
+        return {
+            "window_seconds": settings.CPP_QUERY_SKETCH_WINDOW_SECONDS,
+            "total": self.query_sketch.total,
+            "top": top,
+        }
 
-    def _extract_transfer_info(self, label, engine) -> list:
+    def _restore_result_cache(self):
         """
-        C++ Label 객체에서 환승 정보 추출
+        CPP_RESULT_CACHE_PATH 파일에서 결과 캐시를 복원하고 주기 저장 시작
 
-        Note: C++ bindings.cpp에서 transfer_info를 직접 노출하지 않는 경우,
-        reconstruct_route와 reconstruct_lines를 비교하여 환승 지점을 찾습니다.
+        파일의 데이터 지문(역/노선 ID 체계 + 데이터 내용)이 현재 적재한 네트워크와 다르면 복원하지 않음
+        경로가 비어 있거나 결과 캐시가 비활성화되어 있으면 None
+        """
+        path = settings.CPP_RESULT_CACHE_PATH
+        if not path or settings.CPP_RESULT_CACHE_SIZE <= 0:
+            return None
 
-        Args:
-            label: C++ Label 객체
-            engine: McRaptorEngine 인스턴스 (팩토리 패턴으로 요청마다 생성)
+        try:
+            restored = self.result_cache.load(path)
+            logger.info(f"   - 결과 캐시 복원: {restored}개 ({path})")
+        except Exception as e:
+            # 손상된 파일은 다음 저장 시 덮어씀
+            logger.warning(f"결과 캐시 파일 복원 실패 ({path}): {e}")
 
-        Returns:
-            List[Tuple[str, str, str]]: [(station_cd, from_line, to_line), ...]
+        return self.cpp_module.CacheCheckpointer(
+            self.result_cache,
+            path,
+            interval_seconds=settings.CPP_RESULT_CACHE_CHECKPOINT_SECONDS,
+        )
+
+    def close(self) -> None:
+        """
+        예열 중단, 결과 캐시 마지막 저장, 쿼리 로그 마무리 (애플리케이션 종료 시 호출, 중복 호출 가능)
+        """
+        self._closed = True
+        with self._warmup_refresh_lock:  # 진행 중인 예열 대상 갱신 완료 대기
+            pass
+        if self.cache_warmer is not None:
+            self.cache_warmer.stop()
+        if self.cache_checkpointer is not None:
+            self.cache_checkpointer.stop()
+            stats = self.cache_checkpointer.stats()
+            if stats.last_error:
+                logger.warning(f"결과 캐시 저장 실패: {stats.last_error}")
+        if self._query_log_thread is not None:
+            # 남은 쿼리 로그를 기록하고 파일을 닫은 뒤 종료
+            self._query_log_queue.put(None)
+            self._query_log_thread.join()
+            self._query_log_thread = None
+            self._query_log_queue = None
+
+    def _new_engine(self):
+        """요청/세션용 McRaptorEngine (재탐색 목표 가지치기 설정 적용)"""
+        engine = self.cpp_module.McRaptorEngine(self.data_container)
+        engine.target_pruning = settings.CPP_REROUTE_TARGET_PRUNING
+        return engine
+
+    def _start_cache_warmer(self):
+        """
+        조회 통계 상위 출발-도착 쌍(CPP_WARMUP_PAIRS) x 장애 유형(CPP_WARMUP_PROFILES) 예열 시작
+
+        통계가 없거나 비활성화 설정이면 None (통계가 생기면 _refresh_cache_warmer에서 시작)
+        """
+        if not self._warmup_enabled():
+            return None
+
+        targets = self._warmup_targets(settings.CPP_WARMUP_PAIRS)
+        if not targets:
+            logger.debug("   - 캐시 예열: 조회 통계 없음, 건너뜀")
+            return None
+
+        warmer = self._new_cache_warmer(targets)
+        logger.info(f"   - 캐시 예열 시작: {len(targets)}개 대상 (백그라운드)")
+        return warmer
+
+    @staticmethod
+    def _warmup_enabled() -> bool:
+        return settings.CPP_WARMUP_PAIRS > 0 and settings.CPP_RESULT_CACHE_SIZE > 0
+
+    def _new_cache_warmer(self, targets: list):
+        return self.cpp_module.CacheWarmer(
+            self.query_pool,
+            self.data_container,
+            self.result_cache,
+            targets,
+            max_rounds=settings.CPP_MAX_ROUNDS,
+            escalated_rounds=settings.CPP_MAX_ROUNDS_ESCALATED,
+        )
+
+    def _maybe_refresh_warmup(self) -> None:
+        """
+        CPP_WARMUP_REFRESH_SECONDS가 지났으면 예열 대상 갱신을 백그라운드 스레드로 시작
+        (요청 경로에서는 시각 비교만, 이미 갱신 중이면 건너뜀)
+        """
+        interval = settings.CPP_WARMUP_REFRESH_SECONDS
+        if interval <= 0 or not self._warmup_enabled():
+            return
+        if time.monotonic() - self._warmup_refreshed_at < interval:
+            return
+        if not self._warmup_refresh_lock.acquire(blocking=False):
+            return
+        self._warmup_refreshed_at = time.monotonic()
+        threading.Thread(
+            target=self._refresh_cache_warmer, name="warmup-refresh", daemon=True
+        ).start()
+
+    def _refresh_cache_warmer(self) -> None:
+        """
+        예열 대상을 현재 질의 집계(QuerySketch) 상위 항목 + stats:od_pair로 교체
+        (_warmup_refresh_lock을 쥔 스레드에서 호출, 완료 시 해제)
         """
         try:
-            # 경로 및 노선 재구성
-            route_sequence = engine.reconstruct_route(label, self.data_container)
-            route_lines = engine.reconstruct_lines(label)
-
-            # 길이 검증: route_sequence와 route_lines의 길이가 일치해야 함
-            if len(route_sequence) != len(route_lines):
-                logger.warning(
-                    f"경로 시퀀스({len(route_sequence)})와 노선({len(route_lines)}) 길이 불일치"
+            if self._closed:
+                return
+            targets = self._warmup_targets(settings.CPP_WARMUP_PAIRS)
+            if not targets:
+                return
+            if self.cache_warmer is None:
+                self.cache_warmer = self._new_cache_warmer(targets)
+                logger.info(f"캐시 예열 시작: {len(targets)}개 대상 (질의 집계 갱신)")
+            else:
+                self.cache_warmer.set_targets(targets)
+                logger.debug(f"캐시 예열 대상 갱신: {len(targets)}개")
+        except Exception as e:
+            logger.warning(f"캐시 예열 대상 갱신 실패: {e}")
+        finally:
+            self._warmup_refresh_lock.release()
+
+    def _warmup_targets(self, limit: int) -> list:
+        """
+        예열 대상 WarmupTarget 목록
+
+        - 프로세스 질의 집계(QuerySketch) 상위 항목: 조회된 장애 유형 그대로 (시간대 무관하게 합산)
+          시작 시에는 비어 있고, 주기적 갱신(_refresh_cache_warmer)부터 반영
+        - stats:od_pair 상위 limit개("출발-도착", 조회 수) x CPP_WARMUP_PROFILES
+        가중치는 조회 수, 같은 캐시 키는 한 번만 (집계 항목 우선)
+        """
+        profiles = [
+            p.strip()
+            for p in settings.CPP_WARMUP_PROFILES.split(",")
+            if p.strip() in VALID_DISABILITY_TYPES
+        ]
+        targets = []
+        seen = set()
+
+        sketch_counts: "OrderedDict[Tuple[str, str, str], int]" = OrderedDict()
+        for origin_cd, destination_cd, disability_type, _, count in self.query_sketch.top(
+            limit
+        ):
+            key = (origin_cd, destination_cd, disability_type)
+            sketch_counts[key] = sketch_counts.get(key, 0) + count
+        for (origin_cd, destination_cd, disability_type), count in sketch_counts.items():
+            origin = self.stations.get(origin_cd, {}).get("name")
+            destination = self.stations.get(destination_cd, {}).get("name")
+            if not origin or not destination:
+                continue
+            cache_key = self._cache_key(origin_cd, destination_cd, disability_type)
+            seen.add(cache_key)
+            targets.append(
+                self.cpp_module.WarmupTarget(
+                    cache_key,
+                    origin,
+                    origin_cd,
+                    destination,
+                    destination_cd,
+                    disability_type,
+                    weight=count,
                 )
-                return []
+            )
 
-            # 환승 지점 찾기 (노선이 변경되는 지점)
-            transfer_info = []
+        for od_pair, count in self.redis_client.get_top_od_pairs(limit):
+            origin, sep, destination = od_pair.partition("-")
+            origin_cd = get_station_cd_by_name(origin) if sep else None
+            destination_cd = get_station_cd_by_name(destination) if sep else None
+            if not origin_cd or not destination_cd:
+                continue
+            for disability_type in profiles:
+                cache_key = self._cache_key(origin_cd, destination_cd, disability_type)
+                if cache_key in seen:
+                    continue
+                seen.add(cache_key)
+                targets.append(
+                    self.cpp_module.WarmupTarget(
+                        cache_key,
+                        origin,
+                        origin_cd,
+                        destination,
+                        destination_cd,
+                        disability_type,
+                        weight=count,
+                    )
+                )
+        return targets
 
-            for i in range(len(route_lines) - 1):
-                if route_lines[i] != route_lines[i + 1]:
-                    # 환승 발생
-                    # 인덱스 범위 검증
-                    if i + 1 < len(route_sequence):
-                        transfer_station = route_sequence[i + 1]  # 환승역
-                        from_line = route_lines[i]
-                        to_line = route_lines[i + 1]
+    def _resolve_query(
+        self,
+        origin_name: str,
+        destination_name: str,
+        disability_type: str,
+        origin_location: Optional[Tuple[float, float]],
+    ) -> Dict[str, Any]:
+        """
+        요청 검증 및 탐색 입력 구성 (calculate_route / calculate_route_async 공용)
 
-                        transfer_info.append((transfer_station, from_line, to_line))
-                    else:
-                        logger.warning(f"환승역 인덱스 {i + 1}이 범위를 벗어남")
+        Returns:
+            origin/destination 이름·코드, disability_type, access_legs(위치 기반 출발이 아니면 None),
+            origins(엔진 입력: 역 코드 또는 접근 목록), cache_key,
+            data_version(결과 캐시 저장 시 기준이 되는 요청 시점의 데이터 버전)
+        """
+        # 장애 유형 유효성 검증
+        if disability_type not in VALID_DISABILITY_TYPES:
+            raise ValueError(
+                f"유효하지 않은 장애 유형: {disability_type}. "
+                f"유효한 값: {', '.join(VALID_DISABILITY_TYPES)}"
+            )
 
-            return transfer_info
+        # 역 코드 조회
+        origin_cd = get_station_cd_by_name(origin_name)
+        destination_cd = get_station_cd_by_name(destination_name)
 
-        except Exception as e:
-            logger.warning(f"환승 정보 추출 실패: {e}, 빈 리스트 반환")
+        if not origin_cd:
+            raise StationNotFoundException(
+                f"출발지 역을 찾을 수 없습니다: {origin_name}"
+            )
+
+        if not destination_cd:
+            raise StationNotFoundException(
+                f"목적지 역을 찾을 수 없습니다: {destination_name}"
+            )
+
+        logger.info(
+            f"[C++] 경로 계산 요청: {origin_name}({origin_cd}) → "
+            f"{destination_name}({destination_cd}), 유형={disability_type}"
+        )
+        self.query_sketch.record(origin_cd, destination_cd, disability_type, time.time())
+        self._maybe_refresh_warmup()
+
+        # 위치 기반 출발: 주변 역 도보 접근 목록 (결과가 위치마다 달라 캐시 미사용)
+        access_legs = (
+            self._access_legs(*origin_location) or None
+            if origin_location is not None
+            else None
+        )
+
+        return {
+            "origin": origin_name,
+            "origin_cd": origin_cd,
+            "destination": destination_name,
+            "destination_cd": destination_cd,
+            "disability_type": disability_type,
+            "access_legs": access_legs,
+            "origins": access_legs if access_legs is not None else origin_cd,
+            "cache_key": self._cache_key(origin_cd, destination_cd, disability_type),
+            "data_version": self.data_container.data_version,
+        }
+
+    @staticmethod
+    def _cache_key(origin_cd: str, destination_cd: str, disability_type: str) -> str:
+        """경로 캐시 키 (프로세스 내 결과 캐시 / Redis / 예열 공용)"""
+        return f"route:cpp:{origin_cd}:{destination_cd}:{disability_type}"
+
+    def _query_ids(self, query: Dict[str, Any]):
+        """
+        엔진 정수 ID 입력 (출발역 ID 배열, 접근 거리 목록, 목적지 ID 배열)
+
+        출발/목적지 역 코드를 DataContainer.resolve_ids 1회 호출로 변환합니다.
+        """
+        legs = query["access_legs"] or [(query["origin_cd"], 0.0)]
+        codes = [cd for cd, _ in legs] + [query["destination_cd"]]
+        ids = self.data_container.resolve_ids(codes)
+        missing = [cd for cd, i in zip(codes, ids) if i < 0]
+        if missing:
+            raise StationNotFoundException(
+                f"C++ 엔진 데이터에 없는 역입니다: {', '.join(missing)}"
+            )
+        return ids[:-1], [d for _, d in legs], ids[-1:]
+
+    def _cached_result(
+        self, query: Dict[str, Any], start_time: float
+    ) -> Optional[Dict[str, Any]]:
+        """
+        프로세스 내 결과 캐시 -> Redis 캐시 순으로 조회 (위치 기반 출발은 미사용),
+        히트 시 메트릭 기록
+        """
+        if query["access_legs"] is not None:
+            return None
+
+        cached_result = None
+        payload = self.result_cache.get(query["cache_key"])
+        if payload is not None:
+            try:
+                cached_result = self._decode_cached_route(payload)
+            except RuntimeError as e:
+                logger.warning(f"[C++] 결과 캐시 항목 디코딩 실패: {e}")
+        if cached_result is None:
+            cached_result = self.redis_client.get_cached_route(
+                query["cache_key"], decode_binary=self._decode_cached_route
+            )
+        if not cached_result:
+            logger.debug(f"[C++] 캐시 미스, 경로 계산 시작: {query['cache_key']}")
+            return None
+
+        elapsed_time = time.time() - start_time
+        logger.info(
+            f"[C++] 캐시에서 경로 반환: {query['origin']} → {query['destination']}, "
+            f"응답시간={elapsed_time*1000:.1f}ms"
+        )
+        self._log_cache_metrics(
+            cache_hit=True,
+            response_time_ms=elapsed_time * 1000,
+            origin=query["origin"],
+            destination=query["destination"],
+            disability_type=query["disability_type"],
+        )
+        return cached_result
+
+    def _finish_query(
+        self,
+        query: Dict[str, Any],
+        engine,
+        route_set,
+        start_time: float,
+        calculation_time: float,
+    ) -> Dict[str, Any]:
+        """정렬된 경로(RouteSet) -> 응답 딕셔너리 생성, Redis 캐싱 및 메트릭 기록"""
+        logger.debug(
+            f"[C++] 경로 계산 완료: {len(route_set)}개 발견, "
+            f"계산시간={calculation_time:.2f}s"
+        )
+
+        # 상위 3개 경로 정보 생성
+        routes_info = self._build_routes_info(route_set, 3)
+        access_legs = query["access_legs"]
+        if access_legs is not None:
+            access_distance = dict(access_legs)
+            for info in routes_info:
+                info["access_distance_m"] = round(
+                    access_distance.get(info["route_sequence"][0], 0.0), 1
+                )
+
+        result = self._route_result(
+            query["origin"],
+            query["origin_cd"],
+            query["destination"],
+            query["destination_cd"],
+            routes_info,
+            len(route_set),
+            engine.last_stats.effort_level,
+        )
+
+        # 결과 캐시/Redis 캐싱 (위치 기반 출발 결과와 부하로 탐색 강도를 낮춘 결과는 제외)
+        # 값은 C++에서 RouteSet을 직접 직렬화 (응답 딕셔너리 JSON 인코딩 없음)
+        cache_key = query["cache_key"]
+        if access_legs is None and result["effort_level"] == 0:
+            payload = self._cache_payload(query, route_set, "binary")
+            self.result_cache.put(cache_key, payload, query["data_version"])
+            if settings.ROUTE_CACHE_FORMAT == "json":
+                payload = self._cache_payload(query, route_set)
+            cache_success = self.redis_client.cache_route(
+                cache_key,
+                result,
+                ttl=settings.ROUTE_CACHE_TTL_SECONDS,
+                payload=payload,
+            )
+
+            if cache_success:
+                logger.debug(f"[C++] 경로 캐싱 완료: {cache_key}")
+            else:
+                logger.warning(f"[C++] 경로 캐싱 실패 (계속 진행): {cache_key}")
+
+        # 메트릭 로깅
+        elapsed_time = time.time() - start_time
+        logger.info(
+            f"[C++] 경로 계산 및 반환: {query['origin']} → {query['destination']}, "
+            f"총 응답시간={elapsed_time:.2f}s, 계산시간={calculation_time:.2f}s"
+        )
+
+        self._log_cache_metrics(
+            cache_hit=False,
+            response_time_ms=elapsed_time * 1000,
+            calculation_time_ms=calculation_time * 1000,
+            origin=query["origin"],
+            destination=query["destination"],
+            disability_type=query["disability_type"],
+            routes_found=len(route_set),
+        )
+
+        return result
+
+    @staticmethod
+    def _route_result(
+        origin: str,
+        origin_cd: str,
+        destination: str,
+        destination_cd: str,
+        routes_info: list,
+        total_routes_found: int,
+        effort_level: int,
+    ) -> Dict[str, Any]:
+        """응답 딕셔너리 (키 순서는 C++ RouteSet.to_json과 동일)"""
+        return {
+            "origin": origin,
+            "origin_cd": origin_cd,
+            "destination": destination,
+            "destination_cd": destination_cd,
+            "routes": routes_info,
+            "total_routes_found": total_routes_found,
+            "routes_returned": len(routes_info),
+            # 부하 적응 탐색 강도 단계 (0 = 전체 탐색)
+            "effort_level": effort_level,
+        }
+
+    def _cache_payload(
+        self, query: Dict[str, Any], route_set, cache_format: Optional[str] = None
+    ) -> bytes:
+        """
+        RouteSet -> 캐시 값 (상위 3개 경로)
+
+        cache_format: "binary" 또는 "json" (None이면 ROUTE_CACHE_FORMAT)
+        """
+        cache_format = cache_format or settings.ROUTE_CACHE_FORMAT
+        encode = route_set.to_json if cache_format == "json" else route_set.encode
+        return encode(
+            self.data_container,
+            query["origin"],
+            query["origin_cd"],
+            query["destination"],
+            query["destination_cd"],
+            max_routes=3,
+        )
+
+    def _decode_cached_route(self, payload: bytes) -> Dict[str, Any]:
+        """
+        바이너리 캐시 값 -> 응답 딕셔너리
+
+        역 데이터가 바뀌어 역/노선 ID 체계가 다르면 RuntimeError (캐시 미스로 처리)
+        """
+        decoded = self.cpp_module.decode_route_payload(payload, self.data_container)
+        routes = decoded.routes
+        return self._route_result(
+            decoded.origin,
+            decoded.origin_cd,
+            decoded.destination,
+            decoded.destination_cd,
+            self._build_routes_info(routes, len(routes)),
+            decoded.total_routes_found,
+            decoded.effort_level,
+        )
+
+    def _build_routes_info(self, route_set, count: int) -> list:
+        """
+        RouteSet -> 응답용 경로 정보 리스트 (상위 count개)
+
+        Args:
+            route_set: find_route_set / route_set 결과 (rank_routes 정렬 순, 경로 재구성 완료)
+                또는 캐시 페이로드에서 디코딩한 RouteSet
+            count: 반환할 경로 수
+        """
+        # 기준 값 열은 NumPy 뷰 (복사 없음), 경로별로 필요한 값만 Python 값으로 변환
+        arrival_time = route_set.arrival_time
+        transfers = route_set.transfers
+        score = route_set.score
+        avg_convenience = route_set.avg_convenience
+        avg_congestion = route_set.avg_congestion
+        max_transfer_difficulty = route_set.max_transfer_difficulty
+
+        routes_info = []
+        for i in range(min(count, len(route_set))):
+            route_sequence = route_set.route_codes(i, self.data_container)
+            route_lines = route_set.route_lines(i, self.data_container)
+
+            # 환승 정보 추출 (노선이 바뀌는 지점)
+            transfer_info = self._extract_transfer_info(route_sequence, route_lines)
+            transfer_stations = [t[0] for t in transfer_info]
+
+            route_info = {
+                "rank": i + 1,
+                "route_sequence": route_sequence,
+                "route_lines": route_lines,
+                "total_time": round(float(arrival_time[i]), 1),
+                "transfers": int(transfers[i]),
+                "transfer_stations": transfer_stations,
+                "transfer_info": transfer_info,
+                "score": round(float(score[i]), 4),
+                "avg_convenience": round(float(avg_convenience[i]), 2),
+                "avg_congestion": round(float(avg_congestion[i]), 2),
+                "max_transfer_difficulty": round(float(max_transfer_difficulty[i]), 2),
+            }
+            routes_info.append(route_info)
+        return routes_info
+
+    def _access_legs(self, lat: float, lon: float) -> List[Tuple[str, float]]:
+        """
+        현재 위치 -> 도보 접근 출발역 목록 [(역 코드, 거리 m), ...] (가까운 순)
+
+        반경 CPP_ACCESS_RADIUS_M 이내 역을 최대 CPP_ACCESS_MAX_ORIGINS개 사용하고,
+        반경 내 역이 없으면 가장 가까운 역 1개를 사용합니다.
+        """
+        _, ids, dists = self.spatial_index.within(
+            [lat], [lon], settings.CPP_ACCESS_RADIUS_M
+        )
+        ids, dists = [int(i) for i in ids], [float(d) for d in dists]
+        if not ids:
+            nearest_ids, nearest_dists = self.spatial_index.nearest([lat], [lon], 1)
+            ids, dists = [int(nearest_ids[0][0])], [float(nearest_dists[0][0])]
+
+        limit = max(settings.CPP_ACCESS_MAX_ORIGINS, 1)
+        codes = self.data_container.get_codes(ids[:limit])
+        return [(cd, d) for cd, d in zip(codes, dists[:limit]) if cd]
+
+    def _take_session_engine(self, session_id: Optional[str]):
+        """세션에 보관된 직전 탐색 엔진을 꺼냄 (없으면 None)"""
+        if not session_id:
+            return None
+        with self._session_lock:
+            return self._session_engines.pop(session_id, None)
+
+    def _keep_session_engine(
+        self, session_id: Optional[str], engine, replace: bool = True
+    ) -> None:
+        """
+        탐색을 마친 엔진을 세션에 보관 (CPP_REROUTE_SESSIONS 초과 시 오래된 세션부터 제거)
+
+        replace=False면 세션에 이미 보관된 엔진이 있을 때 그대로 둠
+        """
+        if not session_id or settings.CPP_REROUTE_SESSIONS <= 0:
+            return
+        engine.shrink()  # 예약된 label pool 여유 용량 해제
+        with self._session_lock:
+            if not replace and session_id in self._session_engines:
+                return
+            self._session_engines[session_id] = engine
+            self._session_engines.move_to_end(session_id)
+            while len(self._session_engines) > settings.CPP_REROUTE_SESSIONS:
+                self._session_engines.popitem(last=False)
+
+    def _restore_session_engine(self, session_id: Optional[str], engine) -> None:
+        """
+        실패/취소된 요청이 꺼낸 세션 엔진을 되돌림
+
+        그 사이 같은 세션의 다른 요청이 새 엔진을 보관했으면 그 엔진을 유지
+        """
+        self._keep_session_engine(session_id, engine, replace=False)
+
+    def release_session(self, session_id: str) -> None:
+        """내비게이션 종료 시 보관된 탐색 트리 해제"""
+        with self._session_lock:
+            self._session_engines.pop(session_id, None)
+
+    def _progress_callback(
+        self,
+        engine,
+        disability_type: str,
+        on_update: Callable[[Dict[str, Any]], None],
+    ):
+        """
+        find_routes_streaming용 콜백 생성
+
+        라운드마다 현재까지의 목적지 Label을 정렬/재구성(RouteSet)하여 상위 3개 경로로 변환 후
+        on_update에 전달합니다.
+        콜백 오류는 탐색을 중단시키지 않도록 로그만 남깁니다.
+        """
+
+        def callback(round_no, routes):
+            try:
+                route_set = engine.route_set(routes, disability_type)
+                on_update(
+                    {
+                        "round": round_no,
+                        "routes": self._build_routes_info(route_set, 3),
+                        "total_routes_found": len(routes),
+                    }
+                )
+            except Exception as e:
+                logger.warning(f"[C++] 점진적 결과 전달 실패 (round={round_no}): {e}")
+            return True
+
+        return callback
+
+    def _extract_transfer_info(self, route_sequence, route_lines) -> list:
+        """
+        재구성된 경로에서 환승 정보 추출
+
+        route_sequence와 route_lines를 비교하여 노선이 바뀌는 지점을 환승으로 봅니다.
+
+        Args:
+            route_sequence: 경로 역 코드 목록 (RouteSet.route_codes)
+            route_lines: 같은 위치의 노선 목록 (RouteSet.route_lines)
+
+        Returns:
+            List[Tuple[str, str, str]]: [(station_cd, from_line, to_line), ...]
+        """
+        # 길이 검증: route_sequence와 route_lines의 길이가 일치해야 함
+        if len(route_sequence) != len(route_lines):
+            logger.warning(
+                f"경로 시퀀스({len(route_sequence)})와 노선({len(route_lines)}) 길이 불일치"
+            )
             return []
 
+        # 환승 지점 찾기 (노선이 변경되는 지점, 환승역 = 변경 후 첫 역)
+        transfer_info = []
+        for i in range(len(route_lines) - 1):
+            if route_lines[i] != route_lines[i + 1]:
+                transfer_info.append(
+                    (route_sequence[i + 1], route_lines[i], route_lines[i + 1])
+                )
+        return transfer_info
+
     def _log_cache_metrics(
         self,
         cache_hit: bool,
@@ -590,6 +1418,84 @@ class PathfindingServiceCPP:
 
         logger.info(f"METRICS: {json.dumps(metrics, ensure_ascii=False)}")
 
+    def export_snapshot(self, path: str) -> bool:
+        """
+        현재 DataContainer 상태를 스냅샷 파일로 저장
+
+        cpp_src/tools/ 의 오프라인 도구(replay_driver 등)가 동일한 네트워크를
+        DB 없이 재현하는 데 사용합니다.
+
+        Returns:
+            저장 성공 여부
+        """
+        try:
+            self.data_container.save_snapshot(path)
+            logger.info(f"C++ 네트워크 스냅샷 저장 완료: {path}")
+            return True
+        except Exception as e:
+            logger.warning(f"C++ 네트워크 스냅샷 저장 실패 ({path}): {e}")
+            return False
+
+    def _start_query_log(self) -> None:
+        """쿼리 로그 파일을 추가 모드로 열고 기록 스레드 시작 (CPP_QUERY_LOG_PATH 설정 시)"""
+        if not settings.CPP_QUERY_LOG_PATH:
+            return
+        try:
+            log_file = open(settings.CPP_QUERY_LOG_PATH, "a", encoding="utf-8")
+        except OSError as e:
+            logger.warning(f"쿼리 로그 파일 열기 실패 (기록 안 함): {e}")
+            return
+
+        self._query_log_queue = queue.SimpleQueue()
+        self._query_log_thread = threading.Thread(
+            target=self._write_query_log,
+            args=(self._query_log_queue, log_file),
+            name="cpp-query-log",
+            daemon=True,
+        )
+        self._query_log_thread.start()
+
+    @staticmethod
+    def _write_query_log(lines: "queue.SimpleQueue[Optional[str]]", log_file) -> None:
+        """큐의 쿼리 로그를 파일에 기록 (쌓인 줄을 모아 쓰고 큐가 비면 flush, None이면 종료)"""
+        with log_file:
+            stopping = False
+            while not stopping:
+                batch = [lines.get()]
+                while True:
+                    try:
+                        batch.append(lines.get_nowait())
+                    except queue.Empty:
+                        break
+                if None in batch:
+                    stopping = True
+                    batch = batch[: batch.index(None)]
+                try:
+                    log_file.write("".join(batch))
+                    log_file.flush()
+                except OSError as e:
+                    logger.warning(f"쿼리 로그 기록 실패: {e}")
+
+    def _record_query(
+        self,
+        origin_cd: str,
+        destination_cd: str,
+        disability_type: str,
+        departure_time: float,
+    ) -> None:
+        """
+        엔진 호출 쿼리를 CSV로 기록 (CPP_QUERY_LOG_PATH 설정 시)
+
+        형식: origin_cd,dest_cd,profile,timestamp (replay_driver 입력 형식)
+        큐에 넣기만 하므로 요청 경로(이벤트 루프 포함)를 막지 않음, 파일 쓰기는 _write_query_log
+        """
+        log_queue = self._query_log_queue
+        if log_queue is None:
+            return
+        log_queue.put(
+            f"{origin_cd},{destination_cd},{disability_type},{departure_time:.3f}\n"
+        )
+
     def refresh_facility_scores(self):
         """
         편의시설 점수 데이터를 C++ 엔진에 업데이트
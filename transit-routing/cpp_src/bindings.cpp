@@ -1,8 +1,21 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include "engine.h"
 #include "data_loader.h"
+#include "spatial_index.h"
+#include "station_search.h"
+#include "navigation_tracker.h"
+#include "distance_kernels.h"
+#include "query_pool.h"
+#include "route_set.h"
+#include "route_payload.h"
+#include "result_cache.h"
+#include "cache_warmer.h"
+#include "cache_checkpointer.h"
+#include "query_sketch.h"
 #include "utils.h"
+#include <cmath>
 
 namespace py = pybind11;
 using namespace pathfinding;
@@ -10,32 +23,329 @@ using namespace pathfinding;
 // Wrappers
 std::vector<std::string> reconstruct_route_wrapper(McRaptorEngine &engine, const Label &leaf_label, const DataContainer &data)
 {
-    std::vector<Label> full_path = engine.reconstruct_path(leaf_label);
+    std::vector<PathStop> stops = engine.reconstruct_stops(leaf_label);
     std::vector<std::string> route_codes;
-    route_codes.reserve(full_path.size());
-    for (const auto &label : full_path)
+    route_codes.reserve(stops.size());
+    for (const auto &stop : stops)
     {
-        route_codes.push_back(data.get_code(label.station_id));
+        route_codes.push_back(data.get_code(stop.station_id));
     }
     return route_codes;
 }
 
 std::vector<std::string> reconstruct_lines_wrapper(McRaptorEngine &engine, const Label &leaf_label)
 {
-    std::vector<Label> full_path = engine.reconstruct_path(leaf_label);
+    std::vector<PathStop> stops = engine.reconstruct_stops(leaf_label);
     std::vector<std::string> lines;
-    lines.reserve(full_path.size());
-    for (const auto &label : full_path)
+    lines.reserve(stops.size());
+    for (const auto &stop : stops)
     {
-        lines.push_back(label.current_line);
+        lines.push_back(stop.line_id < 0 ? std::string() : engine.data().line_name(static_cast<LineID>(stop.line_id)));
     }
     return lines;
 }
 
+// 도보 접근 출발역 목록 [(역 코드, 접근 거리 m), ...]
+using AccessList = std::vector<std::pair<std::string, double>>;
+
+std::vector<AccessLeg> to_access_legs(const AccessList &origins)
+{
+    std::vector<AccessLeg> legs;
+    legs.reserve(origins.size());
+    for (const auto &[cd, dist] : origins)
+        legs.push_back({cd, dist});
+    return legs;
+}
+
+// 탐색 강도 정책: [{"queue_per_worker", "wait_p99_ms", "epsilon", "max_bag_size", "max_rounds"}, ...]
+// (낮은 단계부터, 없는 키는 0)
+using EffortLevelList = std::vector<std::unordered_map<std::string, double>>;
+
+EffortPolicy to_effort_policy(const EffortLevelList &levels)
+{
+    auto get = [](const std::unordered_map<std::string, double> &m, const char *key)
+    {
+        auto it = m.find(key);
+        return it == m.end() ? 0.0 : it->second;
+    };
+    EffortPolicy policy;
+    for (const auto &m : levels)
+    {
+        EffortLevel lv;
+        lv.queue_per_worker = get(m, "queue_per_worker");
+        lv.wait_p99_ms = get(m, "wait_p99_ms");
+        lv.effort.epsilon = std::max(get(m, "epsilon"), 0.0);
+        lv.effort.max_bag_size = static_cast<size_t>(std::max(get(m, "max_bag_size"), 0.0));
+        lv.effort.max_rounds = static_cast<int>(std::max(get(m, "max_rounds"), 0.0));
+        policy.push_back(lv);
+    }
+    return policy;
+}
+
+// Python 콜백 -> RouteCallback (호출 시에만 GIL 획득, None 반환은 계속 진행으로 간주)
+RouteCallback wrap_route_callback(const py::object &on_update)
+{
+    if (on_update.is_none())
+        return RouteCallback();
+    return [&on_update](int round, const std::vector<Label> &routes)
+    {
+        py::gil_scoped_acquire acquire;
+        py::object keep_going = on_update(round, routes);
+        return keep_going.is_none() || keep_going.cast<bool>();
+    };
+}
+
+// 워커 스레드에서 복사/소멸되는 Python 객체 (소멸 시 GIL 획득)
+std::shared_ptr<py::object> hold_across_threads(py::object obj)
+{
+    return std::shared_ptr<py::object>(new py::object(std::move(obj)), [](py::object *p)
+                                       {
+                                           py::gil_scoped_acquire acquire;
+                                           delete p; });
+}
+
+// QueryPool 제출 -> concurrent.futures.Future
+// - 워커가 작업을 꺼낼 때 set_running_or_notify_cancel (이미 취소된 요청은 탐색하지 않음)
+// - 완료 시 (engine, ranked_routes) 또는 RuntimeError, 풀 종료로 취소되면 CancelledError
+//   (route_set=True로 제출하면 ranked_routes 대신 워커에서 재구성까지 마친 RouteSet)
+// - 과부하로 거절/폐기되면 QueryRejected (RuntimeError 하위 클래스)
+// - engine: 호출자 엔진 (None이면 워커가 생성), 완료 시 결과로 같은 객체 반환
+// - on_update: 워커 스레드에서 GIL을 획득해 호출
+// asyncio에서는 wrap_future가 loop.call_soon_threadsafe로 이벤트 루프에 결과를 전달
+py::object submit_query(QueryPool &pool, QueryRequest request, py::object engine, py::object on_update)
+{
+    py::object futures = py::module_::import("concurrent.futures");
+    auto future = hold_across_threads(futures.attr("Future")());
+
+    std::shared_ptr<py::object> borrowed;
+    if (!engine.is_none())
+    {
+        request.engine = engine.cast<McRaptorEngine *>();
+        borrowed = hold_across_threads(engine);
+    }
+    if (!on_update.is_none())
+    {
+        auto callback = hold_across_threads(on_update);
+        request.on_update = [callback](int round, const std::vector<Label> &routes)
+        {
+            py::gil_scoped_acquire acquire;
+            py::object keep_going = (*callback)(round, routes);
+            return keep_going.is_none() || keep_going.cast<bool>();
+        };
+    }
+
+    QueryPool::StartFn start = [future]()
+    {
+        py::gil_scoped_acquire acquire;
+        return future->attr("set_running_or_notify_cancel")().cast<bool>();
+    };
+    bool want_route_set = request.build_route_set;
+    QueryPool::DoneFn done = [future, borrowed, want_route_set](QueryResult &&result)
+    {
+        py::gil_scoped_acquire acquire;
+        try
+        {
+            if (future->attr("done")().cast<bool>())
+                return;
+            if (result.cancelled)
+            {
+                // 실행 전(PENDING)이면 cancel, 이미 RUNNING이면 CancelledError로 완료
+                if (!future->attr("cancel")().cast<bool>())
+                    future->attr("set_exception")(py::module_::import("concurrent.futures").attr("CancelledError")());
+            }
+            else if (result.rejected)
+            {
+                future->attr("set_exception")(py::module_::import("pathfinding_cpp").attr("QueryRejected")(result.error));
+            }
+            else if (!result.error.empty())
+            {
+                future->attr("set_exception")(py::module_::import("builtins").attr("RuntimeError")(result.error));
+            }
+            else
+            {
+                py::object engine = borrowed ? *borrowed : py::cast(std::move(result.engine)); // 소유권 이전
+                if (want_route_set)
+                    future->attr("set_result")(py::make_tuple(engine, py::cast(std::move(result.route_set))));
+                else
+                    future->attr("set_result")(py::make_tuple(engine, std::move(result.routes)));
+            }
+        }
+        catch (py::error_already_set &)
+        {
+            // 완료 경합 (InvalidStateError 등): 결과 폐기
+        }
+    };
+
+    pool.submit(std::move(request), std::move(done), std::move(start));
+    return *future;
+}
+
+// QueryPool 과부하 거절 (Python 예외 등록용 타입, C++에서는 QueryResult::rejected로 전달)
+struct QueryRejected : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+// 파이썬 객체 소멸 시 워커 종료 대기 중 GIL 해제 (완료 콜백이 GIL을 요구하므로)
+struct QueryPoolDeleter
+{
+    void operator()(QueryPool *pool) const
+    {
+        py::gil_scoped_release release;
+        delete pool;
+    }
+};
+
+// CacheWarmer 소멸 시 제출한 예열 요청 완료 대기 중 GIL 해제
+struct CacheWarmerDeleter
+{
+    void operator()(CacheWarmer *warmer) const
+    {
+        py::gil_scoped_release release;
+        delete warmer;
+    }
+};
+
+// CacheCheckpointer 소멸 시 마지막 저장(파일 쓰기) 동안 GIL 해제
+struct CacheCheckpointerDeleter
+{
+    void operator()(CacheCheckpointer *checkpointer) const
+    {
+        py::gil_scoped_release release;
+        delete checkpointer;
+    }
+};
+
+// 좌표 배치 입력 (1차원, 연속 메모리로 변환)
+using CoordArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+size_t check_coords(const CoordArray &lats, const CoordArray &lons)
+{
+    if (lats.ndim() > 1 || lons.ndim() > 1)
+        throw std::invalid_argument("lats/lons must be 1-D arrays");
+    if (lats.size() != lons.size())
+        throw std::invalid_argument("lats and lons must have the same length");
+    return static_cast<size_t>(lats.size());
+}
+
+template <typename T>
+py::array_t<T> to_numpy(const std::vector<T> &v)
+{
+    return py::array_t<T>(static_cast<py::ssize_t>(v.size()), v.data());
+}
+
+// 정수 역 ID 배치 입력 (DataContainer.resolve_ids 결과)
+using IdArray = py::array_t<int32_t, py::array::c_style | py::array::forcecast>;
+
+std::vector<StationID> to_station_ids(const IdArray &ids, const char *name)
+{
+    if (ids.ndim() > 1)
+        throw std::invalid_argument(std::string(name) + " must be a 1-D array");
+    std::vector<StationID> out;
+    out.reserve(static_cast<size_t>(ids.size()));
+    const int32_t *p = ids.data();
+    for (py::ssize_t i = 0; i < ids.size(); ++i)
+    {
+        if (p[i] < 0 || p[i] > std::numeric_limits<StationID>::max())
+            throw std::invalid_argument(std::string(name) + " contains an unknown station id: " + std::to_string(p[i]));
+        out.push_back(static_cast<StationID>(p[i]));
+    }
+    return out;
+}
+
+// 출발역 ID + 접근 거리(m, None이면 모두 0)
+std::vector<AccessLegId> to_access_ids(const IdArray &origin_ids, const py::object &access_m)
+{
+    std::vector<StationID> ids = to_station_ids(origin_ids, "origin_ids");
+    std::vector<AccessLegId> legs(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+        legs[i].station_id = ids[i];
+    if (!access_m.is_none())
+    {
+        auto dists = access_m.cast<CoordArray>();
+        if (dists.ndim() > 1 || static_cast<size_t>(dists.size()) != ids.size())
+            throw std::invalid_argument("access_m must be a 1-D array matching origin_ids");
+        for (size_t i = 0; i < ids.size(); ++i)
+            legs[i].distance_m = dists.data()[i];
+    }
+    return legs;
+}
+
+// RouteSet 배열 -> 읽기 전용 NumPy 뷰 (복사 없음, owner(RouteSet 파이썬 객체)를 base로 수명 유지)
+template <typename T>
+py::array_t<T> readonly_view(const T *data, size_t n, py::handle owner)
+{
+    py::array_t<T> view(static_cast<py::ssize_t>(n), data, owner);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
+size_t check_route_index(const RouteSet &set, py::ssize_t i)
+{
+    if (i < 0)
+        i += static_cast<py::ssize_t>(set.size());
+    if (i < 0 || static_cast<size_t>(i) >= set.size())
+        throw py::index_error("route index out of range");
+    return static_cast<size_t>(i);
+}
+
 PYBIND11_MODULE(pathfinding_cpp, m)
 {
     m.doc() = "C++ McRaptor Engine";
 
+    // 배치 거리 커널 (미터, 계산 중 GIL 해제)
+    m.def("haversine_one_to_many", [](double lat, double lon, const CoordArray &lats, const CoordArray &lons)
+          {
+              size_t n = check_coords(lats, lons);
+              py::array_t<double> out(static_cast<py::ssize_t>(n));
+              double *dst = out.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  DistanceKernels::haversine_one_to_many(lat, lon, lats.data(), lons.data(), n, dst);
+              }
+              return out; },
+          py::arg("lat"), py::arg("lon"), py::arg("lats"), py::arg("lons"));
+    m.def("equirect_one_to_many", [](double lat, double lon, const CoordArray &lats, const CoordArray &lons)
+          {
+              size_t n = check_coords(lats, lons);
+              py::array_t<double> out(static_cast<py::ssize_t>(n));
+              double *dst = out.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  DistanceKernels::equirect_one_to_many(lat, lon, lats.data(), lons.data(), n, dst);
+              }
+              return out; },
+          py::arg("lat"), py::arg("lon"), py::arg("lats"), py::arg("lons"));
+    // (len(lats_a), len(lats_b)) 행렬
+    m.def("haversine_many_to_many", [](const CoordArray &lats_a, const CoordArray &lons_a,
+                                       const CoordArray &lats_b, const CoordArray &lons_b)
+          {
+              size_t na = check_coords(lats_a, lons_a);
+              size_t nb = check_coords(lats_b, lons_b);
+              py::array_t<double> out({static_cast<py::ssize_t>(na), static_cast<py::ssize_t>(nb)});
+              double *dst = out.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  DistanceKernels::haversine_many_to_many(lats_a.data(), lons_a.data(), na,
+                                                          lats_b.data(), lons_b.data(), nb, dst);
+              }
+              return out; },
+          py::arg("lats_a"), py::arg("lons_a"), py::arg("lats_b"), py::arg("lons_b"));
+    m.def("equirect_many_to_many", [](const CoordArray &lats_a, const CoordArray &lons_a,
+                                      const CoordArray &lats_b, const CoordArray &lons_b)
+          {
+              size_t na = check_coords(lats_a, lons_a);
+              size_t nb = check_coords(lats_b, lons_b);
+              py::array_t<double> out({static_cast<py::ssize_t>(na), static_cast<py::ssize_t>(nb)});
+              double *dst = out.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  DistanceKernels::equirect_many_to_many(lats_a.data(), lons_a.data(), na,
+                                                         lats_b.data(), lons_b.data(), nb, dst);
+              }
+              return out; },
+          py::arg("lats_a"), py::arg("lons_a"), py::arg("lats_b"), py::arg("lons_b"));
+
     py::class_<Label>(m, "Label")
         .def_readonly("arrival_time", &Label::arrival_time)
         .def_readonly("transfers", &Label::transfers)
@@ -46,6 +356,26 @@ PYBIND11_MODULE(pathfinding_cpp, m)
         .def_property_readonly("avg_congestion", &Label::avg_congestion)
         .def_readonly("score", &Label::score_cache);
 
+    py::class_<SearchStats>(m, "SearchStats")
+        .def_readonly("labels_created", &SearchStats::labels_created)
+        .def_readonly("labels_dominated", &SearchStats::labels_dominated)
+        .def_readonly("rounds", &SearchStats::rounds)
+        .def_readonly("peak_marked", &SearchStats::peak_marked)
+        .def_readonly("aborted", &SearchStats::aborted)
+        .def_readonly("routes_reused", &SearchStats::routes_reused)
+        .def_readonly("parallel_rounds", &SearchStats::parallel_rounds)
+        .def_readonly("preempted", &SearchStats::preempted)
+        .def_readonly("labels_capped", &SearchStats::labels_capped)
+        .def_readonly("effort_level", &SearchStats::effort_level)
+        .def_readonly("labels_pruned", &SearchStats::labels_pruned);
+
+    py::class_<SearchEffort>(m, "SearchEffort")
+        .def(py::init<>())
+        .def_readwrite("level", &SearchEffort::level)
+        .def_readwrite("epsilon", &SearchEffort::epsilon)
+        .def_readwrite("max_bag_size", &SearchEffort::max_bag_size)
+        .def_readwrite("max_rounds", &SearchEffort::max_rounds);
+
     py::class_<DataContainer>(m, "DataContainer")
         .def(py::init<>())
         .def("load_from_python", &DataContainer::load_from_python,
@@ -53,22 +383,826 @@ PYBIND11_MODULE(pathfinding_cpp, m)
              py::arg("line_stations"),
              py::arg("station_order"),
              py::arg("transfers"),
-             py::arg("congestion")) // py::arg()를 사용하여 인자 이름 명시
+             py::arg("congestion"), // py::arg()를 사용하여 인자 이름 명시
+             py::arg("footpath_minutes") = DataContainer::DEFAULT_FOOTPATH_MINUTES)
         .def("update_facility_scores", &DataContainer::update_facility_scores)
-        .def("get_code", &DataContainer::get_code);
+        .def("update_congestion", &DataContainer::update_congestion, py::arg("congestion"))
+        .def("get_code", &DataContainer::get_code)
+        // 역 코드 목록 -> int32 ID 배열 (알 수 없는 코드는 -1), 정수 ID 질의 API 입력을 한 번에 변환
+        .def("resolve_ids", [](const DataContainer &self, const std::vector<std::string> &codes)
+             {
+                 py::array_t<int32_t> ids(static_cast<py::ssize_t>(codes.size()));
+                 int32_t *out = ids.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     for (size_t i = 0; i < codes.size(); ++i)
+                         out[i] = self.find_id(codes[i]);
+                 }
+                 return ids; }, py::arg("codes"))
+        // 노선 ID -> 노선명 (RouteSet.path_lines 변환용)
+        .def_property_readonly("line_names", &DataContainer::line_names)
+        .def("line_id", &DataContainer::line_id, py::arg("line"))
+        .def_property_readonly("network_fingerprint", &DataContainer::network_fingerprint)
+        // 탐색 결과에 영향을 주는 갱신마다 증가 (ResultCache 항목 유효성 기준)
+        .def_property_readonly("data_version", &DataContainer::data_version)
+        // 데이터 내용 해시 (프로세스 간 비교용, 결과 캐시 파일의 복원 기준)
+        .def_property_readonly("content_fingerprint", [](const DataContainer &self)
+                               { return self.content_fingerprint(); }, py::call_guard<py::gil_scoped_release>())
+        // 숫자 역 코드 직접 색인표 사용 여부 (False면 문자열 해시 조회)
+        .def_property_readonly("has_code_table", &DataContainer::has_code_table)
+        // 도보 연결 그래프 (이름이 다른 인접 역 간), 0 이하이면 제거
+        .def("build_footpaths", &DataContainer::build_footpaths,
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("max_walk_minutes") = DataContainer::DEFAULT_FOOTPATH_MINUTES)
+        .def_property_readonly("footpath_count", &DataContainer::footpath_count)
+        // 역의 도보 연결 [(도착 역 코드, 거리 m, 도보 시간 분), ...] (해당 장애 유형 허용 범위만)
+        .def("get_footpaths", [](const DataContainer &self, const std::string &station_cd, const std::string &disability_type)
+             {
+                 size_t type = static_cast<size_t>(PathfindingUtils::str_to_disability(disability_type));
+                 std::shared_lock<std::shared_mutex> lock(self.update_mutex);
+                 std::vector<std::tuple<std::string, double, double>> out;
+                 for (const Footpath &fp : self.get_footpaths(self.get_id(station_cd)))
+                     if (std::isfinite(fp.minutes[type]))
+                         out.emplace_back(self.get_code(fp.to_station_id), fp.distance, fp.minutes[type]);
+                 return out; },
+             py::arg("station_cd"),
+             py::arg("disability_type"))
+        // 역 간 거리 행렬 (n, n) float32 읽기 전용 뷰 (복사 없음, 행렬이 없으면 None)
+        // 뷰가 버퍼를 공유 소유하므로 build_distance_matrix로 교체된 뒤에도 유효
+        .def_property_readonly("distance_matrix", [](const DataContainer &self) -> py::object
+                               {
+                                   auto matrix = self.distance_matrix();
+                                   if (!matrix)
+                                       return py::none();
+                                   auto n = static_cast<py::ssize_t>(self.station_count());
+                                   auto *owner = new std::shared_ptr<const std::vector<float>>(matrix);
+                                   py::capsule base(owner, [](void *p)
+                                                    { delete static_cast<std::shared_ptr<const std::vector<float>> *>(p); });
+                                   py::array_t<float> view({n, n}, matrix->data(), base);
+                                   view.attr("setflags")(py::arg("write") = false);
+                                   return std::move(view); })
+        .def("build_distance_matrix", &DataContainer::build_distance_matrix,
+             py::call_guard<py::gil_scoped_release>())
+        // SpatialIndex 결과(StationID 배열) -> 역 코드 (-1은 빈 문자열)
+        .def("get_codes", [](const DataContainer &self, const py::array_t<int32_t, py::array::c_style | py::array::forcecast> &ids)
+             {
+                 std::vector<std::string> codes;
+                 codes.reserve(static_cast<size_t>(ids.size()));
+                 const int32_t *p = ids.data();
+                 for (py::ssize_t i = 0; i < ids.size(); ++i)
+                     codes.push_back(p[i] < 0 ? std::string() : self.get_code(static_cast<StationID>(p[i])));
+                 return codes; }, py::arg("ids"))
+        // 오프라인 도구(tools/)용 스냅샷 저장/적재
+        .def("save_snapshot", [](const DataContainer &self, const std::string &path)
+             { write_snapshot(self.to_snapshot(), path); }, py::arg("path"))
+        .def("load_snapshot", [](DataContainer &self, const std::string &path, double footpath_minutes)
+             { self.load_snapshot(read_snapshot(path), footpath_minutes); },
+             py::arg("path"),
+             py::arg("footpath_minutes") = DataContainer::DEFAULT_FOOTPATH_MINUTES);
+
+    // 역 좌표 공간 인덱스 (배치 조회 중 GIL 해제)
+    py::class_<SpatialIndex>(m, "SpatialIndex")
+        .def(py::init<const DataContainer &, double>(), py::arg("data"), py::arg("cell_size_m") = 0.0)
+        .def("__len__", &SpatialIndex::size)
+        .def_property_readonly("cell_size", &SpatialIndex::cell_size)
+        // (ids[n, k] int32, distances[n, k] float64 미터), 부족분은 -1 / inf
+        .def("nearest", [](const SpatialIndex &self, const CoordArray &lats, const CoordArray &lons, size_t k)
+             {
+                 size_t n = check_coords(lats, lons);
+                 py::array_t<int32_t> ids({static_cast<py::ssize_t>(n), static_cast<py::ssize_t>(k)});
+                 py::array_t<double> dists({static_cast<py::ssize_t>(n), static_cast<py::ssize_t>(k)});
+                 const double *lat_ptr = lats.data();
+                 const double *lon_ptr = lons.data();
+                 int32_t *id_ptr = ids.mutable_data();
+                 double *dist_ptr = dists.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     self.nearest_batch(lat_ptr, lon_ptr, n, k, id_ptr, dist_ptr);
+                 }
+                 return py::make_tuple(ids, dists); },
+             py::arg("lats"),
+             py::arg("lons"),
+             py::arg("k") = 1)
+        // (offsets[n+1] int64, ids int32, distances float64), i번째 위치 = ids[offsets[i]:offsets[i+1]]
+        .def("within", [](const SpatialIndex &self, const CoordArray &lats, const CoordArray &lons, double radius_m)
+             {
+                 size_t n = check_coords(lats, lons);
+                 std::vector<int64_t> offsets;
+                 std::vector<int32_t> ids;
+                 std::vector<double> dists;
+                 {
+                     py::gil_scoped_release release;
+                     self.within_batch(lats.data(), lons.data(), n, radius_m, offsets, ids, dists);
+                 }
+                 return py::make_tuple(to_numpy(offsets), to_numpy(ids), to_numpy(dists)); },
+             py::arg("lats"),
+             py::arg("lons"),
+             py::arg("radius_m"));
+
+    // 역 이름 자동완성 인덱스 (정규화 키 접두/부분 일치 + 한글 초성 일치)
+    py::class_<StationNameIndex>(m, "StationNameIndex")
+        .def(py::init<const std::vector<std::string> &, const std::vector<std::string> &>(),
+             py::arg("codes"),
+             py::arg("names"))
+        .def("__len__", &StationNameIndex::size)
+        .def_property_readonly("key_count", &StationNameIndex::key_count)
+        // 순위순 역 코드 목록 (정확 < 접두 < 부분 < 초성 접두 < 초성 부분)
+        .def("search", [](const StationNameIndex &self, const std::string &query, size_t limit)
+             {
+                 std::vector<StationNameIndex::Hit> hits;
+                 {
+                     py::gil_scoped_release release;
+                     hits = self.search(query, limit);
+                 }
+                 std::vector<std::string> codes;
+                 codes.reserve(hits.size());
+                 for (auto &hit : hits)
+                     codes.push_back(std::move(hit.station_cd));
+                 return codes; },
+             py::arg("query"),
+             py::arg("limit") = 10);
+
+    // 안내 세션 경로 매칭/진행 추적 (배치 처리 중 GIL 해제)
+    py::class_<NavigationTracker> tracker(m, "NavigationTracker");
+    tracker.attr("DEVIATED") = static_cast<int>(NavUpdate::DEVIATED);
+    tracker.attr("ARRIVED") = static_cast<int>(NavUpdate::ARRIVED);
+    tracker.attr("UNKNOWN") = static_cast<int>(NavUpdate::UNKNOWN);
+    tracker
+        .def(py::init<const DataContainer &, double>(),
+             py::arg("data"),
+             py::arg("deviation_threshold_m") = 800.0,
+             py::keep_alive<1, 2>())
+        .def("start", &NavigationTracker::start, py::arg("route_codes"))
+        .def("end", &NavigationTracker::end, py::arg("handle"))
+        .def("__len__", &NavigationTracker::active_count)
+        // 필드별 NumPy 배열 dict 반환 (next_station은 도착/이탈 시 -1)
+        .def("update", [](const NavigationTracker &self,
+                          const py::array_t<int32_t, py::array::c_style | py::array::forcecast> &handles,
+                          const CoordArray &lats, const CoordArray &lons)
+             {
+                 size_t n = check_coords(lats, lons);
+                 if (handles.ndim() > 1 || static_cast<size_t>(handles.size()) != n)
+                     throw std::invalid_argument("handles must be a 1-D array matching lats/lons");
+
+                 std::vector<NavUpdate> updates(n);
+                 {
+                     py::gil_scoped_release release;
+                     self.update_batch(handles.data(), lats.data(), lons.data(), n, updates.data());
+                 }
+
+                 std::vector<int32_t> progress(n), current(n), next(n);
+                 std::vector<double> to_route(n), to_next(n), eta(n);
+                 std::vector<uint8_t> flags(n);
+                 for (size_t i = 0; i < n; ++i)
+                 {
+                     progress[i] = updates[i].progress_index;
+                     current[i] = updates[i].current_station;
+                     next[i] = updates[i].next_station;
+                     to_route[i] = updates[i].distance_to_route;
+                     to_next[i] = updates[i].distance_to_next;
+                     eta[i] = updates[i].eta_seconds;
+                     flags[i] = updates[i].flags;
+                 }
+                 py::dict out;
+                 out["progress_index"] = to_numpy(progress);
+                 out["current_station"] = to_numpy(current);
+                 out["next_station"] = to_numpy(next);
+                 out["distance_to_route"] = to_numpy(to_route);
+                 out["distance_to_next"] = to_numpy(to_next);
+                 out["eta_seconds"] = to_numpy(eta);
+                 out["flags"] = to_numpy(flags);
+                 return out; },
+             py::arg("handles"),
+             py::arg("lats"),
+             py::arg("lons"));
+
+    // 탐색 결과 묶음 (rank_routes 정렬 순), 배열 속성은 RouteSet 메모리를 그대로 보는 읽기 전용 NumPy 뷰
+    // i번째 경로의 역/노선 ID = path_stations/path_lines[path_offsets[i]:path_offsets[i+1]]
+    auto route_column = [](std::vector<double> RouteSet::*column)
+    {
+        return [column](py::object self)
+        {
+            const std::vector<double> &v = self.cast<const RouteSet &>().*column;
+            return readonly_view(v.data(), v.size(), self);
+        };
+    };
+    py::class_<RouteSet>(m, "RouteSet")
+        .def("__len__", &RouteSet::size)
+        .def_property_readonly("arrival_time", route_column(&RouteSet::arrival_time))
+        .def_property_readonly("score", route_column(&RouteSet::score))
+        .def_property_readonly("avg_convenience", route_column(&RouteSet::avg_convenience))
+        .def_property_readonly("avg_congestion", route_column(&RouteSet::avg_congestion))
+        .def_property_readonly("max_transfer_difficulty", route_column(&RouteSet::max_transfer_difficulty))
+        .def_property_readonly("transfers", [](py::object self)
+                               {
+                                   const RouteSet &set = self.cast<const RouteSet &>();
+                                   return readonly_view(set.transfers.data(), set.transfers.size(), self); })
+        .def_property_readonly("path_offsets", [](py::object self)
+                               {
+                                   const RouteSet &set = self.cast<const RouteSet &>();
+                                   return readonly_view(set.path_offsets.data(), set.path_offsets.size(), self); })
+        .def_property_readonly("path_stations", [](py::object self)
+                               {
+                                   const RouteSet &set = self.cast<const RouteSet &>();
+                                   return readonly_view(set.path_stations.data(), set.path_stations.size(), self); })
+        .def_property_readonly("path_lines", [](py::object self)
+                               {
+                                   const RouteSet &set = self.cast<const RouteSet &>();
+                                   return readonly_view(set.path_lines.data(), set.path_lines.size(), self); })
+        // i번째 경로의 역 ID / 노선 ID 배열 (뷰)
+        .def("station_ids", [](py::object self, py::ssize_t i)
+             {
+                 const RouteSet &set = self.cast<const RouteSet &>();
+                 size_t r = check_route_index(set, i);
+                 return readonly_view(set.path_stations.data() + set.path_begin(r), set.path_end(r) - set.path_begin(r), self); },
+             py::arg("i"))
+        .def("line_ids", [](py::object self, py::ssize_t i)
+             {
+                 const RouteSet &set = self.cast<const RouteSet &>();
+                 size_t r = check_route_index(set, i);
+                 return readonly_view(set.path_lines.data() + set.path_begin(r), set.path_end(r) - set.path_begin(r), self); },
+             py::arg("i"))
+        // i번째 경로의 역 코드 / 노선명 (reconstruct_route / reconstruct_lines와 같은 값)
+        .def("route_codes", [](const RouteSet &self, py::ssize_t i, const DataContainer &data)
+             {
+                 size_t r = check_route_index(self, i);
+                 std::vector<std::string> codes;
+                 codes.reserve(self.path_end(r) - self.path_begin(r));
+                 for (size_t k = self.path_begin(r); k < self.path_end(r); ++k)
+                     codes.push_back(data.get_code(static_cast<StationID>(self.path_stations[k])));
+                 return codes; },
+             py::arg("i"),
+             py::arg("data"))
+        .def("route_lines", [](const RouteSet &self, py::ssize_t i, const DataContainer &data)
+             {
+                 size_t r = check_route_index(self, i);
+                 std::vector<std::string> lines;
+                 lines.reserve(self.path_end(r) - self.path_begin(r));
+                 for (size_t k = self.path_begin(r); k < self.path_end(r); ++k)
+                 {
+                     int32_t id = self.path_lines[k];
+                     lines.push_back(id < 0 ? std::string() : data.line_name(static_cast<LineID>(id)));
+                 }
+                 return lines; },
+             py::arg("i"),
+             py::arg("data"))
+        // 캐시/전송용 직렬화 (상위 max_routes개, route_payload.h 형식)
+        // encode: 버전 바이너리 (decode_route_payload로 복원), to_json: 응답 딕셔너리와 같은 UTF-8 JSON
+        .def("encode", [](const RouteSet &self, const DataContainer &data, const std::string &origin,
+                          const std::string &origin_cd, const std::string &destination,
+                          const std::string &destination_cd, int effort_level, size_t max_routes)
+             {
+                 RoutePayloadMeta meta{origin, origin_cd, destination, destination_cd, effort_level, 0};
+                 std::string out;
+                 {
+                     py::gil_scoped_release release;
+                     out = encode_route_payload(self, data, meta, max_routes);
+                 }
+                 return py::bytes(out); },
+             py::arg("data"),
+             py::arg("origin"),
+             py::arg("origin_cd"),
+             py::arg("destination"),
+             py::arg("destination_cd"),
+             py::arg("effort_level") = 0,
+             py::arg("max_routes") = 3)
+        .def("to_json", [](const RouteSet &self, const DataContainer &data, const std::string &origin,
+                           const std::string &origin_cd, const std::string &destination,
+                           const std::string &destination_cd, int effort_level, size_t max_routes)
+             {
+                 RoutePayloadMeta meta{origin, origin_cd, destination, destination_cd, effort_level, 0};
+                 std::string out;
+                 {
+                     py::gil_scoped_release release;
+                     out = route_payload_json(self, data, meta, max_routes);
+                 }
+                 return py::bytes(out); },
+             py::arg("data"),
+             py::arg("origin"),
+             py::arg("origin_cd"),
+             py::arg("destination"),
+             py::arg("destination_cd"),
+             py::arg("effort_level") = 0,
+             py::arg("max_routes") = 3)
+        // Label 객체는 요청 시에만 생성 (디코딩한 RouteSet은 라벨 없음 -> IndexError)
+        .def("label", [](const RouteSet &self, py::ssize_t i)
+             { return self.labels.at(check_route_index(self, i)); },
+             py::arg("i"))
+        .def_property_readonly("labels", [](const RouteSet &self)
+                               { return self.labels; });
+
+    // 캐시 페이로드 디코딩 결과 (routes: 라벨 없는 RouteSet)
+    py::class_<RoutePayload>(m, "RoutePayload")
+        .def_property_readonly("origin", [](const RoutePayload &self)
+                               { return self.meta.origin; })
+        .def_property_readonly("origin_cd", [](const RoutePayload &self)
+                               { return self.meta.origin_cd; })
+        .def_property_readonly("destination", [](const RoutePayload &self)
+                               { return self.meta.destination; })
+        .def_property_readonly("destination_cd", [](const RoutePayload &self)
+                               { return self.meta.destination_cd; })
+        .def_property_readonly("effort_level", [](const RoutePayload &self)
+                               { return self.meta.effort_level; })
+        .def_property_readonly("total_routes_found", [](const RoutePayload &self)
+                               { return self.meta.total_routes_found; })
+        .def_property_readonly("routes", [](const RoutePayload &self) -> const RouteSet &
+                               { return self.routes; }, py::return_value_policy::reference_internal);
+    m.attr("ROUTE_PAYLOAD_MAGIC") = py::bytes(ROUTE_PAYLOAD_MAGIC, sizeof(ROUTE_PAYLOAD_MAGIC));
+    // 잘못된 페이로드 / 다른 역 데이터로 만든 페이로드는 RuntimeError (캐시 미스로 처리)
+    m.def("decode_route_payload", [](const py::bytes &payload, const DataContainer &data)
+          {
+              std::string buf = payload;
+              py::gil_scoped_release release;
+              return decode_route_payload(buf, data); },
+          py::arg("payload"),
+          py::arg("data"));
 
     py::class_<McRaptorEngine>(m, "McRaptorEngine")
         .def(py::init<const DataContainer &>())
-        .def("find_routes", &McRaptorEngine::find_routes,
+        .def("find_routes", py::overload_cast<const std::string &, const std::unordered_set<std::string> &, double,
+                                              const std::string &, int>(&McRaptorEngine::find_routes),
              py::call_guard<py::gil_scoped_release>(), // <-- C++ 연산 중 Python GIL 해제 => 멀티 스레드 가능
              py::arg("origin_cd"),
              py::arg("dest_cds"),
              py::arg("departure_time"),
              py::arg("disability_type"),
              py::arg("max_rounds"))
+        .def("find_routes", [](McRaptorEngine &self, const AccessList &origins,
+                               const std::unordered_set<std::string> &dest_cds, double departure_time,
+                               const std::string &disability_type, int max_rounds)
+             {
+                 // 다중 출발 (현재 위치 주변 역들, 접근 거리만큼 도보 시간 반영)
+                 std::vector<AccessLeg> legs = to_access_legs(origins);
+                 py::gil_scoped_release release;
+                 return self.find_routes(legs, dest_cds, departure_time, disability_type, max_rounds); },
+             py::arg("origins"),
+             py::arg("dest_cds"),
+             py::arg("departure_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"))
+        .def("find_routes_streaming", [](McRaptorEngine &self, const std::string &origin_cd,
+                                         const std::unordered_set<std::string> &dest_cds, double departure_time,
+                                         const std::string &disability_type, int max_rounds, py::function on_update)
+             {
+                 // 탐색 중에는 GIL 해제, 콜백 호출 시에만 획득
+                 RouteCallback callback = wrap_route_callback(on_update);
+                 py::gil_scoped_release release;
+                 return self.find_routes_streaming(origin_cd, dest_cds, departure_time, disability_type, max_rounds,
+                                                   callback); },
+             py::arg("origin_cd"),
+             py::arg("dest_cds"),
+             py::arg("departure_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("on_update"))
+        .def("find_routes_streaming", [](McRaptorEngine &self, const AccessList &origins,
+                                         const std::unordered_set<std::string> &dest_cds, double departure_time,
+                                         const std::string &disability_type, int max_rounds, py::function on_update)
+             {
+                 std::vector<AccessLeg> legs = to_access_legs(origins);
+                 RouteCallback callback = wrap_route_callback(on_update);
+                 py::gil_scoped_release release;
+                 return self.find_routes_streaming(legs, dest_cds, departure_time, disability_type, max_rounds,
+                                                   callback); },
+             py::arg("origins"),
+             py::arg("dest_cds"),
+             py::arg("departure_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("on_update"))
+        // 정수 ID 질의: origin_ids/dest_ids는 DataContainer.resolve_ids 결과 (코드 문자열 변환 없음)
+        // access_m: 출발역별 도보 접근 거리 (선택), on_update가 있으면 find_routes_streaming과 같은 콜백
+        .def("find_routes_ids", [](McRaptorEngine &self, const IdArray &origin_ids, const IdArray &dest_ids,
+                                   double departure_time, const std::string &disability_type, int max_rounds,
+                                   const py::object &access_m, const py::object &on_update)
+             {
+                 std::vector<AccessLegId> origins = to_access_ids(origin_ids, access_m);
+                 std::vector<StationID> dests = to_station_ids(dest_ids, "dest_ids");
+                 RouteCallback callback = wrap_route_callback(on_update);
+                 py::gil_scoped_release release;
+                 if (callback)
+                     return self.find_routes_streaming(origins, dests, departure_time, disability_type, max_rounds,
+                                                       callback);
+                 return self.find_routes(origins, dests, departure_time, disability_type, max_rounds); },
+             py::arg("origin_ids"),
+             py::arg("dest_ids"),
+             py::arg("departure_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("access_m") = py::none(),
+             py::arg("on_update") = py::none())
+        .def("resume_routes", &McRaptorEngine::resume_routes,
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("max_rounds"))
+        .def_property_readonly("completed_rounds", &McRaptorEngine::completed_rounds)
+        // 라운드 내 마킹 역 병렬 스캔 스레드 수 (1이면 순차, 결과는 스레드 수와 무관하게 동일)
+        .def_property("parallel_threads", &McRaptorEngine::parallel_threads,
+                      &McRaptorEngine::set_parallel_threads)
+        // reroute 목표 가지치기 (라벨 감소, 평균 편의도/혼잡도 기준이 있는 장애 유형은 순위가 근사)
+        .def_property("target_pruning", &McRaptorEngine::target_pruning,
+                      &McRaptorEngine::set_target_pruning)
+        // 이후 탐색의 강도 (기본값 = 전체 Pareto 탐색, 필드 수정 후 다시 대입해야 반영)
+        .def_property("effort", [](const McRaptorEngine &self)
+                      { return self.effort(); }, &McRaptorEngine::set_effort)
+        .def("reroute", [](McRaptorEngine &self, const std::string &current_cd,
+                           const std::unordered_set<std::string> &dest_cds, double current_time,
+                           const std::string &disability_type, int max_rounds, py::object on_update)
+             {
+                 RouteCallback callback = wrap_route_callback(on_update);
+                 py::gil_scoped_release release;
+                 return self.reroute(current_cd, dest_cds, current_time, disability_type, max_rounds, callback); },
+             py::arg("current_cd"),
+             py::arg("dest_cds"),
+             py::arg("current_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("on_update") = py::none())
+        .def("reroute", [](McRaptorEngine &self, const AccessList &origins,
+                           const std::unordered_set<std::string> &dest_cds, double current_time,
+                           const std::string &disability_type, int max_rounds, py::object on_update)
+             {
+                 std::vector<AccessLeg> legs = to_access_legs(origins);
+                 RouteCallback callback = wrap_route_callback(on_update);
+                 py::gil_scoped_release release;
+                 return self.reroute(legs, dest_cds, current_time, disability_type, max_rounds, callback); },
+             py::arg("origins"),
+             py::arg("dest_cds"),
+             py::arg("current_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("on_update") = py::none())
+        .def("reroute_ids", [](McRaptorEngine &self, const IdArray &origin_ids, const IdArray &dest_ids,
+                               double current_time, const std::string &disability_type, int max_rounds,
+                               const py::object &access_m, const py::object &on_update)
+             {
+                 std::vector<AccessLegId> origins = to_access_ids(origin_ids, access_m);
+                 std::vector<StationID> dests = to_station_ids(dest_ids, "dest_ids");
+                 RouteCallback callback = wrap_route_callback(on_update);
+                 py::gil_scoped_release release;
+                 return self.reroute(origins, dests, current_time, disability_type, max_rounds, callback); },
+             py::arg("origin_ids"),
+             py::arg("dest_ids"),
+             py::arg("current_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("access_m") = py::none(),
+             py::arg("on_update") = py::none())
+        .def("shrink", &McRaptorEngine::shrink)
         .def("rank_routes", &McRaptorEngine::rank_routes)
+        // rank_routes + 경로 재구성 -> RouteSet (스트리밍 콜백의 중간 결과 변환용)
+        .def("route_set", [](McRaptorEngine &self, const std::vector<Label> &routes, const std::string &disability_type)
+             { return self.make_route_set(self.rank_routes(routes, disability_type)); },
+             py::call_guard<py::gil_scoped_release>(),
+             py::arg("routes"),
+             py::arg("disability_type"))
+        // 정수 ID 질의 전체 (탐색/재탐색 -> 라운드 확장 -> 정렬 -> 재구성)를 GIL 해제 상태에서 수행, RouteSet 반환
+        // (Label 목록이 Python을 거치지 않음)
+        .def("find_route_set", [](McRaptorEngine &self, const IdArray &origin_ids, const IdArray &dest_ids,
+                                  double departure_time, const std::string &disability_type, int max_rounds,
+                                  int escalated_rounds, const py::object &access_m, const py::object &on_update,
+                                  bool reroute)
+             {
+                 std::vector<AccessLegId> origins = to_access_ids(origin_ids, access_m);
+                 std::vector<StationID> dests = to_station_ids(dest_ids, "dest_ids");
+                 RouteCallback callback = wrap_route_callback(on_update);
+                 py::gil_scoped_release release;
+                 std::vector<Label> routes;
+                 if (reroute)
+                     routes = self.reroute(origins, dests, departure_time, disability_type, max_rounds, callback);
+                 else if (callback)
+                     routes = self.find_routes_streaming(origins, dests, departure_time, disability_type, max_rounds,
+                                                         callback);
+                 else
+                     routes = self.find_routes(origins, dests, departure_time, disability_type, max_rounds);
+                 routes = self.escalate(std::move(routes), escalated_rounds);
+                 return self.make_route_set(self.rank_routes(routes, disability_type)); },
+             py::arg("origin_ids"),
+             py::arg("dest_ids"),
+             py::arg("departure_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("escalated_rounds") = 0,
+             py::arg("access_m") = py::none(),
+             py::arg("on_update") = py::none(),
+             py::arg("reroute") = false)
+        .def_property_readonly("last_stats", &McRaptorEngine::last_stats)
         .def("reconstruct_route", [](McRaptorEngine &self, const Label &l, const DataContainer &d)
              { return reconstruct_route_wrapper(self, l, d); })
         .def("reconstruct_lines", [](McRaptorEngine &self, const Label &l)
-             { return reconstruct_lines_wrapper(self, l); });
+             { return reconstruct_lines_wrapper(self, l); })
+        // 경로 역 ID 배열 (int32, DataContainer.get_codes로 코드 변환)
+        .def("reconstruct_route_ids", [](McRaptorEngine &self, const Label &l)
+             {
+                 std::vector<PathStop> stops = self.reconstruct_stops(l);
+                 py::array_t<int32_t> ids(static_cast<py::ssize_t>(stops.size()));
+                 int32_t *out = ids.mutable_data();
+                 for (size_t i = 0; i < stops.size(); ++i)
+                     out[i] = static_cast<int32_t>(stops[i].station_id);
+                 return ids; })
+        // 경로 (역 ID, 노선 ID) 배열 (int32, shape (n, 2), 노선 ID는 DataContainer.line_names 색인, 알 수 없으면 -1)
+        .def("reconstruct_stops", [](McRaptorEngine &self, const Label &l)
+             {
+                 std::vector<PathStop> stops = self.reconstruct_stops(l);
+                 py::array_t<int32_t> out({static_cast<py::ssize_t>(stops.size()), static_cast<py::ssize_t>(2)});
+                 int32_t *p = out.mutable_data();
+                 for (const auto &stop : stops)
+                 {
+                     *p++ = static_cast<int32_t>(stop.station_id);
+                     *p++ = stop.line_id;
+                 }
+                 return out; });
+
+    // 네이티브 워커 풀 비동기 탐색 (요청마다 Python 스레드를 점유하지 않음)
+    // 결과: (McRaptorEngine, rank_routes 정렬된 목적지 라벨), 경로 재구성은 반환된 엔진으로 수행
+    py::register_exception<QueryRejected>(m, "QueryRejected", PyExc_RuntimeError);
+
+    py::class_<QueryPoolStats>(m, "QueryPoolStats")
+        .def_readonly("submitted", &QueryPoolStats::submitted)
+        .def_readonly("completed", &QueryPoolStats::completed)
+        .def_readonly("failed", &QueryPoolStats::failed)
+        .def_readonly("rejected", &QueryPoolStats::rejected)
+        .def_readonly("shed", &QueryPoolStats::shed)
+        .def_readonly("cancelled", &QueryPoolStats::cancelled)
+        .def_readonly("queued", &QueryPoolStats::queued)
+        .def_readonly("running", &QueryPoolStats::running)
+        .def_readonly("peak_queued", &QueryPoolStats::peak_queued)
+        .def_readonly("wait_ms_p50", &QueryPoolStats::wait_ms_p50)
+        .def_readonly("wait_ms_p99", &QueryPoolStats::wait_ms_p99)
+        .def_readonly("wait_ms_max", &QueryPoolStats::wait_ms_max)
+        .def_readonly("service_ms_p50", &QueryPoolStats::service_ms_p50)
+        .def_readonly("service_ms_p99", &QueryPoolStats::service_ms_p99)
+        .def_readonly("service_ms_avg", &QueryPoolStats::service_ms_avg)
+        .def_readonly("estimated_wait_ms", &QueryPoolStats::estimated_wait_ms)
+        .def_readonly("effort_level", &QueryPoolStats::effort_level)
+        .def_readonly("effort_counts", &QueryPoolStats::effort_counts)
+        .def("for_priority", [](const QueryPoolStats &self, QueryPriority priority)
+             { return self.classes[static_cast<size_t>(priority)]; },
+             py::arg("priority"));
+
+    py::enum_<QueryPriority>(m, "QueryPriority")
+        .value("HIGH", QueryPriority::HIGH)
+        .value("NORMAL", QueryPriority::NORMAL)
+        .value("LOW", QueryPriority::LOW);
+
+    py::class_<QueryClassStats>(m, "QueryClassStats")
+        .def_readonly("submitted", &QueryClassStats::submitted)
+        .def_readonly("completed", &QueryClassStats::completed)
+        .def_readonly("rejected", &QueryClassStats::rejected)
+        .def_readonly("shed", &QueryClassStats::shed)
+        .def_readonly("preempted", &QueryClassStats::preempted)
+        .def_readonly("queued", &QueryClassStats::queued)
+        .def_readonly("wait_ms_p50", &QueryClassStats::wait_ms_p50)
+        .def_readonly("wait_ms_p99", &QueryClassStats::wait_ms_p99)
+        .def_readonly("service_ms_p50", &QueryClassStats::service_ms_p50)
+        .def_readonly("service_ms_p99", &QueryClassStats::service_ms_p99)
+        .def_readonly("latency_ms_p50", &QueryClassStats::latency_ms_p50)
+        .def_readonly("latency_ms_p99", &QueryClassStats::latency_ms_p99);
+
+    // max_queue / max_wait_ms: 0이면 제한 없음 (AdmissionPolicy 참고)
+    // effort_levels: 부하 적응 탐색 강도 단계 (EffortPolicy, to_effort_policy 참고)
+    py::class_<QueryPool, std::unique_ptr<QueryPool, QueryPoolDeleter>>(m, "QueryPool")
+        .def(py::init([](const DataContainer &data, size_t threads, size_t max_queue, double max_wait_ms,
+                         const EffortLevelList &effort_levels)
+                      { return std::unique_ptr<QueryPool, QueryPoolDeleter>(
+                            new QueryPool(data, threads, AdmissionPolicy{max_queue, max_wait_ms},
+                                          to_effort_policy(effort_levels))); }),
+             py::arg("data"),
+             py::arg("threads") = 0,
+             py::arg("max_queue") = 0,
+             py::arg("max_wait_ms") = 0.0,
+             py::arg("effort_levels") = EffortLevelList(),
+             py::keep_alive<1, 2>())
+        // engine/reroute: 세션에 보관된 엔진으로 재탐색 (완료 전까지 해당 엔진 사용 금지)
+        .def("submit", [](QueryPool &self, const std::string &origin_cd, const std::unordered_set<std::string> &dest_cds,
+                          double departure_time, const std::string &disability_type, int max_rounds, int escalated_rounds,
+                          QueryPriority priority, py::object engine, bool reroute, py::object on_update,
+                          bool route_set)
+             { return submit_query(self, {{{origin_cd, 0.0}}, dest_cds, departure_time, disability_type, max_rounds, escalated_rounds, priority, nullptr, reroute, RouteCallback(), route_set},
+                                   engine, on_update); },
+             py::arg("origin_cd"),
+             py::arg("dest_cds"),
+             py::arg("departure_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("escalated_rounds") = 0,
+             py::arg("priority") = QueryPriority::NORMAL,
+             py::arg("engine") = py::none(),
+             py::arg("reroute") = false,
+             py::arg("on_update") = py::none(),
+             py::arg("route_set") = false)
+        .def("submit", [](QueryPool &self, const AccessList &origins, const std::unordered_set<std::string> &dest_cds,
+                          double departure_time, const std::string &disability_type, int max_rounds, int escalated_rounds,
+                          QueryPriority priority, py::object engine, bool reroute, py::object on_update,
+                          bool route_set)
+             { return submit_query(self, {to_access_legs(origins), dest_cds, departure_time, disability_type, max_rounds, escalated_rounds, priority, nullptr, reroute, RouteCallback(), route_set},
+                                   engine, on_update); },
+             py::arg("origins"),
+             py::arg("dest_cds"),
+             py::arg("departure_time"),
+             py::arg("disability_type"),
+             py::arg("max_rounds"),
+             py::arg("escalated_rounds") = 0,
+             py::arg("priority") = QueryPriority::NORMAL,
+             py::arg("engine") = py::none(),
+             py::arg("reroute") = false,
+             py::arg("on_update") = py::none(),
+             py::arg("route_set") = false)
+        // 실행 중인 이벤트 루프의 asyncio.Future 반환 (루프 밖에서 호출 시 RuntimeError)
+        // await 측 취소는 아직 실행 전인 요청만 건너뜀
+        .def("find_routes_async", [](py::object self, py::args args, py::kwargs kwargs)
+             {
+                 py::object asyncio = py::module_::import("asyncio");
+                 py::object loop = asyncio.attr("get_running_loop")();
+                 return asyncio.attr("wrap_future")(self.attr("submit")(*args, **kwargs), py::arg("loop") = loop); })
+        .def("shutdown", &QueryPool::shutdown, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("thread_count", &QueryPool::thread_count)
+        .def_property_readonly("queued", &QueryPool::queued)
+        .def_property_readonly("running", &QueryPool::running)
+        .def_property_readonly("max_queue", [](const QueryPool &self)
+                               { return self.policy().max_queue; })
+        .def_property_readonly("max_wait_ms", [](const QueryPool &self)
+                               { return self.policy().max_wait_ms; })
+        .def_property_readonly("effort_level_count", [](const QueryPool &self)
+                               { return self.effort_policy().size(); })
+        .def("stats", &QueryPool::stats);
+
+    py::class_<ResultCacheStats>(m, "ResultCacheStats")
+        .def_readonly("hits", &ResultCacheStats::hits)
+        .def_readonly("misses", &ResultCacheStats::misses)
+        .def_readonly("stale", &ResultCacheStats::stale)
+        .def_readonly("inserts", &ResultCacheStats::inserts)
+        .def_readonly("evictions", &ResultCacheStats::evictions)
+        .def_readonly("size", &ResultCacheStats::size)
+        .def_readonly("capacity", &ResultCacheStats::capacity)
+        .def_readonly("bytes", &ResultCacheStats::bytes)
+        .def_readonly("restored", &ResultCacheStats::restored);
+
+    // 프로세스 내 경로 결과 캐시 (값: RouteSet.encode 바이너리 페이로드, decode_route_payload로 복원)
+    // data_version: 결과 계산을 시작할 때 읽은 DataContainer.data_version
+    py::class_<ResultCache>(m, "ResultCache")
+        .def(py::init<const DataContainer &, size_t>(),
+             py::arg("data"),
+             py::arg("capacity"),
+             py::keep_alive<1, 2>())
+        // 없거나 데이터 갱신 이전 항목이면 None
+        .def("get", [](ResultCache &self, const std::string &key) -> py::object
+             {
+                 ResultCache::Payload payload;
+                 {
+                     py::gil_scoped_release release;
+                     payload = self.get(key);
+                 }
+                 if (!payload)
+                     return py::none();
+                 return py::bytes(*payload); }, py::arg("key"))
+        .def("put", [](ResultCache &self, const std::string &key, const py::bytes &payload, uint64_t data_version)
+             { self.put(key, std::string(payload), data_version); },
+             py::arg("key"),
+             py::arg("payload"),
+             py::arg("data_version"))
+        .def("__contains__", &ResultCache::contains, py::call_guard<py::gil_scoped_release>())
+        .def("clear", &ResultCache::clear, py::call_guard<py::gil_scoped_release>())
+        // 현재 데이터 버전 항목을 파일로 저장, 저장한 항목 수
+        .def("save", &ResultCache::save, py::call_guard<py::gil_scoped_release>(), py::arg("path"))
+        // 같은 네트워크/데이터 내용으로 저장된 파일이면 복원한 항목 수, 파일이 없거나 지문이 다르면 0
+        .def("load", &ResultCache::load, py::call_guard<py::gil_scoped_release>(), py::arg("path"))
+        .def("__len__", &ResultCache::size)
+        .def_property_readonly("capacity", &ResultCache::capacity)
+        .def("stats", &ResultCache::stats);
+
+    py::class_<WarmupTarget>(m, "WarmupTarget")
+        .def(py::init([](std::string cache_key, std::string origin, std::string origin_cd,
+                         std::string destination, std::string destination_cd,
+                         std::string disability_type, double weight)
+                      { return WarmupTarget{std::move(cache_key), std::move(origin), std::move(origin_cd),
+                                            std::move(destination), std::move(destination_cd),
+                                            std::move(disability_type), weight}; }),
+             py::arg("cache_key"),
+             py::arg("origin"),
+             py::arg("origin_cd"),
+             py::arg("destination"),
+             py::arg("destination_cd"),
+             py::arg("disability_type"),
+             py::arg("weight") = 1.0)
+        .def_readonly("cache_key", &WarmupTarget::cache_key)
+        .def_readonly("origin_cd", &WarmupTarget::origin_cd)
+        .def_readonly("destination_cd", &WarmupTarget::destination_cd)
+        .def_readonly("disability_type", &WarmupTarget::disability_type)
+        .def_readonly("weight", &WarmupTarget::weight);
+
+    py::class_<WarmupStats>(m, "WarmupStats")
+        .def_readonly("runs", &WarmupStats::runs)
+        .def_readonly("targets", &WarmupStats::targets)
+        .def_readonly("submitted", &WarmupStats::submitted)
+        .def_readonly("completed", &WarmupStats::completed)
+        .def_readonly("cached", &WarmupStats::cached)
+        .def_readonly("failed", &WarmupStats::failed)
+        .def_readonly("running", &WarmupStats::running)
+        .def_readonly("data_version", &WarmupStats::data_version)
+        .def_readonly("last_run_ms", &WarmupStats::last_run_ms);
+
+    // 인기 경로 캐시 예열 (생성 즉시 백그라운드 시작, QueryPool LOW 우선순위)
+    // data_version이 바뀌면 recheck_seconds 이내에 다시 예열
+    py::class_<CacheWarmer, std::unique_ptr<CacheWarmer, CacheWarmerDeleter>>(m, "CacheWarmer")
+        .def(py::init([](QueryPool &pool, const DataContainer &data, ResultCache &cache,
+                         std::vector<WarmupTarget> targets, int max_rounds, int escalated_rounds,
+                         size_t max_in_flight, double recheck_seconds, size_t max_routes)
+                      {
+                          WarmupOptions options{max_rounds, escalated_rounds, max_in_flight, recheck_seconds, max_routes};
+                          return std::unique_ptr<CacheWarmer, CacheWarmerDeleter>(
+                              new CacheWarmer(pool, data, cache, std::move(targets), options)); }),
+             py::arg("pool"),
+             py::arg("data"),
+             py::arg("cache"),
+             py::arg("targets"),
+             py::arg("max_rounds") = WarmupOptions().max_rounds,
+             py::arg("escalated_rounds") = 0,
+             py::arg("max_in_flight") = 0,
+             py::arg("recheck_seconds") = WarmupOptions().recheck_seconds,
+             py::arg("max_routes") = WarmupOptions().max_routes,
+             py::keep_alive<1, 2>(),
+             py::keep_alive<1, 3>(),
+             py::keep_alive<1, 4>())
+        .def("stop", &CacheWarmer::stop, py::call_guard<py::gil_scoped_release>())
+        // 예열 대상 교체 (진행 중인 회차를 중단하고 새 대상으로 다시 예열)
+        .def("set_targets", &CacheWarmer::set_targets, py::arg("targets"),
+             py::call_guard<py::gil_scoped_release>())
+        // 현재 데이터 버전 예열 완료 여부 (timeout 초, None이면 무제한 대기)
+        .def("wait", [](const CacheWarmer &self, py::object timeout)
+             {
+                 double seconds = timeout.is_none() ? -1.0 : timeout.cast<double>();
+                 py::gil_scoped_release release;
+                 return self.wait(seconds); }, py::arg("timeout") = py::none())
+        .def("stats", &CacheWarmer::stats);
+
+    py::class_<CheckpointStats>(m, "CheckpointStats")
+        .def_readonly("saves", &CheckpointStats::saves)
+        .def_readonly("failures", &CheckpointStats::failures)
+        .def_readonly("last_entries", &CheckpointStats::last_entries)
+        .def_readonly("last_save_ms", &CheckpointStats::last_save_ms)
+        .def_readonly("last_error", &CheckpointStats::last_error);
+
+    // 결과 캐시 주기 저장 (생성 즉시 백그라운드 시작, stop 또는 소멸 시 마지막 저장)
+    py::class_<CacheCheckpointer, std::unique_ptr<CacheCheckpointer, CacheCheckpointerDeleter>>(m, "CacheCheckpointer")
+        .def(py::init([](const ResultCache &cache, std::string path, double interval_seconds)
+                      { return std::unique_ptr<CacheCheckpointer, CacheCheckpointerDeleter>(
+                            new CacheCheckpointer(cache, std::move(path), interval_seconds)); }),
+             py::arg("cache"),
+             py::arg("path"),
+             py::arg("interval_seconds") = 300.0,
+             py::keep_alive<1, 2>())
+        .def("stop", &CacheCheckpointer::stop, py::call_guard<py::gil_scoped_release>())
+        .def("checkpoint", &CacheCheckpointer::checkpoint, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("path", &CacheCheckpointer::path)
+        .def("stats", &CacheCheckpointer::stats);
+
+    // 질의 빈도 슬라이딩 창 집계 (count-min sketch + 상위 K)
+    // 기록은 GIL을 쥔 채 수행 (잠금 없는 몇 번의 원자 연산이라 GIL 해제 비용이 더 큼)
+    py::class_<QuerySketch>(m, "QuerySketch")
+        .def(py::init([](const DataContainer &data, size_t width, size_t depth, size_t top_k,
+                         double window_seconds, size_t epochs)
+                      { return new QuerySketch(data, QuerySketchOptions{width, depth, top_k, window_seconds, epochs}); }),
+             py::arg("data"),
+             py::arg("width") = QuerySketchOptions().width,
+             py::arg("depth") = QuerySketchOptions().depth,
+             py::arg("top_k") = QuerySketchOptions().top_k,
+             py::arg("window_seconds") = QuerySketchOptions().window_seconds,
+             py::arg("epochs") = QuerySketchOptions().epochs,
+             py::keep_alive<1, 2>())
+        // 알 수 없는 역 코드면 기록하지 않고 False
+        .def("record", py::overload_cast<const std::string &, const std::string &, const std::string &, double>(&QuerySketch::record),
+             py::arg("origin_cd"),
+             py::arg("destination_cd"),
+             py::arg("disability_type"),
+             py::arg("departure_time"))
+        .def("estimate", [](const QuerySketch &self, const std::string &origin_cd, const std::string &destination_cd,
+                            const std::string &disability_type, int slot) -> uint64_t
+             {
+                 int32_t origin = self.data().find_id(origin_cd);
+                 int32_t destination = self.data().find_id(destination_cd);
+                 if (origin < 0 || destination < 0)
+                     return 0;
+                 return self.estimate(static_cast<StationID>(origin), static_cast<StationID>(destination),
+                                      PathfindingUtils::str_to_disability(disability_type), slot); },
+             py::arg("origin_cd"),
+             py::arg("destination_cd"),
+             py::arg("disability_type"),
+             py::arg("slot"))
+        // [(origin_cd, destination_cd, disability_type, slot, count), ...] 추정 빈도 내림차순
+        .def("top", [](const QuerySketch &self, size_t k)
+             {
+                 static const char *type_names[] = {"PHY", "VIS", "AUD", "ELD"};
+                 std::vector<HeavyHitter> hits;
+                 {
+                     py::gil_scoped_release release;
+                     hits = self.top(k);
+                 }
+                 py::list out;
+                 for (const auto &h : hits)
+                     out.append(py::make_tuple(self.data().get_code(h.origin), self.data().get_code(h.destination),
+                                               type_names[static_cast<size_t>(h.profile)], h.slot, h.count));
+                 return out; }, py::arg("k") = 0)
+        .def_property_readonly("total", &QuerySketch::total)
+        .def("clear", &QuerySketch::clear)
+        .def_static("time_slot", &PathfindingUtils::get_time_slot, py::arg("timestamp"));
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "cache_checkpointer.h"
+#include "data_loader.h"
+#include <algorithm>
+#include <exception>
+
+namespace pathfinding
+{
+    CacheCheckpointer::CacheCheckpointer(const ResultCache &cache, std::string path, double interval_seconds)
+        : cache_(cache), path_(std::move(path)), interval_seconds_(std::max(interval_seconds, 1.0))
+    {
+        // 시작 시점 상태(복원 직후 등)는 이미 파일과 같으므로 저장 대상이 아님
+        saved_changes_ = changes();
+        thread_ = std::thread(&CacheCheckpointer::run, this);
+    }
+
+    CacheCheckpointer::~CacheCheckpointer()
+    {
+        stop();
+    }
+
+    void CacheCheckpointer::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_)
+                return;
+            stopped_ = true;
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (thread_.joinable())
+            thread_.join();
+        save(false);
+    }
+
+    bool CacheCheckpointer::checkpoint()
+    {
+        return save(true);
+    }
+
+    CheckpointStats CacheCheckpointer::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return counters_;
+    }
+
+    uint64_t CacheCheckpointer::changes() const
+    {
+        ResultCacheStats s = cache_.stats();
+        // 추가/복원 횟수와 데이터 버전을 한 값으로 (버전이 바뀌면 저장 대상 항목 집합이 바뀜)
+        return ((s.inserts + s.restored) * 1099511628211ULL) ^ cache_.data().data_version();
+    }
+
+    void CacheCheckpointer::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_)
+        {
+            cv_.wait_for(lock, std::chrono::duration<double>(interval_seconds_), [this]
+                         { return stopping_; });
+            if (stopping_)
+                break;
+            lock.unlock();
+            save(false);
+            lock.lock();
+        }
+    }
+
+    bool CacheCheckpointer::save(bool force)
+    {
+        std::lock_guard<std::mutex> save_lock(save_mutex_);
+        uint64_t current = changes();
+        if (!force && current == saved_changes_)
+            return true;
+
+        Clock::time_point started = Clock::now();
+        try
+        {
+            size_t entries = cache_.save(path_);
+            saved_changes_ = current;
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++counters_.saves;
+            counters_.last_entries = entries;
+            counters_.last_save_ms = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+            counters_.last_error.clear();
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++counters_.failures;
+            counters_.last_error = e.what();
+            return false;
+        }
+    }
+}
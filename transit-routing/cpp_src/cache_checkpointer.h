@@ -0,0 +1,66 @@
+#pragma once
+#include "result_cache.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace pathfinding
+{
+    struct CheckpointStats
+    {
+        uint64_t saves = 0;        // 성공한 저장 횟수
+        uint64_t failures = 0;     // 실패한 저장 횟수 (last_error에 마지막 사유)
+        size_t last_entries = 0;   // 마지막 저장 항목 수
+        double last_save_ms = 0.0;
+        std::string last_error;
+    };
+
+    // ResultCache 주기 저장 (재시작 후 ResultCache::load로 즉시 복원)
+    // - 백그라운드 스레드가 interval_seconds마다 마지막 저장 이후 변경(추가/복원, data_version 변경)이
+    //   있을 때만 저장
+    // - stop()/소멸 시 변경이 있으면 한 번 더 저장 (배포/정상 종료 직전까지의 결과 보존)
+    // - 저장 실패는 통계에만 남기고 다음 주기에 재시도 (요청 처리에는 영향 없음)
+    class CacheCheckpointer
+    {
+    public:
+        // 생성 즉시 주기 저장 시작 (cache는 CacheCheckpointer보다 오래 살아야 함)
+        CacheCheckpointer(const ResultCache &cache, std::string path, double interval_seconds);
+        ~CacheCheckpointer();
+
+        CacheCheckpointer(const CacheCheckpointer &) = delete;
+        CacheCheckpointer &operator=(const CacheCheckpointer &) = delete;
+
+        // 주기 저장 중단 후 마지막 저장 (중복 호출 가능, 두 번째부터는 아무것도 하지 않음)
+        void stop();
+        // 변경 여부와 관계없이 즉시 저장, 성공하면 true
+        bool checkpoint();
+        CheckpointStats stats() const;
+        const std::string &path() const { return path_; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        const ResultCache &cache_;
+        const std::string path_;
+        const double interval_seconds_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_ = false;
+        bool stopped_ = false;
+        CheckpointStats counters_;
+
+        std::mutex save_mutex_; // 주기 저장과 checkpoint() 직렬화
+        uint64_t saved_changes_ = 0; // 마지막 저장 시점의 변경 표식
+
+        std::thread thread_;
+
+        void run();
+        // 변경 표식 (추가 + 복원 횟수, data_version)
+        uint64_t changes() const;
+        bool save(bool force);
+    };
+}
@@ -0,0 +1,200 @@
+#include "cache_warmer.h"
+#include "route_payload.h"
+#include <algorithm>
+
+namespace pathfinding
+{
+    namespace
+    {
+        std::vector<WarmupTarget> by_weight(std::vector<WarmupTarget> targets)
+        {
+            std::stable_sort(targets.begin(), targets.end(), [](const WarmupTarget &a, const WarmupTarget &b)
+                             { return a.weight > b.weight; });
+            return targets;
+        }
+    }
+
+    CacheWarmer::CacheWarmer(QueryPool &pool, const DataContainer &data, ResultCache &cache,
+                             std::vector<WarmupTarget> targets, WarmupOptions options)
+        : pool_(pool), data_(data), cache_(cache), targets_(by_weight(std::move(targets))), options_(options),
+          max_in_flight_(options.max_in_flight > 0 ? options.max_in_flight : std::max<size_t>(pool.thread_count(), 1))
+    {
+        driver_ = std::thread(&CacheWarmer::run, this);
+    }
+
+    CacheWarmer::~CacheWarmer()
+    {
+        stop();
+    }
+
+    void CacheWarmer::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (driver_.joinable())
+            driver_.join();
+    }
+
+    void CacheWarmer::set_targets(std::vector<WarmupTarget> targets)
+    {
+        targets = by_weight(std::move(targets));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_targets_ = std::move(targets);
+            has_pending_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    bool CacheWarmer::wait(double timeout_seconds) const
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto ready = [this]
+        { return stopping_ || (warmed_ && !has_pending_ && warmed_version_ == data_.data_version()); };
+        if (timeout_seconds < 0.0)
+            cv_.wait(lock, ready);
+        else
+            cv_.wait_for(lock, std::chrono::duration<double>(timeout_seconds), ready);
+        return warmed_ && !has_pending_ && warmed_version_ == data_.data_version();
+    }
+
+    WarmupStats CacheWarmer::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        WarmupStats out = counters_;
+        out.targets = targets_.size();
+        return out;
+    }
+
+    void CacheWarmer::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_)
+        {
+            if (has_pending_)
+            {
+                // 진행 중인 회차는 제출한 요청이 모두 끝난 뒤 반환하므로 콜백이 참조하는 대상이 없음
+                targets_ = std::move(pending_targets_);
+                pending_targets_.clear();
+                has_pending_ = false;
+                warmed_ = false;
+            }
+            uint64_t version = data_.data_version();
+            if (!warmed_ || warmed_version_ != version)
+            {
+                lock.unlock();
+                bool complete = warm(version);
+                lock.lock();
+                if (!complete)
+                    continue; // 중단, 대상 교체 또는 회차 도중 데이터 갱신 -> 재시작
+                warmed_ = true;
+                warmed_version_ = version;
+                cv_.notify_all();
+            }
+            cv_.wait_for(lock, std::chrono::duration<double>(options_.recheck_seconds), [this]
+                         { return stopping_ || has_pending_; });
+        }
+        cv_.notify_all();
+    }
+
+    bool CacheWarmer::warm(uint64_t version)
+    {
+        Clock::time_point started = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            counters_.running = true;
+        }
+
+        bool complete = true;
+        for (const auto &target : targets_)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]
+                         { return stopping_ || has_pending_ || in_flight_ < max_in_flight_; });
+                if (stopping_ || has_pending_)
+                {
+                    complete = false;
+                    break;
+                }
+            }
+            if (data_.data_version() != version)
+            {
+                complete = false;
+                break;
+            }
+            if (cache_.contains(target.cache_key))
+                continue;
+            submit(target, version);
+        }
+
+        // 완료 콜백이 this를 참조하므로 중단 시에도 제출한 요청이 모두 끝날 때까지 대기
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]
+                 { return in_flight_ == 0; });
+        counters_.running = false;
+        if (complete)
+        {
+            ++counters_.runs;
+            counters_.data_version = version;
+            counters_.last_run_ms = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+        }
+        return complete;
+    }
+
+    void CacheWarmer::submit(const WarmupTarget &target, uint64_t version)
+    {
+        QueryRequest request;
+        request.origins = {{target.origin_cd, 0.0}};
+        request.dest_cds = {target.destination_cd};
+        request.departure_time = std::chrono::duration<double>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count();
+        request.disability_type = target.disability_type;
+        request.max_rounds = options_.max_rounds;
+        request.escalated_rounds = options_.escalated_rounds;
+        request.priority = QueryPriority::LOW;
+        request.build_route_set = true;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++in_flight_;
+            ++counters_.submitted;
+        }
+
+        // targets_는 제출한 요청이 모두 끝난 뒤에만 교체되므로 target 참조를 콜백에 보관해도 안전
+        pool_.submit(std::move(request), [this, &target, version](QueryResult &&result)
+                     {
+            bool stored = false;
+            if (!result.cancelled && !result.rejected && !result.preempted && result.error.empty() &&
+                result.effort_level == 0 && result.route_set.size() > 0)
+            {
+                try
+                {
+                    RoutePayloadMeta meta{target.origin, target.origin_cd, target.destination,
+                                          target.destination_cd, 0, 0};
+                    cache_.put(target.cache_key,
+                               encode_route_payload(result.route_set, data_, meta, options_.max_routes),
+                               version);
+                    stored = true;
+                }
+                catch (const std::exception &)
+                {
+                    // 직렬화 실패: 해당 대상만 건너뜀
+                }
+            }
+
+            // 잠금을 쥔 채 알림 (대기 측이 깨어나 CacheWarmer를 해제하기 전에 콜백이 끝나도록)
+            std::lock_guard<std::mutex> lock(mutex_);
+            --in_flight_;
+            ++counters_.completed;
+            if (stored)
+                ++counters_.cached;
+            else
+                ++counters_.failed;
+            cv_.notify_all(); });
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "query_pool.h"
+#include "result_cache.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pathfinding
+{
+    // 예열 대상 (인기 출발/도착 쌍 x 장애 유형)
+    // cache_key는 서비스 캐시 키와 같아야 함 (route:cpp:{origin_cd}:{destination_cd}:{disability_type})
+    struct WarmupTarget
+    {
+        std::string cache_key;
+        std::string origin; // 응답용 역 이름
+        std::string origin_cd;
+        std::string destination;
+        std::string destination_cd;
+        std::string disability_type;
+        double weight = 1.0; // 클수록 먼저 계산 (조회 빈도 등)
+    };
+
+    struct WarmupOptions
+    {
+        int max_rounds = 5;
+        int escalated_rounds = 0;
+        size_t max_in_flight = 0;     // 동시에 풀에 넣어 둘 예열 요청 수 (0 = 풀 워커 수)
+        double recheck_seconds = 5.0; // data_version 확인 주기
+        size_t max_routes = 3;        // 캐시에 저장할 상위 경로 수 (서비스 응답과 동일)
+    };
+
+    struct WarmupStats
+    {
+        uint64_t runs = 0;      // 완료된 예열 회차
+        size_t targets = 0;
+        uint64_t submitted = 0; // 풀에 제출한 요청 (이미 최신 캐시 항목이 있는 대상은 제외)
+        uint64_t completed = 0; // 완료 (실패 포함)
+        uint64_t cached = 0;    // 캐시에 저장
+        uint64_t failed = 0;    // 오류/거절/취소 또는 경로 없음
+        bool running = false;   // 예열 회차 진행 중
+        uint64_t data_version = 0; // 마지막으로 완료한 회차의 데이터 버전
+        double last_run_ms = 0.0;
+    };
+
+    // 시작 시 인기 경로 캐시 예열
+    // - 백그라운드 스레드가 대상을 weight 내림차순으로 QueryPool에 LOW 우선순위로 제출
+    //   (HIGH/NORMAL 대기 작업이 없을 때만 워커가 꺼내므로 실제 요청을 늦추지 않음)
+    // - 풀에 넣어 두는 요청 수를 max_in_flight로 제한해 LOW 대기열이 쌓이지 않게 하고,
+    //   완료 콜백(워커 스레드)에서 RouteSet을 바이너리 페이로드로 직렬화해 ResultCache에 저장
+    // - recheck_seconds마다 DataContainer::data_version을 확인해 바뀌면 전체 대상을 다시 계산
+    //   (회차 도중 바뀌면 남은 제출을 중단하고 새 버전으로 재시작)
+    // - 부하로 탐색 강도가 낮아진 결과/경로 없음은 저장하지 않음 (서비스 캐싱 규칙과 동일)
+    //   HIGH 작업에 양보해 라운드 중간에 끝난(preempted) 결과도 저장하지 않음
+    // - set_targets로 대상 교체 시 진행 중인 회차를 중단하고 새 대상으로 회차 재시작
+    class CacheWarmer
+    {
+    public:
+        // 생성 즉시 백그라운드 예열 시작 (pool/data/cache는 CacheWarmer보다 오래 살아야 함)
+        CacheWarmer(QueryPool &pool, const DataContainer &data, ResultCache &cache,
+                    std::vector<WarmupTarget> targets, WarmupOptions options = WarmupOptions());
+        ~CacheWarmer();
+
+        CacheWarmer(const CacheWarmer &) = delete;
+        CacheWarmer &operator=(const CacheWarmer &) = delete;
+
+        // 제출 중단 후 이미 제출한 요청 완료까지 대기 (중복 호출 가능)
+        void stop();
+        // 예열 대상 교체 (질의 집계 상위 항목 갱신 등), 최신 캐시 항목이 있는 대상은 다시 계산하지 않음
+        void set_targets(std::vector<WarmupTarget> targets);
+        // 현재 데이터 버전의 예열 회차가 끝날 때까지 대기 (timeout_seconds < 0 이면 무제한)
+        // 완료되었으면 true
+        bool wait(double timeout_seconds) const;
+        WarmupStats stats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        QueryPool &pool_;
+        const DataContainer &data_;
+        ResultCache &cache_;
+        std::vector<WarmupTarget> targets_; // weight 내림차순, 구동 스레드가 회차 사이에만 교체
+        const WarmupOptions options_;
+        const size_t max_in_flight_;
+
+        mutable std::mutex mutex_;
+        mutable std::condition_variable cv_; // 완료/중단/회차 종료 알림
+        bool stopping_ = false;
+        bool has_pending_ = false; // set_targets로 받은 대상 대기 중
+        std::vector<WarmupTarget> pending_targets_;
+        bool warmed_ = false; // warmed_version_ 회차 완료 여부
+        uint64_t warmed_version_ = 0;
+        size_t in_flight_ = 0;
+        WarmupStats counters_;
+
+        std::thread driver_;
+
+        void run();
+        // 한 회차 (data_version 변경 또는 중단 시 남은 대상 제출 생략), 제출한 요청 완료까지 대기
+        // 모든 대상을 제출했으면 true
+        bool warm(uint64_t version);
+        void submit(const WarmupTarget &target, uint64_t version);
+    };
+}
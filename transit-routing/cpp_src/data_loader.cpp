@@ -1,55 +1,182 @@
 #include "data_loader.h"
+#include "spatial_index.h"
+#include "distance_kernels.h"
 #include "utils.h"
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <mutex>
 #include <iostream>
 
 namespace pathfinding
 {
+    namespace
+    {
+        // {(station_cd, line, direction, day): {"t_0": v, ...}} -> SnapshotCongestion 목록
+        std::vector<SnapshotCongestion> congestion_from_python(const py::dict &congestion_dict)
+        {
+            std::vector<SnapshotCongestion> rows;
+            rows.reserve(congestion_dict.size());
+            for (auto item : congestion_dict)
+            {
+                py::tuple key = item.first.cast<py::tuple>();
+                SnapshotCongestion c;
+                c.station_cd = py::str(key[0]);
+                c.line = py::str(key[1]);
+                c.direction = py::str(key[2]);
+                c.day = py::str(key[3]);
+
+                py::dict slots = item.second.cast<py::dict>();
+                for (auto slot : slots)
+                    c.slots.emplace_back(py::str(slot.first), slot.second.cast<double>());
+                rows.push_back(std::move(c));
+            }
+            return rows;
+        }
+
+        // max_digits자리 이하 십진수 코드의 숫자값, 아니면 -1
+        int64_t numeric_code(const std::string &cd, size_t max_digits)
+        {
+            if (cd.empty() || cd.size() > max_digits)
+                return -1;
+            int64_t value = 0;
+            for (char ch : cd)
+            {
+                if (ch < '0' || ch > '9')
+                    return -1;
+                value = value * 10 + (ch - '0');
+            }
+            return value;
+        }
+
+        // FNV-1a 64 (network_fingerprint와 같은 상수)
+        struct Fnv
+        {
+            uint64_t hash = 14695981039346656037ULL;
+
+            void bytes(const void *data, size_t size)
+            {
+                const unsigned char *p = static_cast<const unsigned char *>(data);
+                for (size_t i = 0; i < size; ++i)
+                    hash = (hash ^ p[i]) * 1099511628211ULL;
+            }
+            template <typename T>
+            void value(T v) { bytes(&v, sizeof(v)); }
+            void str(const std::string &s)
+            {
+                bytes(s.data(), s.size());
+                hash *= 1099511628211ULL; // NUL 구분자
+            }
+            void ids(const std::vector<StationID> &v)
+            {
+                value(static_cast<uint64_t>(v.size()));
+                bytes(v.data(), v.size() * sizeof(StationID));
+            }
+        };
+    }
+
     void DataContainer::load_from_python(
         const py::dict &stations_dict, const py::dict &line_stations_dict,
         const py::dict &station_order_dict, const py::dict &transfers_dict,
-        const py::dict &congestion_dict)
+        const py::dict &congestion_dict, double footpath_minutes)
+    {
+        // Python dict -> NetworkSnapshot 변환 후 공통 적재 경로 사용
+        NetworkSnapshot snap;
+
+        // 1. Stations
+        snap.stations.reserve(stations_dict.size());
+        for (auto item : stations_dict)
+        {
+            py::dict info = item.second.cast<py::dict>();
+            SnapshotStation s;
+            s.station_cd = py::str(item.first);
+            s.name = py::str(info["name"]);
+            s.line = py::str(info["line"]);
+            s.latitude = info["latitude"].cast<double>();
+            s.longitude = info["longitude"].cast<double>();
+            snap.stations.push_back(std::move(s));
+        }
+
+        // 2. Station Order (중간역 복원용)
+        for (auto item : station_order_dict)
+        {
+            py::tuple key = item.first.cast<py::tuple>();
+            snap.orders.push_back({py::str(key[0]), py::str(key[1]), item.second.cast<int>()});
+        }
+
+        // 3. Line Topology
+        for (auto item : line_stations_dict)
+        {
+            py::tuple key = item.first.cast<py::tuple>();
+            py::dict dirs = item.second.cast<py::dict>();
+
+            SnapshotTopology t;
+            t.station_cd = py::str(key[0]);
+            t.line = py::str(key[1]);
+
+            auto read_dir = [&dirs](const char *name, std::vector<std::string> &out)
+            {
+                if (!dirs.contains(name))
+                    return;
+                for (auto n : dirs[name].cast<py::list>())
+                    out.push_back(py::str(n));
+            };
+            read_dir("up", t.up);
+            read_dir("down", t.down);
+            // 순환선 내외선 처리 추가
+            read_dir("in", t.in);
+            read_dir("out", t.out);
+            snap.topology.push_back(std::move(t));
+        }
+
+        // 4. Transfers
+        for (auto item : transfers_dict)
+        {
+            py::tuple key = item.first.cast<py::tuple>();
+            py::dict val = item.second.cast<py::dict>();
+            snap.transfers.push_back({py::str(key[0]), py::str(key[1]), py::str(key[2]),
+                                      val["distance"].cast<double>()});
+        }
+
+        // 5. Congestion
+        snap.congestion = congestion_from_python(congestion_dict);
+
+        load_snapshot(snap, footpath_minutes);
+    }
+
+    void DataContainer::load_snapshot(const NetworkSnapshot &snap, double footpath_minutes)
     {
         // 1. Stations 로드
-        size_t count = stations_dict.size();
+        size_t count = snap.stations.size();
         stations_.reserve(count);
         id_to_code_.reserve(count);
         station_lines_.resize(count);
         station_scores_.assign(count, {0.0, 0.0, 0.0, 0.0});
 
         StationID current_id = 0;
-        for (auto item : stations_dict)
+        for (const auto &src : snap.stations)
         {
-            std::string cd = py::str(item.first);
+            const std::string &cd = src.station_cd;
             if (code_to_id_.find(cd) == code_to_id_.end())
             {
                 code_to_id_[cd] = current_id;
                 id_to_code_.push_back(cd);
 
-                py::dict info = item.second.cast<py::dict>();
                 StationInfo s;
                 s.id = current_id;
                 s.station_cd = cd;
-                s.name = py::str(info["name"]);
-                s.line = py::str(info["line"]);
-                s.latitude = info["latitude"].cast<double>();
-                s.longitude = info["longitude"].cast<double>();
+                s.name = src.name;
+                s.line = src.line;
+                s.latitude = src.latitude;
+                s.longitude = src.longitude;
 
                 stations_.push_back(s);
                 current_id++;
             }
         }
 
-        // Station Lines 구축 => 이름이 같으면 모든 노선을 다 넣어버림
-        // for (const auto &s : stations_)
-        // {
-        //     for (const auto &t : stations_)
-        //     {
-        //         if (s.name == t.name)
-        //             station_lines_[s.id].push_back(t.line);
-        //     }
-        // }
+        build_code_table();
+
         // 자기 자신의 노선만 등록 (환승은 transfers_ 맵을 통해서만 이동)
         for (const auto &s : stations_)
         {
@@ -57,18 +184,12 @@ namespace pathfinding
         }
 
         // 2. Station Order (중간역 복원용)
-        for (auto item : station_order_dict)
+        for (const auto &o : snap.orders)
         {
-            py::tuple key = item.first.cast<py::tuple>();
-            std::string cd = py::str(key[0]);
-            std::string line = py::str(key[1]);
-            int order = item.second.cast<int>();
-
-            if (code_to_id_.find(cd) != code_to_id_.end())
+            auto it = code_to_id_.find(o.station_cd);
+            if (it != code_to_id_.end())
             {
-                StationID sid = code_to_id_[cd];
-                station_orders_[{sid, line}] = order;
-                line_ordered_stations_[line].push_back({order, sid});
+                line_ordered_stations_[o.line].push_back({o.order, it->second});
             }
         }
         for (auto &kv : line_ordered_stations_)
@@ -76,125 +197,90 @@ namespace pathfinding
             std::sort(kv.second.begin(), kv.second.end());
         }
 
-        // 3. Line Topology
-        for (auto item : line_stations_dict)
+        // 노선 ID (역 소속 노선 + 순서 데이터 노선, 이름순)
+        std::vector<std::string> lines;
+        for (const auto &s : stations_)
+            lines.push_back(s.line);
+        for (const auto &kv : line_ordered_stations_)
+            lines.push_back(kv.first);
+        std::sort(lines.begin(), lines.end());
+        lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+        line_names_ = std::move(lines);
+        line_ids_.clear();
+        for (size_t i = 0; i < line_names_.size(); ++i)
+            line_ids_[line_names_[i]] = static_cast<LineID>(i);
+        build_line_positions();
+
+        // ID 체계 지문 (역 코드 ID 순 + 노선명 ID 순, 구분자 NUL)
+        uint64_t fingerprint = 14695981039346656037ULL;
+        auto mix = [&fingerprint](const std::string &s)
         {
-            py::tuple key = item.first.cast<py::tuple>();
-            std::string cd = py::str(key[0]);
-            std::string line = py::str(key[1]);
-
-            if (code_to_id_.find(cd) == code_to_id_.end())
-                continue;
-            StationID sid = code_to_id_[cd];
-
-            py::dict dirs = item.second.cast<py::dict>();
-            DirectionLines dl;
-            if (dirs.contains("up"))
-            {
-                for (auto n : dirs["up"].cast<py::list>())
-                {
-                    std::string n_cd = py::str(n);
-                    if (code_to_id_.count(n_cd))
-                        dl.up.push_back(code_to_id_[n_cd]);
-                }
-            }
-            if (dirs.contains("down"))
-            {
-                for (auto n : dirs["down"].cast<py::list>())
-                {
-                    std::string n_cd = py::str(n);
-                    if (code_to_id_.count(n_cd))
-                        dl.down.push_back(code_to_id_[n_cd]);
-                }
-            }
-            // 순환선 내외선 처리 추가
-            if (dirs.contains("in"))
-            {
-                for (auto n : dirs["in"].cast<py::list>())
-                {
-                    std::string n_cd = py::str(n);
-                    if (code_to_id_.count(n_cd))
-                        dl.in.push_back(code_to_id_[n_cd]);
-                }
-            }
-            if (dirs.contains("out"))
-            {
-                for (auto n : dirs["out"].cast<py::list>())
-                {
-                    std::string n_cd = py::str(n);
-                    if (code_to_id_.count(n_cd))
-                        dl.out.push_back(code_to_id_[n_cd]);
-                }
-            }
-            line_topology_[{sid, line}] = dl;
-        }
+            for (unsigned char c : s)
+                fingerprint = (fingerprint ^ c) * 1099511628211ULL;
+            fingerprint *= 1099511628211ULL; // NUL 구분자
+        };
+        for (const auto &cd : id_to_code_)
+            mix(cd);
+        mix("");
+        for (const auto &line : line_names_)
+            mix(line);
+        network_fingerprint_ = fingerprint;
+        bump_data_version();
 
-        // 1. 역 이름 정규화 람다 함수 (Python 로직과 동일하게 맞춤)
-        auto normalize_name = [](std::string name) -> std::string
+        // 3. Line Topology
+        auto to_ids = [this](const std::vector<std::string> &cds, std::vector<StationID> &out)
         {
-            // 1. 괄호 '(' 제거 (예: "서울역(1호선)" -> "서울역")
-            size_t paren_pos = name.find('(');
-            if (paren_pos != std::string::npos)
-            {
-                name = name.substr(0, paren_pos);
-            }
-
-            // 2. "역" 글자 제거 (UTF-8에서 "역"은 3바이트: 0xEC, 0x97, 0xAD)
-            // 단순하게 끝이 "역"으로 끝나면 제거
-            std::string suffix = "역";
-            if (name.length() >= suffix.length())
+            for (const auto &n_cd : cds)
             {
-                if (name.compare(name.length() - suffix.length(), suffix.length(), suffix) == 0)
-                {
-                    name = name.substr(0, name.length() - suffix.length());
-                }
+                auto it = code_to_id_.find(n_cd);
+                if (it != code_to_id_.end())
+                    out.push_back(it->second);
             }
-
-            // 3. 앞뒤 공백 제거 (간단 구현)
-            const char *ws = " \t\n\r\f\v";
-            name.erase(name.find_last_not_of(ws) + 1);
-            name.erase(0, name.find_first_not_of(ws));
-
-            return name;
         };
+        for (const auto &t : snap.topology)
+        {
+            auto it = code_to_id_.find(t.station_cd);
+            if (it == code_to_id_.end())
+                continue;
+
+            DirectionLines dl;
+            to_ids(t.up, dl.up);
+            to_ids(t.down, dl.down);
+            to_ids(t.in, dl.in);
+            to_ids(t.out, dl.out);
+            line_topology_[{it->second, t.line}] = dl;
+        }
 
         // 4. Transfers (거리 + 환승역 정보)
         std::unordered_map<std::string, std::vector<StationID>> name_to_ids;
         for (const auto &s : stations_)
         {
-            std::string norm_name = normalize_name(s.name);
-            name_to_ids[norm_name].push_back(s.id);
+            name_to_ids[PathfindingUtils::normalize_station_name(s.name)].push_back(s.id);
         }
 
         int linked_count = 0; // 디버깅용 카운터
-        for (auto item : transfers_dict)
+        for (const auto &x : snap.transfers)
         {
-            py::tuple key = item.first.cast<py::tuple>();
-            std::string from_cd = py::str(key[0]);
-
-            if (code_to_id_.find(from_cd) == code_to_id_.end())
+            auto it = code_to_id_.find(x.station_cd);
+            if (it == code_to_id_.end())
                 continue;
 
-            StationID from_sid = code_to_id_[from_cd];
-            std::string f_line = py::str(key[1]);
-            std::string t_line = py::str(key[2]);
-
-            py::dict val = item.second.cast<py::dict>();
+            StationID from_sid = it->second;
 
             TransferData td;
-            td.distance = val["distance"].cast<double>();
+            td.distance = x.distance;
 
             // [Step B] 목적지 역 ID(to_station_id) 찾기
             bool target_found = false;
 
             // 현재 역 이름을 정규화해서 검색
-            std::string current_norm_name = normalize_name(stations_[from_sid].name);
+            std::string current_norm_name = PathfindingUtils::normalize_station_name(stations_[from_sid].name);
 
             if (name_to_ids.find(current_norm_name) != name_to_ids.end())
             {
                 for (StationID candidate_id : name_to_ids[current_norm_name])
                 {
-                    if (stations_[candidate_id].line == t_line)
+                    if (stations_[candidate_id].line == x.to_line)
                     {
                         td.to_station_id = candidate_id;
                         target_found = true;
@@ -205,43 +291,322 @@ namespace pathfinding
 
             if (target_found)
             {
-                transfers_[{from_sid, f_line, t_line}] = td;
+                transfers_[{from_sid, x.from_line, x.to_line}] = td;
                 linked_count++;
 
                 // 환승 가능 라인 기록
-                transfer_adjacency_[from_sid].push_back(t_line);
+                transfer_adjacency_[from_sid].push_back(x.to_line);
             }
         }
 
         std::cout << "[C++] Transfer Links Created: " << linked_count << std::endl;
 
         // 5. Congestion
-        for (auto item : congestion_dict)
+        for (const auto &c : snap.congestion)
+            merge_congestion(c);
+
+        // 6. 편의시설 점수 (스냅샷에 계산된 값이 있는 경우)
+        for (const auto &fc : snap.facilities)
+            set_facility_scores(fc);
+
+        // 7. 도보 연결 (좌표에서 파생, 스냅샷에는 저장하지 않음)
+        build_footpaths(footpath_minutes);
+
+        // 8. 거리 행렬 (스냅샷에 같은 역 집합의 행렬이 있으면 재사용, 없으면 계산)
+        if (!snap.distance_matrix.empty() && snap.stations.size() == stations_.size() &&
+            snap.distance_matrix.size() == stations_.size() * stations_.size())
+            distance_matrix_ = std::make_shared<const std::vector<float>>(snap.distance_matrix);
+        else
+            build_distance_matrix();
+    }
+
+    void DataContainer::build_distance_matrix()
+    {
+        std::shared_ptr<const std::vector<float>> result;
         {
-            py::tuple key = item.first.cast<py::tuple>();
-            std::string cd = py::str(key[0]);
-            if (code_to_id_.find(cd) == code_to_id_.end())
-                continue;
+            std::shared_lock<std::shared_mutex> lock(update_mutex);
+            size_t n = stations_.size();
+            if (n > 0 && n <= DENSE_MATRIX_MAX_STATIONS)
+            {
+                std::vector<double> lats(n), lons(n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    lats[i] = stations_[i].latitude;
+                    lons[i] = stations_[i].longitude;
+                }
+                // 단위 벡터 변환 1회, 행마다 벡터화 커널
+                DistanceKernels::UnitPoints unit = DistanceKernels::to_unit(lats.data(), lons.data(), n);
+                std::vector<double> row(n);
+                std::vector<float> matrix(n * n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    DistanceKernels::haversine_one_to_many(lats[i], lons[i], unit, row.data());
+                    std::copy(row.begin(), row.end(), matrix.begin() + i * n);
+                }
+                result = std::make_shared<const std::vector<float>>(std::move(matrix));
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(update_mutex);
+        distance_matrix_ = std::move(result);
+    }
+
+    std::shared_ptr<const std::vector<float>> DataContainer::distance_matrix() const
+    {
+        std::shared_lock<std::shared_mutex> lock(update_mutex);
+        return distance_matrix_;
+    }
+
+    double DataContainer::station_distance(StationID a, StationID b) const
+    {
+        size_t n = stations_.size();
+        if (a >= n || b >= n)
+            throw std::runtime_error("Invalid station ID");
+        if (distance_matrix_)
+            return (*distance_matrix_)[static_cast<size_t>(a) * n + b];
+        return PathfindingUtils::haversine(stations_[a].latitude, stations_[a].longitude,
+                                           stations_[b].latitude, stations_[b].longitude);
+    }
 
-            StationID sid = code_to_id_[cd];
-            std::string line = py::str(key[1]);
-            std::string dir_str = py::str(key[2]);
-            std::string day = py::str(key[3]);
-            Direction dir = PathfindingUtils::str_to_direction(dir_str);
+    void DataContainer::build_footpaths(double max_walk_minutes)
+    {
+        constexpr size_t TYPE_COUNT = static_cast<size_t>(DisabilityType::COUNT);
+        const char *type_names[TYPE_COUNT] = {"PHY", "VIS", "AUD", "ELD"};
 
-            py::dict slots = item.second.cast<py::dict>();
-            std::unordered_map<std::string, double> slot_map;
-            for (auto slot : slots)
+        std::vector<uint32_t> start(1, 0);
+        std::vector<Footpath> paths;
+        if (max_walk_minutes > 0.0)
+        {
+            // 장애 유형별 보행 속도 -> 허용 도보 반경, 격자 조회는 가장 넓은 반경으로 1회
+            std::array<double, TYPE_COUNT> speed{};
+            double radius_m = 0.0;
+            for (size_t t = 0; t < TYPE_COUNT; ++t)
             {
-                slot_map[py::str(slot.first)] = slot.second.cast<double>();
+                speed[t] = PathfindingUtils::get_walking_speed(type_names[t]);
+                radius_m = std::max(radius_m, max_walk_minutes * 60.0 * speed[t]);
             }
-            congestion_[{sid, line, dir, day}] = slot_map;
+
+            // 역당 반경 조회 1회, 조회마다 반경에 걸친 격자 셀만 검사 (역 수에 거의 선형)
+            SpatialIndex index(*this);
+            std::shared_lock<std::shared_mutex> lock(update_mutex);
+            std::vector<std::string> norm_names;
+            norm_names.reserve(stations_.size());
+            for (const auto &s : stations_)
+                norm_names.push_back(PathfindingUtils::normalize_station_name(s.name));
+
+            start.reserve(stations_.size() + 1);
+            for (const auto &from : stations_)
+            {
+                // 좌표 누락 역은 인덱스에서도 제외됨 (격자 밖 질의의 전체 순회 방지)
+                bool located = !(from.latitude == 0.0 && from.longitude == 0.0) &&
+                               std::isfinite(from.latitude) && std::isfinite(from.longitude);
+                std::vector<SpatialIndex::Hit> hits;
+                if (located)
+                    hits = index.within(from.latitude, from.longitude, radius_m);
+                for (const auto &hit : hits)
+                {
+                    const StationInfo &to = stations_[hit.id];
+                    // 같은 이름(환승 데이터로 연결) / 같은 노선(열차로 이동) 제외
+                    if (hit.id == from.id || to.line == from.line || norm_names[hit.id] == norm_names[from.id])
+                        continue;
+                    Footpath fp;
+                    fp.to_station_id = hit.id;
+                    fp.distance = hit.distance;
+                    for (size_t t = 0; t < TYPE_COUNT; ++t)
+                    {
+                        double minutes = hit.distance / (speed[t] * 60.0);
+                        fp.minutes[t] = minutes <= max_walk_minutes ? minutes : std::numeric_limits<double>::infinity();
+                    }
+                    paths.push_back(fp);
+                }
+                start.push_back(static_cast<uint32_t>(paths.size()));
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(update_mutex);
+        footpath_start_ = std::move(start);
+        footpaths_ = std::move(paths);
+        bump_data_version();
+    }
+
+    void DataContainer::merge_congestion(const SnapshotCongestion &c)
+    {
+        auto it = code_to_id_.find(c.station_cd);
+        if (it == code_to_id_.end())
+            return;
+
+        Direction dir = PathfindingUtils::str_to_direction(c.direction);
+        auto &slot_map = congestion_[{it->second, c.line, dir, c.day}];
+        for (const auto &slot : c.slots)
+        {
+            slot_map[slot.first] = slot.second;
         }
     }
 
+    void DataContainer::set_facility_scores(const SnapshotFacility &fc)
+    {
+        auto it = code_to_id_.find(fc.station_cd);
+        if (it != code_to_id_.end())
+            station_scores_[it->second] = fc.scores;
+    }
+
+    NetworkSnapshot DataContainer::to_snapshot() const
+    {
+        std::shared_lock<std::shared_mutex> lock(update_mutex);
+        NetworkSnapshot snap;
+
+        for (const auto &s : stations_)
+            snap.stations.push_back({s.station_cd, s.name, s.line, s.latitude, s.longitude});
+
+        for (const auto &kv : line_ordered_stations_)
+            for (const auto &p : kv.second)
+                snap.orders.push_back({id_to_code_[p.second], kv.first, p.first});
+
+        auto to_codes = [this](const std::vector<StationID> &ids)
+        {
+            std::vector<std::string> out;
+            out.reserve(ids.size());
+            for (StationID id : ids)
+                out.push_back(id_to_code_[id]);
+            return out;
+        };
+        for (const auto &kv : line_topology_)
+            snap.topology.push_back({id_to_code_[kv.first.sid], kv.first.line, to_codes(kv.second.up),
+                                     to_codes(kv.second.down), to_codes(kv.second.in), to_codes(kv.second.out)});
+
+        // 이름 매칭에 성공한 환승만 남아 있음 (재적재 시 동일한 결과)
+        for (const auto &kv : transfers_)
+            snap.transfers.push_back({id_to_code_[kv.first.sid], kv.first.f_line, kv.first.t_line, kv.second.distance});
+
+        for (const auto &kv : congestion_)
+        {
+            SnapshotCongestion c{id_to_code_[kv.first.sid], kv.first.line,
+                                 PathfindingUtils::direction_to_str(kv.first.dir), kv.first.day, {}};
+            c.slots.assign(kv.second.begin(), kv.second.end());
+            std::sort(c.slots.begin(), c.slots.end());
+            snap.congestion.push_back(std::move(c));
+        }
+
+        for (size_t i = 0; i < station_scores_.size(); ++i)
+            snap.facilities.push_back({id_to_code_[i], station_scores_[i]});
+
+        if (distance_matrix_)
+            snap.distance_matrix = *distance_matrix_;
+        return snap;
+    }
+
+    uint64_t DataContainer::content_fingerprint(uint64_t *version) const
+    {
+        std::shared_lock<std::shared_mutex> lock(update_mutex);
+        const uint64_t current = data_version();
+        if (version)
+            *version = current;
+        {
+            std::lock_guard<std::mutex> guard(content_fingerprint_mutex_);
+            if (content_fingerprint_version_ == current)
+                return content_fingerprint_;
+        }
+
+        Fnv all;
+        all.value(network_fingerprint_);
+        for (const auto &s : stations_)
+        {
+            all.str(s.station_cd);
+            all.str(s.name);
+            all.str(s.line);
+            all.value(s.latitude);
+            all.value(s.longitude);
+        }
+
+        // 해시 맵은 항목 해시의 합으로 묶음 (순회 순서와 무관)
+        auto section = [&all](uint64_t sum, size_t count)
+        {
+            all.value(sum);
+            all.value(static_cast<uint64_t>(count));
+        };
+
+        uint64_t sum = 0;
+        for (const auto &kv : line_ordered_stations_)
+        {
+            Fnv e;
+            e.str(kv.first);
+            for (const auto &p : kv.second)
+            {
+                e.value(p.first);
+                e.value(p.second);
+            }
+            sum += e.hash;
+        }
+        section(sum, line_ordered_stations_.size());
+
+        sum = 0;
+        for (const auto &kv : line_topology_)
+        {
+            Fnv e;
+            e.value(kv.first.sid);
+            e.str(kv.first.line);
+            e.ids(kv.second.up);
+            e.ids(kv.second.down);
+            e.ids(kv.second.in);
+            e.ids(kv.second.out);
+            sum += e.hash;
+        }
+        section(sum, line_topology_.size());
+
+        sum = 0;
+        for (const auto &kv : transfers_)
+        {
+            Fnv e;
+            e.value(kv.first.sid);
+            e.str(kv.first.f_line);
+            e.str(kv.first.t_line);
+            e.value(kv.second.distance);
+            e.value(kv.second.to_station_id);
+            sum += e.hash;
+        }
+        section(sum, transfers_.size());
+
+        sum = 0;
+        for (const auto &kv : congestion_)
+        {
+            uint64_t slots = 0;
+            for (const auto &slot : kv.second)
+            {
+                Fnv e;
+                e.str(slot.first);
+                e.value(slot.second);
+                slots += e.hash;
+            }
+            Fnv e;
+            e.value(kv.first.sid);
+            e.str(kv.first.line);
+            e.value(static_cast<int>(kv.first.dir));
+            e.str(kv.first.day);
+            e.value(slots);
+            sum += e.hash;
+        }
+        section(sum, congestion_.size());
+
+        for (const auto &scores : station_scores_)
+            all.bytes(scores.data(), scores.size() * sizeof(double));
+        all.bytes(footpath_start_.data(), footpath_start_.size() * sizeof(uint32_t));
+        for (const auto &fp : footpaths_)
+        {
+            all.value(fp.to_station_id);
+            all.value(fp.distance);
+            all.bytes(fp.minutes.data(), fp.minutes.size() * sizeof(double));
+        }
+
+        std::lock_guard<std::mutex> guard(content_fingerprint_mutex_);
+        content_fingerprint_ = all.hash;
+        content_fingerprint_version_ = current;
+        return all.hash;
+    }
+
     void DataContainer::update_facility_scores(const py::list &facility_rows)
     {
-        std::unique_lock<std::shared_mutex> lock(update_mutex);
+        // Python 객체 변환/점수 계산은 잠금 밖에서 수행 (쓰기 잠금 보유 시간 최소화)
+        std::vector<SnapshotFacility> updates;
 
         for (auto &row_obj : facility_rows)
         {
@@ -273,70 +638,170 @@ namespace pathfinding
 
             for (auto &cd_obj : cd_list)
             {
-                std::string cd = py::str(cd_obj);
-                auto it = code_to_id_.find(cd);
-                if (it != code_to_id_.end())
-                {
-                    station_scores_[it->second] = calc_scores;
-                }
+                updates.push_back({py::str(cd_obj), calc_scores});
             }
         }
+
+        // 쓰기 잠금 대기 중에는 GIL 해제 (읽기 잠금을 쥔 탐색이 진행 콜백에서 GIL을 기다리면 교착)
+        py::gil_scoped_release release;
+        apply_facility_scores(updates);
     }
 
-    std::vector<StationID> DataContainer::get_intermediate_stations(
-        StationID from_id, StationID to_id, const std::string &line) const
+    void DataContainer::update_congestion(const py::dict &congestion_dict)
     {
-        std::vector<StationID> result;
-        auto it_from = station_orders_.find({from_id, line});
-        auto it_to = station_orders_.find({to_id, line});
+        std::vector<SnapshotCongestion> updates = congestion_from_python(congestion_dict);
+        py::gil_scoped_release release;
+        apply_congestion(updates);
+    }
 
-        if (it_from == station_orders_.end() || it_to == station_orders_.end())
-        {
-            result.push_back(to_id);
-            return result;
-        }
+    void DataContainer::apply_facility_scores(const std::vector<SnapshotFacility> &updates)
+    {
+        std::unique_lock<std::shared_mutex> lock(update_mutex);
+        for (const auto &fc : updates)
+            set_facility_scores(fc);
+        bump_data_version();
+    }
 
-        int from_order = it_from->second;
-        int to_order = it_to->second;
-        bool ascending = from_order < to_order;
+    void DataContainer::apply_congestion(const std::vector<SnapshotCongestion> &updates)
+    {
+        std::unique_lock<std::shared_mutex> lock(update_mutex);
+        for (const auto &c : updates)
+            merge_congestion(c);
+        bump_data_version();
+    }
 
-        auto it_list = line_ordered_stations_.find(line);
-        if (it_list == line_ordered_stations_.end())
+    void DataContainer::build_line_positions()
+    {
+        line_order_stations_.assign(line_names_.size(), {});
+        station_line_positions_.assign(stations_.size(), {});
+        for (const auto &kv : line_ordered_stations_)
         {
-            result.push_back(to_id);
-            return result;
-        }
-        const auto &list = it_list->second;
+            LineID line = line_ids_.at(kv.first);
+            const auto &list = kv.second; // 순서순 정렬됨
+            auto &stations = line_order_stations_[line];
+            stations.reserve(list.size());
+            for (const auto &p : list)
+                stations.push_back(p.second);
 
-        if (ascending)
-        {
             for (const auto &p : list)
             {
-                if (p.first > from_order && p.first <= to_order)
-                    result.push_back(p.second);
+                auto lower = std::lower_bound(list.begin(), list.end(), std::make_pair(p.first, StationID(0)));
+                auto upper = std::upper_bound(list.begin(), list.end(), p.first,
+                                              [](int order, const std::pair<int, StationID> &e)
+                                              { return order < e.first; });
+                LinePosition pos{line, p.first, static_cast<uint32_t>(lower - list.begin()),
+                                 static_cast<uint32_t>(upper - list.begin())};
+
+                // 같은 노선에 같은 역이 여러 번 있으면 뒤(순서 큰 쪽) 기록 우선
+                auto &positions = station_line_positions_[p.second];
+                auto same = std::find_if(positions.begin(), positions.end(), [line](const LinePosition &x)
+                                         { return x.line == line; });
+                if (same != positions.end())
+                    *same = pos;
+                else
+                    positions.push_back(pos);
             }
         }
-        else
+    }
+
+    const DataContainer::LinePosition *DataContainer::line_position(StationID sid, int32_t line) const
+    {
+        if (line < 0 || sid >= station_line_positions_.size())
+            return nullptr;
+        for (const auto &pos : station_line_positions_[sid])
+            if (pos.line == line)
+                return &pos;
+        return nullptr;
+    }
+
+    std::vector<StationID> DataContainer::get_intermediate_stations(
+        StationID from_id, StationID to_id, const std::string &line) const
+    {
+        std::vector<PathStop> stops;
+        append_intermediate_stops(from_id, to_id, line_id(line), stops);
+
+        std::vector<StationID> result;
+        result.reserve(stops.size());
+        for (const auto &stop : stops)
+            result.push_back(stop.station_id);
+        return result;
+    }
+
+    void DataContainer::append_intermediate_stops(
+        StationID from_id, StationID to_id, int32_t line, std::vector<PathStop> &out) const
+    {
+        const LinePosition *from = line_position(from_id, line);
+        const LinePosition *to = line_position(to_id, line);
+        size_t before = out.size();
+        if (from && to)
         {
-            for (auto it = list.rbegin(); it != list.rend(); ++it)
+            const std::vector<StationID> &stations = line_order_stations_[static_cast<size_t>(line)];
+            if (from->order < to->order)
+            {
+                for (uint32_t i = from->upper; i < to->upper; ++i)
+                    out.push_back({stations[i], line});
+            }
+            else
             {
-                if (it->first < from_order && it->first >= to_order)
-                    result.push_back(it->second);
+                for (uint32_t i = from->lower; i > to->lower; --i)
+                    out.push_back({stations[i - 1], line});
             }
         }
-        if (result.empty())
-            result.push_back(to_id);
-        return result;
+        if (out.size() == before)
+            out.push_back({to_id, line});
     }
 
     StationID DataContainer::get_id(const std::string &cd) const
     {
-        auto it = code_to_id_.find(cd);
-        if (it != code_to_id_.end())
-            return it->second;
+        int32_t id = find_id(cd);
+        if (id >= 0)
+            return static_cast<StationID>(id);
         throw std::runtime_error("Unknown station code: " + cd);
     }
 
+    int32_t DataContainer::find_id(const std::string &cd) const
+    {
+        if (!code_table_.empty())
+        {
+            // 모든 코드가 숫자이므로 색인표에 없으면 알 수 없는 코드
+            int64_t value = numeric_code(cd, CODE_TABLE_MAX_DIGITS);
+            if (value < 0 || static_cast<size_t>(value) >= code_table_.size())
+                return -1;
+            StationID id = code_table_[value];
+            // 앞자리 0만 다른 코드("100" / "0100")는 원래 코드와 비교해 구분
+            if (id == NO_STATION || id_to_code_[id] != cd)
+                return -1;
+            return id;
+        }
+        auto it = code_to_id_.find(cd);
+        return it != code_to_id_.end() ? static_cast<int32_t>(it->second) : -1;
+    }
+
+    void DataContainer::build_code_table()
+    {
+        code_table_.clear();
+        int64_t max_value = -1;
+        for (const auto &cd : id_to_code_)
+        {
+            int64_t value = numeric_code(cd, CODE_TABLE_MAX_DIGITS);
+            if (value < 0)
+                return;
+            max_value = std::max(max_value, value);
+        }
+        if (max_value < 0 || id_to_code_.size() >= NO_STATION)
+            return;
+
+        std::vector<StationID> table(static_cast<size_t>(max_value) + 1, NO_STATION);
+        for (size_t id = 0; id < id_to_code_.size(); ++id)
+        {
+            StationID &slot = table[numeric_code(id_to_code_[id], CODE_TABLE_MAX_DIGITS)];
+            if (slot != NO_STATION)
+                return; // 숫자값 충돌 -> 해시 조회 유지
+            slot = static_cast<StationID>(id);
+        }
+        code_table_ = std::move(table);
+    }
+
     std::string DataContainer::get_code(StationID id) const
     {
         if (id < id_to_code_.size())
@@ -344,6 +809,18 @@ namespace pathfinding
         return "";
     }
 
+    int32_t DataContainer::line_id(const std::string &line) const
+    {
+        auto it = line_ids_.find(line);
+        return it != line_ids_.end() ? static_cast<int32_t>(it->second) : -1;
+    }
+
+    const std::string &DataContainer::line_name(LineID id) const
+    {
+        static const std::string empty;
+        return id < line_names_.size() ? line_names_[id] : empty;
+    }
+
     // const StationInfo &DataContainer::get_station(StationID id) const
     // {
     //     return stations_[id];
@@ -1,10 +1,16 @@
 #pragma once
 #include "types.h"
+#include "snapshot.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include <shared_mutex>
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <pybind11/pybind11.h>
 
 namespace py = pybind11;
@@ -14,19 +20,49 @@ namespace pathfinding
     class DataContainer
     {
     public:
+        // footpath_minutes: 적재 중 도보 연결 구축 기준 (build_footpaths와 같음, 적재 후 다시 구축할 필요 없음)
         void load_from_python(
             const py::dict &stations,
             const py::dict &line_stations,
             const py::dict &station_order,
             const py::dict &transfers,
-            const py::dict &congestion);
+            const py::dict &congestion,
+            double footpath_minutes = DEFAULT_FOOTPATH_MINUTES);
+
+        // 스냅샷 적재/추출 (오프라인 도구 및 재현용)
+        void load_snapshot(const NetworkSnapshot &snapshot, double footpath_minutes = DEFAULT_FOOTPATH_MINUTES);
+        NetworkSnapshot to_snapshot() const;
 
         // 실시간 업데이트 (List of dicts)
+        // Python 객체 변환은 GIL을 쥔 채, 적용(쓰기 잠금 대기 포함)은 GIL을 해제하고 수행
         void update_facility_scores(const py::list &facility_rows);
-
-        // 경로 복원용 중간역 반환
+        // 혼잡도 갱신 (load_from_python의 congestion과 동일한 형식, 슬롯 단위 병합)
+        void update_congestion(const py::dict &congestion);
+
+        // 네이티브 쓰기 경로 (쓰기 잠금 획득 후 적용만 수행, 변환은 호출자 책임)
+        void apply_facility_scores(const std::vector<SnapshotFacility> &updates);
+        void apply_congestion(const std::vector<SnapshotCongestion> &updates);
+
+        // 도보 연결 그래프 재구축 (이름이 다른 역 중 장애 유형별 max_walk_minutes 이내 도보 거리 쌍)
+        // load_snapshot에서 footpath_minutes(기본 DEFAULT_FOOTPATH_MINUTES)로 자동 구축, 0 이하이면 도보 연결 없음
+        static constexpr double DEFAULT_FOOTPATH_MINUTES = 6.0;
+        void build_footpaths(double max_walk_minutes);
+
+        // 역 간 거리 행렬 (미터, float, 역 ID 행 우선) 재구축
+        // 역 수가 DENSE_MATRIX_MAX_STATIONS 이하일 때만 보관 (4096역 = 64MB), 초과 시 비움
+        // 재구축은 새 버퍼로 교체하므로 이전에 꺼낸 행렬(NumPy 뷰 등)은 계속 유효
+        static constexpr size_t DENSE_MATRIX_MAX_STATIONS = 4096;
+        void build_distance_matrix();
+        std::shared_ptr<const std::vector<float>> distance_matrix() const;
+        // 행렬이 있으면 조회, 없으면 haversine 직접 계산 (읽기 잠금은 호출자 책임)
+        double station_distance(StationID a, StationID b) const;
+
+        // 경로 복원용 중간역 반환 (from 다음 역 ~ to, 순서 데이터가 없으면 {to})
         std::vector<StationID> get_intermediate_stations(
             StationID from_id, StationID to_id, const std::string &line) const;
+        // 위와 같은 중간역을 (역, line) 정차로 out 뒤에 추가 (노선별 위치 배열의 연속 구간, O(k))
+        void append_intermediate_stops(
+            StationID from_id, StationID to_id, int32_t line, std::vector<PathStop> &out) const;
 
         // 역별 편의시설 점수 조회
         double get_station_convenience(StationID sid, DisabilityType type) const
@@ -37,8 +73,26 @@ namespace pathfinding
         }
 
         // Getters
-        StationID get_id(const std::string &cd) const;
+        size_t station_count() const { return stations_.size(); }
+        StationID get_id(const std::string &cd) const; // 알 수 없는 코드면 std::runtime_error
+        // 역 코드 -> ID, 알 수 없는 코드면 -1 (숫자 코드는 직접 색인표로 해시 없이 조회)
+        int32_t find_id(const std::string &cd) const;
+        bool has_code_table() const { return !code_table_.empty(); }
         std::string get_code(StationID id) const;
+        // 노선명 <-> 정수 ID (역/순서 데이터의 노선, 적재 시 이름순으로 부여), 알 수 없는 노선이면 -1 / 빈 문자열
+        int32_t line_id(const std::string &line) const;
+        const std::string &line_name(LineID id) const;
+        const std::vector<std::string> &line_names() const { return line_names_; }
+        // 역 코드(ID 순)와 노선 ID 배정의 해시 (FNV-1a 64)
+        // 역/노선 ID를 담은 직렬화 결과(경로 캐시 페이로드)가 같은 ID 체계인지 확인하는 데 사용
+        uint64_t network_fingerprint() const { return network_fingerprint_; }
+        // 탐색 결과에 영향을 주는 데이터 갱신 횟수 (적재, 혼잡도/편의시설 점수 갱신, 도보 연결 재구축마다 증가)
+        // 결과 캐시(ResultCache)가 갱신 이전에 계산된 결과를 구분하는 데 사용
+        uint64_t data_version() const { return data_version_.load(std::memory_order_acquire); }
+        // 탐색 결과에 영향을 주는 데이터 전체의 내용 해시 (역/순서/토폴로지/환승/혼잡도/편의시설 점수/도보 연결)
+        // data_version은 프로세스마다 0부터 세므로, 프로세스 간 비교(디스크에 저장한 결과 캐시 등)에는 이 값을 사용
+        // 같은 데이터 버전에서는 한 번만 계산, version이 있으면 해시 기준 data_version을 기록
+        uint64_t content_fingerprint(uint64_t *version = nullptr) const;
         const StationInfo &get_station(StationID id) const
         {
             if (stations_.empty())
@@ -85,10 +139,48 @@ namespace pathfinding
             return it != transfer_adjacency_.end() ? it->second : empty;
         }
 
+        struct FootpathRange
+        {
+            const Footpath *first;
+            const Footpath *last;
+            const Footpath *begin() const { return first; }
+            const Footpath *end() const { return last; }
+        };
+        FootpathRange get_footpaths(StationID id) const
+        {
+            if (static_cast<size_t>(id) + 1 >= footpath_start_.size())
+                return {nullptr, nullptr};
+            const Footpath *base = footpaths_.data();
+            return {base + footpath_start_[id], base + footpath_start_[id + 1]};
+        }
+        size_t footpath_count() const { return footpaths_.size(); }
+
     private:
+        // 잠금 없이 단건 적용 (load_snapshot / apply_* 공용)
+        void merge_congestion(const SnapshotCongestion &c);
+        void set_facility_scores(const SnapshotFacility &fc);
+
         std::unordered_map<std::string, StationID> code_to_id_;
         std::vector<std::string> id_to_code_;
 
+        // 숫자 역 코드 직접 색인표: code_table_[코드 숫자값] = ID (빈 칸은 NO_STATION)
+        // 모든 코드가 CODE_TABLE_MAX_DIGITS자리 이하 숫자이고 숫자값이 겹치지 않을 때만 구축 (최대 2MB),
+        // 비어 있으면 code_to_id_ 사용
+        static constexpr size_t CODE_TABLE_MAX_DIGITS = 6;
+        static constexpr StationID NO_STATION = std::numeric_limits<StationID>::max();
+        std::vector<StationID> code_table_;
+        void build_code_table();
+
+        std::vector<std::string> line_names_;
+        std::unordered_map<std::string, LineID> line_ids_;
+        uint64_t network_fingerprint_ = 0;
+        std::atomic<uint64_t> data_version_{0};
+        // update_mutex 쓰기 잠금 해제 직전 호출 (잠금을 푼 뒤 조회하는 쪽이 새 버전을 보도록)
+        void bump_data_version() { data_version_.fetch_add(1, std::memory_order_acq_rel); }
+        mutable std::mutex content_fingerprint_mutex_;
+        mutable uint64_t content_fingerprint_ = 0;
+        mutable uint64_t content_fingerprint_version_ = std::numeric_limits<uint64_t>::max();
+
         std::vector<StationInfo> stations_;
         std::vector<std::vector<std::string>> station_lines_;
 
@@ -107,9 +199,22 @@ namespace pathfinding
         };
         std::unordered_map<LineStationKey, DirectionLines, LineStationHash> line_topology_;
 
-        // 중간역 복원을 위한 순서 데이터
-        std::unordered_map<LineStationKey, int, LineStationHash> station_orders_;
+        // 중간역 복원을 위한 순서 데이터 (노선명 -> (순서, 역) 순서순, 스냅샷 내보내기에도 사용)
         std::unordered_map<std::string, std::vector<std::pair<int, StationID>>> line_ordered_stations_;
+        // 노선 ID별 순서순 역 배열과 역별 노선 내 위치
+        // lower/upper = 그 역 순서의 lower_bound/upper_bound 위치 (같은 순서 역이 여럿이어도 구간 유지)
+        // from -> to 중간역: 순방향 [from.upper, to.upper), 역방향 [to.lower, from.lower)를 거꾸로
+        struct LinePosition
+        {
+            LineID line;
+            int order;
+            uint32_t lower;
+            uint32_t upper;
+        };
+        std::vector<std::vector<StationID>> line_order_stations_;
+        std::vector<std::vector<LinePosition>> station_line_positions_; // 역당 노선 1~2개라 선형 조회
+        const LinePosition *line_position(StationID sid, int32_t line) const;
+        void build_line_positions();
 
         struct TransferKey
         {
@@ -139,5 +244,12 @@ namespace pathfinding
         std::unordered_map<CongestionKey, std::unordered_map<std::string, double>, CongestionHash> congestion_;
 
         std::vector<std::array<double, 4>> station_scores_;
+
+        // 도보 연결 (CSR: footpaths_[footpath_start_[sid] .. footpath_start_[sid + 1]), 거리 오름차순)
+        std::vector<uint32_t> footpath_start_;
+        std::vector<Footpath> footpaths_;
+
+        // 역 간 거리 행렬 (station_count()^2 원소, 행렬이 없으면 nullptr)
+        std::shared_ptr<const std::vector<float>> distance_matrix_;
     };
 }
\ No newline at end of file
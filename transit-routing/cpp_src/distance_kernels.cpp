@@ -0,0 +1,110 @@
+#include "distance_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pathfinding
+{
+    namespace
+    {
+        constexpr double EARTH_RADIUS_M = 6371000.0;
+        constexpr double TO_RAD = 3.14159265358979323846 / 180.0;
+        constexpr double M_PER_DEG_LAT = EARTH_RADIUS_M * TO_RAD;
+        // asin 다항식 적용 상한 (sin(반각), 약 637km), 이 범위에서 생략된 항은 1e-17 미만
+        constexpr double ASIN_POLY_MAX = 0.05;
+
+        // asin(h) 테일러 전개 (h^11 항까지)
+        inline double asin_small(double h)
+        {
+            double h2 = h * h;
+            return h * (1.0 + h2 * (1.0 / 6.0 + h2 * (3.0 / 40.0 + h2 * (15.0 / 336.0 +
+                                                                           h2 * (105.0 / 3456.0 + h2 * (945.0 / 42240.0))))));
+        }
+
+        // 질의 벡터 q와 각 점 사이 중심각 -> 미터
+        void unit_distances(double qx, double qy, double qz, const double *xs, const double *ys, const double *zs,
+                            size_t n, double *out)
+        {
+            // 1단계: h = sin(중심각 / 2) = |p - q| / 2, 다항식 범위 초과 개수 (정수 축약이라 벡터화 유지)
+            size_t far = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                double dx = xs[i] - qx, dy = ys[i] - qy, dz = zs[i] - qz;
+                double h = 0.5 * std::sqrt(dx * dx + dy * dy + dz * dz);
+                out[i] = h;
+                far += h > ASIN_POLY_MAX;
+            }
+
+            // 2단계: d = 2R * asin(h)
+            if (far == 0)
+            {
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = 2.0 * EARTH_RADIUS_M * asin_small(out[i]);
+                return;
+            }
+            for (size_t i = 0; i < n; ++i)
+            {
+                double h = out[i];
+                out[i] = 2.0 * EARTH_RADIUS_M * (h <= ASIN_POLY_MAX ? asin_small(h) : std::asin(std::min(h, 1.0)));
+            }
+        }
+    }
+
+    DistanceKernels::UnitPoints DistanceKernels::to_unit(const double *lats, const double *lons, size_t n)
+    {
+        UnitPoints p;
+        p.x.resize(n);
+        p.y.resize(n);
+        p.z.resize(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            double phi = lats[i] * TO_RAD, lambda = lons[i] * TO_RAD;
+            double cos_phi = std::cos(phi);
+            p.x[i] = cos_phi * std::cos(lambda);
+            p.y[i] = cos_phi * std::sin(lambda);
+            p.z[i] = std::sin(phi);
+        }
+        return p;
+    }
+
+    void DistanceKernels::haversine_one_to_many(double lat, double lon, const UnitPoints &points, double *out)
+    {
+        double phi = lat * TO_RAD, lambda = lon * TO_RAD;
+        double cos_phi = std::cos(phi);
+        unit_distances(cos_phi * std::cos(lambda), cos_phi * std::sin(lambda), std::sin(phi),
+                       points.x.data(), points.y.data(), points.z.data(), points.size(), out);
+    }
+
+    void DistanceKernels::haversine_one_to_many(double lat, double lon, const double *lats, const double *lons,
+                                                size_t n, double *out)
+    {
+        haversine_one_to_many(lat, lon, to_unit(lats, lons, n), out);
+    }
+
+    void DistanceKernels::haversine_many_to_many(const double *lats_a, const double *lons_a, size_t na,
+                                                 const double *lats_b, const double *lons_b, size_t nb, double *out)
+    {
+        UnitPoints a = to_unit(lats_a, lons_a, na);
+        UnitPoints b = to_unit(lats_b, lons_b, nb);
+        for (size_t i = 0; i < na; ++i)
+            unit_distances(a.x[i], a.y[i], a.z[i], b.x.data(), b.y.data(), b.z.data(), nb, out + i * nb);
+    }
+
+    void DistanceKernels::equirect_one_to_many(double lat, double lon, const double *lats, const double *lons,
+                                               size_t n, double *out)
+    {
+        const double kx = M_PER_DEG_LAT * std::cos(lat * TO_RAD);
+        for (size_t i = 0; i < n; ++i)
+        {
+            double dx = (lons[i] - lon) * kx;
+            double dy = (lats[i] - lat) * M_PER_DEG_LAT;
+            out[i] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    void DistanceKernels::equirect_many_to_many(const double *lats_a, const double *lons_a, size_t na,
+                                                const double *lats_b, const double *lons_b, size_t nb, double *out)
+    {
+        for (size_t i = 0; i < na; ++i)
+            equirect_one_to_many(lats_a[i], lons_a[i], lats_b, lons_b, nb, out + i * nb);
+    }
+}
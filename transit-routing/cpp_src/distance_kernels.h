@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace pathfinding
+{
+    // 배치 거리 계산 커널 (미터, PathfindingUtils::haversine과 동일한 지구 반지름)
+    // - haversine: 좌표를 단위 구 위의 3차원 벡터로 바꾸면 haversine 항 a = |p - q|^2 / 4 이므로
+    //   내부 루프는 삼각함수 없이 곱/합/제곱근만 남아 자동 벡터화(SIMD) 대상
+    //   asin은 약 640km 이내에서 다항식(오차 1e-15 미만), 그 이상인 원소만 std::asin
+    // - equirect: 질의점 위도의 cos로 경도를 보정한 평면 근사 (서울 권역 규모에서 상대 오차 약 0.1%)
+    // - many_to_many의 out은 na * nb 행 우선 배열
+    class DistanceKernels
+    {
+    public:
+        // 단위 벡터 좌표 (SoA), 같은 점 집합에 반복 질의할 때 1회 변환
+        struct UnitPoints
+        {
+            std::vector<double> x;
+            std::vector<double> y;
+            std::vector<double> z;
+            size_t size() const { return x.size(); }
+        };
+        static UnitPoints to_unit(const double *lats, const double *lons, size_t n);
+
+        static void haversine_one_to_many(double lat, double lon, const UnitPoints &points, double *out);
+        static void haversine_one_to_many(double lat, double lon, const double *lats, const double *lons, size_t n,
+                                          double *out);
+        static void haversine_many_to_many(const double *lats_a, const double *lons_a, size_t na,
+                                           const double *lats_b, const double *lons_b, size_t nb, double *out);
+
+        static void equirect_one_to_many(double lat, double lon, const double *lats, const double *lons, size_t n,
+                                         double *out);
+        static void equirect_many_to_many(const double *lats_a, const double *lons_a, size_t na,
+                                          const double *lats_b, const double *lons_b, size_t nb, double *out);
+    };
+}
@@ -1,11 +1,121 @@
 #include "engine.h"
 #include "utils.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
 #include <shared_mutex>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 namespace pathfinding
 {
+    namespace
+    {
+        // 라운드 내 병렬 스캔 보조 스레드 (프로세스 공용, 요청된 수만큼 지연 생성 후 모든 엔진이 재사용)
+        // - 호출 스레드가 0번 참가자로 직접 수행하고, 쉬고 있는 보조 스레드가 나머지 참가 자리를 채움
+        // - 작업은 호출 측 원자 카운터로 나누므로 보조 스레드가 모두 바쁘면 호출 스레드 혼자 끝까지 수행
+        // - run은 참가한 보조 스레드가 모두 끝난 뒤 반환 (라운드 경계 장벽)
+        class ScanHelpers
+        {
+        public:
+            static ScanHelpers &instance()
+            {
+                static ScanHelpers helpers;
+                return helpers;
+            }
+
+            void run(size_t participants, const std::function<void(size_t)> &work)
+            {
+                if (participants <= 1)
+                {
+                    work(0);
+                    return;
+                }
+
+                Job job;
+                job.work = &work;
+                job.open = participants - 1;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    while (threads_.size() < participants - 1)
+                        threads_.emplace_back([this]
+                                              { loop(); });
+                    jobs_.push_back(&job);
+                }
+                wake_.notify_all();
+
+                work(0);
+
+                // 아직 참가하지 않은 자리는 회수하고, 참가한 보조 스레드가 끝날 때까지 대기
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (job.open > 0)
+                    jobs_.erase(std::find(jobs_.begin(), jobs_.end(), &job));
+                job.open = 0;
+                job.done.wait(lock, [&job]
+                              { return job.active == 0; });
+            }
+
+            ~ScanHelpers()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                wake_.notify_all();
+                for (auto &t : threads_)
+                    t.join();
+            }
+
+        private:
+            struct Job
+            {
+                const std::function<void(size_t)> *work = nullptr;
+                size_t open = 0;    // 남은 참가 자리
+                size_t joined = 0;  // 참가한 보조 스레드 수 (참가 번호 1..joined)
+                size_t active = 0;  // 수행 중인 보조 스레드 수
+                std::condition_variable done;
+            };
+
+            ScanHelpers() = default;
+
+            void loop()
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (true)
+                {
+                    wake_.wait(lock, [this]
+                               { return stopping_ || !jobs_.empty(); });
+                    if (stopping_)
+                        return;
+
+                    Job *job = jobs_.front();
+                    size_t slot = ++job->joined;
+                    job->active++;
+                    if (--job->open == 0)
+                        jobs_.pop_front();
+
+                    lock.unlock();
+                    (*job->work)(slot); // 예외는 work 안에서 처리
+                    lock.lock();
+                    if (--job->active == 0)
+                        job->done.notify_all();
+                }
+            }
+
+            std::mutex mutex_;
+            std::condition_variable wake_;
+            std::deque<Job *> jobs_; // 참가 자리가 남은 작업 (먼저 온 순)
+            std::vector<std::thread> threads_;
+            bool stopping_ = false;
+        };
+    }
+
     McRaptorEngine::McRaptorEngine(const DataContainer &data) : data_(data)
     {
         label_pool_.reserve(200000);
@@ -17,195 +127,681 @@ namespace pathfinding
         double departure_time,
         const std::string &disability_type_str,
         int max_rounds)
+    {
+        return find_routes({{origin_cd, 0.0}}, dest_cds, departure_time, disability_type_str, max_rounds);
+    }
+
+    std::vector<Label> McRaptorEngine::find_routes(
+        const std::vector<AccessLeg> &origins,
+        const std::unordered_set<std::string> &dest_cds,
+        double departure_time,
+        const std::string &disability_type_str,
+        int max_rounds)
+    {
+        return find_routes(resolve_origins(origins), resolve_dests(dest_cds), departure_time, disability_type_str,
+                           max_rounds);
+    }
+
+    std::vector<Label> McRaptorEngine::find_routes(
+        const std::vector<AccessLegId> &origins,
+        const std::vector<StationID> &dest_ids,
+        double departure_time,
+        const std::string &disability_type_str,
+        int max_rounds)
     {
         std::shared_lock<std::shared_mutex> lock(data_.update_mutex);
 
-        label_pool_.clear();
-        StationID origin_id = data_.get_id(origin_cd);
-        std::unordered_set<StationID> dest_ids;
+        begin_search(origins, checked_dests(dest_ids), departure_time, disability_type_str);
+        run_rounds(max_rounds, nullptr);
+        if (state_.aborted)
+            return {};
+        return collect_results();
+    }
+
+    std::vector<Label> McRaptorEngine::find_routes_streaming(
+        const std::string &origin_cd,
+        const std::unordered_set<std::string> &dest_cds,
+        double departure_time,
+        const std::string &disability_type_str,
+        int max_rounds,
+        const RouteCallback &on_update)
+    {
+        return find_routes_streaming({{origin_cd, 0.0}}, dest_cds, departure_time, disability_type_str,
+                                     max_rounds, on_update);
+    }
+
+    std::vector<Label> McRaptorEngine::find_routes_streaming(
+        const std::vector<AccessLeg> &origins,
+        const std::unordered_set<std::string> &dest_cds,
+        double departure_time,
+        const std::string &disability_type_str,
+        int max_rounds,
+        const RouteCallback &on_update)
+    {
+        return find_routes_streaming(resolve_origins(origins), resolve_dests(dest_cds), departure_time,
+                                     disability_type_str, max_rounds, on_update);
+    }
+
+    std::vector<Label> McRaptorEngine::find_routes_streaming(
+        const std::vector<AccessLegId> &origins,
+        const std::vector<StationID> &dest_ids,
+        double departure_time,
+        const std::string &disability_type_str,
+        int max_rounds,
+        const RouteCallback &on_update)
+    {
+        std::shared_lock<std::shared_mutex> lock(data_.update_mutex);
+
+        begin_search(origins, checked_dests(dest_ids), departure_time, disability_type_str);
+        run_rounds(max_rounds, &on_update);
+        if (state_.aborted)
+            return {};
+        return collect_results();
+    }
+
+    std::vector<Label> McRaptorEngine::resume_routes(int max_rounds)
+    {
+        std::shared_lock<std::shared_mutex> lock(data_.update_mutex);
+
+        if (!state_.active)
+            throw std::runtime_error("resume_routes: no search to resume");
+        if (state_.aborted)
+            throw std::runtime_error("resume_routes: previous search was aborted");
+
+        // stats_는 누적 (rounds/labels_created가 재개 후 전체 탐색 기준)
+        run_rounds(max_rounds, nullptr);
+        if (state_.aborted)
+            return {};
+        return collect_results();
+    }
+
+    std::vector<Label> McRaptorEngine::reroute(
+        const std::string &current_cd,
+        const std::unordered_set<std::string> &dest_cds,
+        double current_time,
+        const std::string &disability_type_str,
+        int max_rounds,
+        const RouteCallback &on_update)
+    {
+        return reroute({{current_cd, 0.0}}, dest_cds, current_time, disability_type_str, max_rounds, on_update);
+    }
+
+    std::vector<Label> McRaptorEngine::reroute(
+        const std::vector<AccessLeg> &origins,
+        const std::unordered_set<std::string> &dest_cds,
+        double current_time,
+        const std::string &disability_type_str,
+        int max_rounds,
+        const RouteCallback &on_update)
+    {
+        std::vector<StationID> dest_ids = resolve_dests(dest_cds);
+        return reroute(resolve_origins(origins), dest_ids, current_time, disability_type_str, max_rounds,
+                       on_update);
+    }
+
+    std::vector<Label> McRaptorEngine::reroute(
+        const std::vector<AccessLegId> &origins,
+        const std::vector<StationID> &dest_id_list,
+        double current_time,
+        const std::string &disability_type_str,
+        int max_rounds,
+        const RouteCallback &on_update)
+    {
+        std::shared_lock<std::shared_mutex> lock(data_.update_mutex);
+
+        // 1. 직전 탐색이 같은 질의(목적지/장애 유형)일 때만 탐색 트리 재사용
+        std::unordered_set<StationID> dest_ids = checked_dests(dest_id_list);
+        std::vector<std::pair<StationID, std::vector<RouteSuffix>>> suffixes;
+        if (state_.active && !state_.aborted && state_.dest_ids == dest_ids &&
+            state_.disability_type == disability_type_str)
+        {
+            for (const auto &o : origins)
+            {
+                if (o.station_id < data_.station_count())
+                    suffixes.emplace_back(o.station_id, extract_suffixes(o.station_id));
+            }
+        }
+
+        // 2. 현재 위치/시각에서 새 탐색 시작, 접근 역별 잔여 구간을 재계산하여 목적지 bag에 채움
+        begin_search(origins, dest_ids, current_time, disability_type_str);
+        for (const auto &entry : suffixes)
+            stats_.routes_reused += replay_suffixes(entry.first, entry.second);
+        // 복구 경로(및 이후 찾은 목적지 경로)로 탐색 범위를 제한 (재탐색 비용 < 새 탐색)
+        // 평균 편의도/혼잡도가 기준이면 근사이므로 명시적으로 켠 경우에만
+        const bool averaged = state_.weights.congestion > 0.0 || state_.weights.convenience > 0.0;
+        state_.target_pruning = stats_.routes_reused > 0 && (target_pruning_ || !averaged);
+
+        if (on_update && stats_.routes_reused > 0 && !on_update(0, collect_results()))
+            return collect_results();
+
+        // 3. 복구 경로보다 나은 경로 탐색 (목적지 bag의 복구 경로가 지배 판정에 참여)
+        run_rounds(max_rounds, on_update ? &on_update : nullptr);
+        // 중단되더라도 복구한 경로가 있으면 그때까지의 결과 반환 (모두 실제 가능한 경로)
+        if (state_.aborted && stats_.routes_reused == 0)
+            return {};
+        return collect_results();
+    }
+
+    std::vector<McRaptorEngine::RouteSuffix> McRaptorEngine::extract_suffixes(StationID from_id) const
+    {
+        std::vector<RouteSuffix> suffixes;
+        for (StationID d : state_.dest_ids)
+        {
+            auto it = state_.bags.find(d);
+            if (it == state_.bags.end())
+                continue;
+
+            for (LabelIndex leaf : it->second)
+            {
+                std::vector<LabelIndex> chain;
+                for (LabelIndex cur = leaf; cur != -1; cur = label_pool_[cur].parent_index)
+                    chain.push_back(cur);
+                std::reverse(chain.begin(), chain.end());
+
+                // 현재 역을 처음 지나는 지점 이후가 잔여 구간
+                // (라벨이 있는 역 또는 주행 구간의 중간 정차역)
+                RouteSuffix suffix;
+                size_t next = chain.size();
+                for (size_t k = 0; k < chain.size(); ++k)
+                {
+                    const Label &curr = label_pool_[chain[k]];
+                    if (curr.station_id == from_id)
+                    {
+                        suffix.start_line = curr.current_line;
+                        next = k + 1;
+                        break;
+                    }
+                    if (k > 0 && passes_through(label_pool_[chain[k - 1]], curr, from_id))
+                    {
+                        // 현재 역에서 같은 노선/방향으로 curr까지 이어서 주행
+                        suffix.start_line = curr.current_line;
+                        suffix.steps.push_back({false, curr.station_id, curr.current_line, curr.direction});
+                        next = k + 1;
+                        break;
+                    }
+                }
+
+                for (size_t j = next; j < chain.size(); ++j)
+                {
+                    const Label &prev = label_pool_[chain[j - 1]];
+                    const Label &curr = label_pool_[chain[j]];
+                    bool transfer = curr.current_line != prev.current_line;
+                    suffix.steps.push_back({transfer, curr.station_id, curr.current_line,
+                                            transfer ? Direction::UNKNOWN : curr.direction});
+                }
+                if (suffix.steps.empty())
+                    continue; // 현재 역을 지나지 않음 (또는 현재 역 = 목적지)
+
+                bool duplicate = false;
+                for (const auto &s : suffixes)
+                    if (s.start_line == suffix.start_line && s.steps == suffix.steps)
+                    {
+                        duplicate = true;
+                        break;
+                    }
+                if (!duplicate)
+                    suffixes.push_back(std::move(suffix));
+            }
+        }
+        return suffixes;
+    }
+
+    bool McRaptorEngine::passes_through(const Label &from, const Label &to, StationID station) const
+    {
+        // 같은 노선 주행 간선(from -> to)의 중간 정차역 여부
+        if (from.current_line != to.current_line || from.station_id == to.station_id)
+            return false;
+        const auto &next_stops = data_.get_next_stations(from.station_id, to.current_line);
+        for (const auto *targets : {&next_stops.up, &next_stops.down, &next_stops.in, &next_stops.out})
+        {
+            auto it_to = std::find(targets->begin(), targets->end(), to.station_id);
+            if (it_to != targets->end())
+                return std::find(targets->begin(), it_to, station) != it_to;
+        }
+        return false;
+    }
+
+    size_t McRaptorEngine::replay_suffixes(StationID from_id, const std::vector<RouteSuffix> &suffixes)
+    {
+        size_t reused = 0;
+        for (const auto &suffix : suffixes)
+        {
+            // 같은 노선의 출발 라벨에서 시작 (다중 출발이면 도보 접근 시간이 반영된 라벨)
+            LabelIndex cur = -1;
+            for (LabelIndex idx : state_.bags[from_id])
+                if (label_pool_[idx].current_line == suffix.start_line)
+                    cur = idx;
+            if (cur == -1)
+                continue;
+
+            // 중간 라벨은 bag에 넣지 않음 (탐색 라운드에서 확장되지 않도록)
+            int round = 0;
+            for (const auto &step : suffix.steps)
+            {
+                ++round;
+                if (!step.transfer)
+                    cur = create_ride_label(cur, step.station, step.dir, round);
+                else if (data_.get_transfer(label_pool_[cur].station_id, label_pool_[cur].current_line, step.line))
+                    cur = create_transfer_label(cur, step.line, round);
+                else
+                {
+                    // 환승 데이터가 없으면 도보 연결로 이동한 구간
+                    LabelIndex walk = -1;
+                    for (const Footpath &fp : data_.get_footpaths(label_pool_[cur].station_id))
+                        if (fp.to_station_id == step.station)
+                            walk = create_footpath_label(cur, fp, round);
+                    cur = walk;
+                }
+                if (cur == -1 || label_pool_[cur].station_id != step.station)
+                {
+                    cur = -1;
+                    break;
+                }
+            }
+            if (cur == -1)
+                continue;
+
+            StationID dest = label_pool_[cur].station_id;
+            if (!state_.dest_ids.count(dest))
+                continue;
+            bool dominated = false;
+            for (LabelIndex ex : state_.bags[dest])
+                if (dominates(label_pool_[ex], label_pool_[cur], state_.weights))
+                {
+                    dominated = true;
+                    break;
+                }
+            if (!dominated)
+            {
+                state_.bags[dest].push_back(cur);
+                ++reused;
+            }
+        }
+        return reused;
+    }
+
+    std::vector<AccessLegId> McRaptorEngine::resolve_origins(const std::vector<AccessLeg> &origins) const
+    {
+        std::vector<AccessLegId> ids;
+        ids.reserve(origins.size());
+        for (const auto &o : origins)
+            ids.push_back({data_.get_id(o.station_cd), o.distance_m});
+        return ids;
+    }
+
+    std::vector<StationID> McRaptorEngine::resolve_dests(const std::unordered_set<std::string> &dest_cds) const
+    {
+        std::vector<StationID> ids;
+        ids.reserve(dest_cds.size());
         for (const auto &d : dest_cds)
-            dest_ids.insert(data_.get_id(d));
+            ids.push_back(data_.get_id(d));
+        return ids;
+    }
 
-        ANPWeights weights = PathfindingUtils::calculate_anp_weights(disability_type_str);
-        DisabilityType dtype = PathfindingUtils::str_to_disability(disability_type_str);
-        double walk_speed = PathfindingUtils::get_walking_speed(disability_type_str);
-        std::string day_type = PathfindingUtils::get_day_type(departure_time);
+    std::unordered_set<StationID> McRaptorEngine::checked_dests(const std::vector<StationID> &dest_ids) const
+    {
+        std::unordered_set<StationID> out;
+        for (StationID id : dest_ids)
+        {
+            if (id >= data_.station_count())
+                throw std::runtime_error("Unknown station id: " + std::to_string(id));
+            out.insert(id);
+        }
+        return out;
+    }
 
-        std::unordered_map<StationID, std::vector<LabelIndex>> bags;
-        std::unordered_set<StationID> marked_stations;
+    void McRaptorEngine::begin_search(
+        const std::vector<AccessLegId> &origins,
+        const std::unordered_set<StationID> &dest_ids,
+        double departure_time,
+        const std::string &disability_type_str)
+    {
+        label_pool_.clear();
+        stats_ = SearchStats();
+        state_ = SearchState();
+
+        if (origins.empty())
+            throw std::runtime_error("No origin stations");
+
+        // 역별 최단 접근 거리 (같은 역 중복 제거), 접근 거리 오름차순
+        std::vector<std::pair<double, StationID>> access;
+        for (const auto &o : origins)
+        {
+            StationID sid = o.station_id;
+            if (sid >= data_.station_count())
+                throw std::runtime_error("Unknown station id: " + std::to_string(sid));
+            double dist = std::max(o.distance_m, 0.0);
+            auto it = std::find_if(access.begin(), access.end(), [sid](const auto &a)
+                                   { return a.second == sid; });
+            if (it == access.end())
+                access.emplace_back(dist, sid);
+            else
+                it->first = std::min(it->first, dist);
+        }
+        std::sort(access.begin(), access.end());
+
+        state_.dest_ids = dest_ids;
+        state_.departure_time = departure_time;
+        state_.disability_type = disability_type_str;
+        state_.weights = PathfindingUtils::calculate_anp_weights(disability_type_str);
+        state_.dtype = PathfindingUtils::str_to_disability(disability_type_str);
+        state_.walk_speed = PathfindingUtils::get_walking_speed(disability_type_str);
+        state_.day_type = PathfindingUtils::get_day_type(departure_time);
 
-        // 출발 라벨 생성
-        auto start_lines = data_.get_lines(origin_id);
-        for (const auto &line : start_lines)
+        // 출발 라벨 생성 (round 0에 모든 접근 역을 시드, 도보 시간만큼 늦게 출발)
+        for (const auto &[dist, sid] : access)
         {
-            LabelIndex idx = create_label(-1, origin_id, line, Direction::UNKNOWN, 0, 0.0,
-                                          0.0, 0.0, 0.0, 1, true, 0);
-            bags[origin_id].push_back(idx);
+            double walk_minutes = dist / (state_.walk_speed * 60.0);
+            for (const auto &line : data_.get_lines(sid))
+            {
+                LabelIndex idx = create_label(-1, sid, line, Direction::UNKNOWN, 0, walk_minutes,
+                                              0.0, 0.0, 0.0, 1, true, 0);
+                state_.bags[sid].push_back(idx);
+            }
+            state_.origin_ids.push_back(sid);
+            state_.marked.insert(sid);
         }
-        marked_stations.insert(origin_id);
 
-        // RAPTOR Rounds
-        for (int round = 1; round <= max_rounds; ++round)
+        // 출발역에서 도보로 이동 가능한 인접 역도 round 0에 시드 (RAPTOR 초기 도보 완화)
+        std::vector<LabelIndex> seeds;
+        for (StationID sid : state_.origin_ids)
+            seeds.insert(seeds.end(), state_.bags[sid].begin(), state_.bags[sid].end());
+        for (LabelIndex idx : seeds)
+            relax_footpaths(idx, 0, state_.marked);
+        state_.active = true;
+    }
+
+    void McRaptorEngine::run_rounds(int max_rounds, const RouteCallback *on_update)
+    {
+        stats_.preempted = false;
+        stats_.effort_level = effort_.level;
+        if (effort_.max_rounds > 0)
+            max_rounds = std::min(max_rounds, effort_.max_rounds);
+        for (int round = state_.completed_rounds + 1; round <= max_rounds; ++round)
         {
-            // std::cerr << "[DEBUG] Round " << round << " started. Marked stations: " << marked_stations.size() << std::endl;
+            if (state_.marked.empty())
+                break;
+
+            size_t found_before = destination_label_count();
+            if (!run_round(round))
+                break; // 큐 폭증으로 중단
+            state_.completed_rounds = round;
 
-            if (marked_stations.empty())
+            // 이번 라운드에 목적지 라벨이 추가된 경우에만 중간 결과 전달 (false 반환 시 탐색 종료)
+            size_t found = destination_label_count();
+            if (on_update && found > found_before && !(*on_update)(round, collect_results()))
+                break;
+
+            if (round < max_rounds && round_guard_ && !round_guard_(round, found))
             {
-                // std::cerr << "[DEBUG] No marked stations. Stopping early." << std::endl;
+                stats_.preempted = true;
                 break;
             }
-            std::unordered_set<StationID> next_marked;
-            std::vector<StationID> queue(marked_stations.begin(), marked_stations.end());
-            marked_stations.clear();
+        }
+        stats_.labels_created = label_pool_.size();
+    }
+
+    size_t McRaptorEngine::destination_label_count() const
+    {
+        size_t count = 0;
+        for (StationID d : state_.dest_ids)
+        {
+            auto it = state_.bags.find(d);
+            if (it != state_.bags.end())
+                count += it->second.size();
+        }
+        return count;
+    }
+
+    bool McRaptorEngine::bounded_by_target(const Label &l) const
+    {
+        if (!state_.target_pruning || state_.dest_ids.count(l.station_id))
+            return false;
+        const ANPWeights &w = state_.weights;
+        for (StationID d : state_.dest_ids)
+        {
+            auto it = state_.bags.find(d);
+            if (it == state_.bags.end())
+                continue;
+            for (LabelIndex idx : it->second)
+            {
+                const Label &t = label_pool_[idx];
+                if (t.transfers <= l.transfers && t.arrival_time <= l.arrival_time &&
+                    (w.transfer_difficulty <= 0.0 || t.max_transfer_difficulty <= l.max_transfer_difficulty) &&
+                    (w.congestion <= 0.0 || t.avg_congestion() <= l.avg_congestion()) &&
+                    (w.convenience <= 0.0 || t.avg_convenience() >= l.avg_convenience()))
+                    return true;
+            }
+        }
+        return false;
+    }
 
-            int processed_count = 0;
+    std::vector<Label> McRaptorEngine::collect_results() const
+    {
+        std::vector<Label> results;
+        for (StationID d : state_.dest_ids)
+        {
+            auto it = state_.bags.find(d);
+            if (it == state_.bags.end())
+                continue;
+            for (LabelIndex idx : it->second)
+                results.push_back(label_pool_[idx]);
+        }
+        return results;
+    }
 
+    bool McRaptorEngine::run_round(int round)
+    {
+        stats_.rounds = round;
+        stats_.peak_marked = std::max(stats_.peak_marked, state_.marked.size());
+        std::unordered_set<StationID> next_marked;
+        std::vector<StationID> queue(state_.marked.begin(), state_.marked.end());
+        state_.marked.clear();
+
+        // 큐 폭증: 앞쪽 MAX_ROUND_STATIONS개 역까지만 반영하고 중단
+        bool overflow = queue.size() > MAX_ROUND_STATIONS;
+        if (overflow)
+            queue.resize(MAX_ROUND_STATIONS);
+
+        size_t frontier_labels = 0;
+        if (parallel_threads_ > 1)
+            for (StationID u : queue)
+                frontier_labels += state_.bags[u].size();
+
+        if (parallel_threads_ > 1 && queue.size() > 1 && frontier_labels >= PARALLEL_MIN_FRONTIER_LABELS)
+        {
+            scan_parallel(queue, round, next_marked);
+            stats_.parallel_rounds++;
+        }
+        else
+        {
+            // A/B. 역마다 스캔 -> 즉시 병합 (후보 생성은 이번 라운드 bag 변화와 무관)
+            std::vector<Candidate> candidates;
             for (StationID u : queue)
             {
-                if (++processed_count > 5000)
-                {
-                    // std::cerr << "[CRITICAL] Too many stations in queue! Aborting to prevent freeze." << std::endl;
-                    return {};
-                }
+                candidates.clear();
+                scan_station(u, round, candidates);
+                for (auto &c : candidates)
+                    merge_candidate(std::move(c), next_marked);
+            }
+        }
+
+        if (overflow)
+        {
+            // std::cerr << "[CRITICAL] Too many stations in queue! Aborting to prevent freeze." << std::endl;
+            stats_.labels_created = label_pool_.size();
+            stats_.aborted = true;
+            state_.aborted = true;
+            return false;
+        }
 
-                // const auto &labels = bags[u]; => 참조 사용 위험!!!
-                std::vector<LabelIndex> current_labels = bags[u];
+        // C. Footpaths: 이번 라운드에 열차로 도착한 라벨에서 인접 역으로 도보 이동
+        // (도보 라벨은 같은 라운드 번호로 생성되어 다음 라운드에 바로 승차)
+        std::vector<LabelIndex> arrivals;
+        for (StationID v : next_marked)
+        {
+            if (state_.dest_ids.count(v))
+                continue;
+            for (LabelIndex idx : state_.bags[v])
+                if (label_pool_[idx].created_round == round && label_pool_[idx].direction != Direction::UNKNOWN)
+                    arrivals.push_back(idx);
+        }
+        for (LabelIndex idx : arrivals)
+            relax_footpaths(idx, round, next_marked);
+
+        state_.marked = std::move(next_marked);
+        return true;
+    }
 
-                for (LabelIndex l_idx : current_labels)
+    void McRaptorEngine::scan_station(StationID u, int round, std::vector<Candidate> &out) const
+    {
+        // 목적지에 도착한 라벨은 더 확장하지 않음
+        if (state_.dest_ids.count(u))
+            return;
+        auto bag_it = state_.bags.find(u);
+        if (bag_it == state_.bags.end())
+            return;
+
+        for (LabelIndex l_idx : bag_it->second)
+        {
+            const Label &L = label_pool_[l_idx];
+            // 이번 라운드에 생성된 라벨은 다음 라운드에서 처리
+            if (L.created_round >= round)
+                continue;
+
+            // A. Scanning
+            const auto &next_stops = data_.get_next_stations(u, L.current_line);
+            auto process_dir = [&](const std::vector<StationID> &targets, Direction dir)
+            {
+                double cum_time = 0;
+                StationID prev = u;
+                for (StationID v : targets)
                 {
-                    const Label L = label_pool_[l_idx];
-                    // if (round == 2)
-                    // {
-                    //     std::cerr << "[DEBUG R2] Processing Stn: " << u
-                    //               << " (" << data_.get_code(u) << ")"
-                    //               << " Line: " << L.current_line << std::endl;
-                    // }
-                    if (L.created_round >= round)
-                        continue;
-                    if (dest_ids.count(u))
+                    if (check_visited(l_idx, v))
                         continue;
 
-                    // A. Scanning
-                    auto next_stops = data_.get_next_stations(u, L.current_line);
-                    // if (round == 2 && (next_stops.up.size() > 50 || next_stops.down.size() > 50))
-                    // {
-                    //     std::cerr << "[WARNING] Suspiciously many next stops for Stn " << u << std::endl;
-                    // }
-                    auto process_dir = [&](const std::vector<StationID> &targets, Direction dir)
-                    {
-                        double cum_time = 0;
-                        StationID prev = u;
-                        for (StationID v : targets)
-                        {
-                            if (check_visited(l_idx, v))
-                                continue;
-
-                            const auto &s1 = data_.get_station(prev);
-                            const auto &s2 = data_.get_station(v);
-                            double dist = PathfindingUtils::haversine(s1.latitude, s1.longitude, s2.latitude, s2.longitude);
-                            double seg_time = dist / 550.0;
-                            cum_time += std::max(seg_time, 1.0);
-
-                            double current_time = departure_time + (L.arrival_time + cum_time) * 60;
-                            std::string time_col = PathfindingUtils::get_time_column(current_time);
-                            double seg_cong = data_.get_congestion(prev, L.current_line, dir, day_type, time_col);
-                            double new_cong_sum = L.congestion_sum + seg_cong;
-
-                            LabelIndex new_idx = create_label(l_idx, v, L.current_line, dir, L.transfers,
-                                                              L.arrival_time + cum_time,
-                                                              L.convenience_sum, // 이동 중 점수 추가 X
-                                                              new_cong_sum, L.max_transfer_difficulty,
-                                                              L.depth + 1, false, round);
-
-                            bool dominated = false;
-                            for (LabelIndex ex : bags[v])
-                            {
-                                if (dominates(label_pool_[ex], label_pool_[new_idx], weights))
-                                {
-                                    dominated = true;
-                                    break;
-                                }
-                            }
-                            if (!dominated)
-                            {
-                                bags[v].push_back(new_idx);
-                                next_marked.insert(v);
-                            }
-                            prev = v;
-                        }
-                    };
-                    process_dir(next_stops.up, Direction::UP);
-                    process_dir(next_stops.down, Direction::DOWN);
-                    process_dir(next_stops.in, Direction::IN);
-                    process_dir(next_stops.out, Direction::OUT);
-
-                    // 수정!!!
-                    // B. Transfer
-                    // auto lines = data_.get_lines(u);
-
-                    auto next_lines = data_.get_transfer_lines(u);
-                    for (const auto &next_line : next_lines)
+                    cum_time += segment_minutes(prev, v);
+                    double seg_cong = segment_congestion(prev, L.current_line, dir, L.arrival_time + cum_time);
+                    double new_cong_sum = L.congestion_sum + seg_cong;
+
+                    out.push_back({make_label(l_idx, v, L.current_line, dir, L.transfers,
+                                              L.arrival_time + cum_time,
+                                              L.convenience_sum, // 이동 중 점수 추가 X
+                                              new_cong_sum, L.max_transfer_difficulty,
+                                              L.depth + 1, false, round),
+                                   false});
+                    prev = v;
+                }
+            };
+            process_dir(next_stops.up, Direction::UP);
+            process_dir(next_stops.down, Direction::DOWN);
+            process_dir(next_stops.in, Direction::IN);
+            process_dir(next_stops.out, Direction::OUT);
+
+            // B. Transfer (환승 시 역 ID가 변경됨: u -> 환승 목적지 ID)
+            for (const auto &next_line : data_.get_transfer_lines(u))
+            {
+                if (next_line == L.current_line)
+                    continue;
+                Candidate c{Label(), true};
+                if (make_transfer_label(l_idx, next_line, round, c.label))
+                    out.push_back(std::move(c));
+            }
+        }
+    }
+
+    void McRaptorEngine::merge_candidate(Candidate &&c, std::unordered_set<StationID> &marked)
+    {
+        // 목표 가지치기는 라벨 풀에 넣기 전에 판정 (버려질 라벨을 생성하지 않음)
+        if (bounded_by_target(c.label))
+        {
+            stats_.labels_pruned++;
+            return;
+        }
+        label_pool_.push_back(std::move(c.label));
+        LabelIndex new_idx = static_cast<LabelIndex>(label_pool_.size()) - 1;
+        const Label &nl = label_pool_[new_idx];
+        StationID v = nl.station_id;
+
+        // 환승: "환승한 역(v)"의 bag에서 같은 노선(next_line) 라벨과 비교
+        auto &bag = state_.bags[v];
+        bool dominated = false;
+        for (LabelIndex ex : bag)
+        {
+            if ((!c.transfer || label_pool_[ex].current_line == nl.current_line) &&
+                dominates(label_pool_[ex], nl, state_.weights))
+            {
+                dominated = true;
+                break;
+            }
+        }
+        if (dominated)
+        {
+            stats_.labels_dominated++;
+        }
+        else if (bag_has_room(v, bag))
+        {
+            bag.push_back(new_idx);
+            marked.insert(v);
+        }
+    }
+
+    bool McRaptorEngine::bag_has_room(StationID v, const std::vector<LabelIndex> &bag)
+    {
+        if (effort_.max_bag_size == 0 || bag.size() < effort_.max_bag_size || state_.dest_ids.count(v))
+            return true;
+        stats_.labels_capped++;
+        return false;
+    }
+
+    void McRaptorEngine::scan_parallel(const std::vector<StationID> &queue, int round,
+                                       std::unordered_set<StationID> &marked)
+    {
+        // 스레드별 후보 버퍼(라벨 아레나)에 역 단위로 스캔, 역 i의 후보 = arenas[owner[i]][ranges[i]]
+        constexpr size_t CHUNK = 8;
+        const size_t n = queue.size();
+        const size_t workers = std::min(static_cast<size_t>(parallel_threads_), (n + CHUNK - 1) / CHUNK);
+        std::vector<std::vector<Candidate>> arenas(workers);
+        std::vector<std::pair<size_t, size_t>> ranges(n);
+        std::vector<uint32_t> owner(n);
+        std::vector<std::exception_ptr> errors(workers);
+        std::atomic<size_t> next{0};
+
+        auto work = [&](size_t w)
+        {
+            try
+            {
+                auto &arena = arenas[w];
+                for (size_t begin; (begin = next.fetch_add(CHUNK)) < n;)
+                {
+                    for (size_t i = begin; i < std::min(n, begin + CHUNK); ++i)
                     {
-                        if (next_line == L.current_line)
-                            continue;
-
-                        const TransferData *td = data_.get_transfer(u, L.current_line, next_line);
-                        if (!td)
-                            continue;
-
-                        double dist = td->distance;
-                        double t_time = dist / (walk_speed * 60.0);
-                        double station_score = data_.get_station_convenience(u, dtype);
-                        double new_conv_sum = L.convenience_sum + station_score;
-                        double diff = PathfindingUtils::calculate_transfer_difficulty(dist, new_conv_sum, disability_type_str);
-
-                        // 핵심 수정!!!
-                        // 환승 시 역 ID가 변경되어야 합니다 (u -> td->to_station_id)
-                        StationID next_station_id = td->to_station_id;
-
-                        LabelIndex new_idx = create_label(l_idx,
-                                                          next_station_id, // u 대신 환승 목적지 ID 사용
-                                                          next_line,
-                                                          Direction::UNKNOWN,
-                                                          L.transfers + 1,
-                                                          L.arrival_time + t_time,
-                                                          new_conv_sum,
-                                                          L.congestion_sum,
-                                                          std::max(L.max_transfer_difficulty, diff),
-                                                          L.depth + 1, true, round);
-
-                        bool dominated = false;
-
-                        // 핵심 수정!!!
-                        // "환승한 역(next_station_id)"의 가방(bags)을 검사해야 합니다.
-                        for (LabelIndex ex : bags[next_station_id]) // bags[u] 대신 bags[next_station_id]
-                        {
-                            // 환승한 역에서는 노선이 next_line이어야 하므로 조건 일치
-                            if (label_pool_[ex].current_line == next_line &&
-                                dominates(label_pool_[ex], label_pool_[new_idx], weights))
-                            {
-                                dominated = true;
-                                break;
-                            }
-                        }
-                        if (!dominated)
-                        {
-                            bags[next_station_id].push_back(new_idx); // bags[next_station_id]
-                            next_marked.insert(next_station_id);      // next_marked
-                        }
+                        size_t first = arena.size();
+                        scan_station(queue[i], round, arena);
+                        ranges[i] = {first, arena.size()};
+                        owner[i] = static_cast<uint32_t>(w);
                     }
                 }
             }
-            marked_stations = next_marked;
-        }
+            catch (...)
+            {
+                errors[w] = std::current_exception();
+                next.store(n); // 나머지 스레드도 조기 종료
+            }
+        };
 
-        std::vector<Label> results;
-        for (StationID d : dest_ids)
+        ScanHelpers::instance().run(workers, work);
+        for (auto &e : errors)
+            if (e)
+                std::rethrow_exception(e);
+
+        // 역 처리 순서대로 병합 (순차 실행과 같은 라벨 인덱스/지배 판정)
+        for (size_t i = 0; i < n; ++i)
         {
-            for (LabelIndex idx : bags[d])
-                results.push_back(label_pool_[idx]);
+            auto &arena = arenas[owner[i]];
+            for (size_t k = ranges[i].first; k < ranges[i].second; ++k)
+                merge_candidate(std::move(arena[k]), marked);
         }
-        return results;
     }
 
     std::vector<Label> McRaptorEngine::rank_routes(
@@ -236,54 +832,202 @@ namespace pathfinding
         return ranked_routes;
     }
 
-    std::vector<Label> McRaptorEngine::reconstruct_path(const Label &leaf_label)
+    void McRaptorEngine::reconstruct_stops(const Label &leaf_label, std::vector<PathStop> &out) const
     {
-        std::vector<Label> path;
-        Label current = leaf_label;
-        path.push_back(current);
+        out.clear();
+        std::vector<const Label *> chain{&leaf_label};
+        for (LabelIndex idx = leaf_label.parent_index; idx != -1; idx = label_pool_[idx].parent_index)
+            chain.push_back(&label_pool_[idx]);
+        std::reverse(chain.begin(), chain.end());
 
-        while (current.parent_index != -1)
+        const Label *prev = chain[0];
+        out.push_back({prev->station_id, data_.line_id(prev->current_line)});
+        for (size_t i = 1; i < chain.size(); ++i)
         {
-            current = label_pool_[current.parent_index];
-            path.push_back(current);
+            const Label *curr = chain[i];
+            int32_t line = data_.line_id(curr->current_line);
+            if (prev->current_line != curr->current_line)
+            {
+                if (curr->station_id != prev->station_id)
+                    out.push_back({curr->station_id, line});
+            }
+            else
+            {
+                data_.append_intermediate_stops(prev->station_id, curr->station_id, line, out);
+            }
+            prev = curr;
         }
-        std::reverse(path.begin(), path.end());
+    }
+
+    std::vector<PathStop> McRaptorEngine::reconstruct_stops(const Label &leaf_label) const
+    {
+        std::vector<PathStop> stops;
+        reconstruct_stops(leaf_label, stops);
+        return stops;
+    }
 
-        std::vector<Label> complete_route;
-        for (size_t i = 0; i < path.size(); ++i)
+    RouteSet McRaptorEngine::make_route_set(const std::vector<Label> &ranked) const
+    {
+        RouteSet set;
+        set.reserve(ranked.size());
+        std::vector<PathStop> stops;
+        for (const auto &leaf : ranked)
         {
-            if (i == 0)
-            {
-                complete_route.push_back(path[i]);
+            reconstruct_stops(leaf, stops);
+            set.append(leaf, stops);
+        }
+        return set;
+    }
+
+    std::vector<Label> McRaptorEngine::escalate(std::vector<Label> routes, int escalated_rounds)
+    {
+        if (routes.empty() && escalated_rounds > state_.completed_rounds && state_.active && !state_.aborted)
+            return resume_routes(escalated_rounds);
+        return routes;
+    }
+
+    double McRaptorEngine::segment_minutes(StationID from, StationID to) const
+    {
+        const auto &s1 = data_.get_station(from);
+        const auto &s2 = data_.get_station(to);
+        return PathfindingUtils::ride_minutes(
+            PathfindingUtils::haversine(s1.latitude, s1.longitude, s2.latitude, s2.longitude));
+    }
+
+    double McRaptorEngine::segment_congestion(StationID from, const std::string &line, Direction dir,
+                                              double arrival_minutes) const
+    {
+        double current_time = state_.departure_time + arrival_minutes * 60;
+        std::string time_col = PathfindingUtils::get_time_column(current_time);
+        return data_.get_congestion(from, line, dir, state_.day_type, time_col);
+    }
+
+    LabelIndex McRaptorEngine::create_transfer_label(LabelIndex parent, const std::string &next_line, int round)
+    {
+        Label l;
+        if (!make_transfer_label(parent, next_line, round, l))
+            return -1;
+        label_pool_.push_back(std::move(l));
+        return (LabelIndex)label_pool_.size() - 1;
+    }
+
+    bool McRaptorEngine::make_transfer_label(LabelIndex parent, const std::string &next_line, int round,
+                                             Label &out) const
+    {
+        const Label &L = label_pool_[parent];
+        const TransferData *td = data_.get_transfer(L.station_id, L.current_line, next_line);
+        if (!td)
+            return false;
+
+        double dist = td->distance;
+        double t_time = dist / (state_.walk_speed * 60.0);
+        double station_score = data_.get_station_convenience(L.station_id, state_.dtype);
+        double new_conv_sum = L.convenience_sum + station_score;
+        double diff = PathfindingUtils::calculate_transfer_difficulty(dist, new_conv_sum, state_.disability_type);
+
+        out = make_label(parent, td->to_station_id, next_line, Direction::UNKNOWN,
+                         L.transfers + 1, L.arrival_time + t_time, new_conv_sum, L.congestion_sum,
+                         std::max(L.max_transfer_difficulty, diff), L.depth + 1, true, round);
+        return true;
+    }
+
+    LabelIndex McRaptorEngine::create_ride_label(LabelIndex parent, StationID target, Direction dir, int round)
+    {
+        // run_round의 방향별 스캔과 동일한 누적 방식 (방문역 건너뛰기 포함)
+        const Label L = label_pool_[parent];
+        const auto &next_stops = data_.get_next_stations(L.station_id, L.current_line);
+        const std::vector<StationID> *targets = nullptr;
+        switch (dir)
+        {
+        case Direction::UP:
+            targets = &next_stops.up;
+            break;
+        case Direction::DOWN:
+            targets = &next_stops.down;
+            break;
+        case Direction::IN:
+            targets = &next_stops.in;
+            break;
+        case Direction::OUT:
+            targets = &next_stops.out;
+            break;
+        default:
+            return -1;
+        }
+
+        double cum_time = 0;
+        double cong_sum = L.congestion_sum;
+        StationID prev = L.station_id;
+        for (StationID v : *targets)
+        {
+            if (check_visited(parent, v))
                 continue;
-            }
-            const Label &prev = path[i - 1];
-            const Label &curr = path[i];
+            cum_time += segment_minutes(prev, v);
+            cong_sum += segment_congestion(prev, L.current_line, dir, L.arrival_time + cum_time);
+            if (v == target)
+                return create_label(parent, v, L.current_line, dir, L.transfers, L.arrival_time + cum_time,
+                                    L.convenience_sum, cong_sum, L.max_transfer_difficulty, L.depth + 1, false, round);
+            prev = v;
+        }
+        return -1;
+    }
+
+    LabelIndex McRaptorEngine::create_footpath_label(LabelIndex parent, const Footpath &fp, int round)
+    {
+        const Label L = label_pool_[parent];
+        double walk_minutes = fp.minutes[static_cast<size_t>(state_.dtype)];
+        if (!std::isfinite(walk_minutes) || check_visited(parent, fp.to_station_id))
+            return -1;
+
+        // 다른 노선으로 갈아타므로 환승과 동일하게 환승 횟수/난이도/편의시설 점수 반영
+        double station_score = data_.get_station_convenience(L.station_id, state_.dtype);
+        double new_conv_sum = L.convenience_sum + station_score;
+        double diff = PathfindingUtils::calculate_transfer_difficulty(fp.distance, new_conv_sum, state_.disability_type);
+
+        return create_label(parent, fp.to_station_id, data_.get_station(fp.to_station_id).line, Direction::UNKNOWN,
+                            L.transfers + 1, L.arrival_time + walk_minutes, new_conv_sum, L.congestion_sum,
+                            std::max(L.max_transfer_difficulty, diff), L.depth + 1, true, round);
+    }
 
-            if (prev.current_line != curr.current_line)
+    void McRaptorEngine::relax_footpaths(LabelIndex parent, int round, std::unordered_set<StationID> &marked)
+    {
+        for (const Footpath &fp : data_.get_footpaths(label_pool_[parent].station_id))
+        {
+            LabelIndex new_idx = create_footpath_label(parent, fp, round);
+            if (new_idx == -1)
+                continue;
+            if (bounded_by_target(label_pool_[new_idx]))
             {
-                if (curr.station_id != prev.station_id)
-                    complete_route.push_back(curr);
+                stats_.labels_pruned++;
+                continue;
             }
-            else
+
+            auto &bag = state_.bags[fp.to_station_id];
+            bool dominated = false;
+            for (LabelIndex ex : bag)
             {
-                std::vector<StationID> intermediates = data_.get_intermediate_stations(
-                    prev.station_id, curr.station_id, curr.current_line);
-                for (StationID mid_id : intermediates)
+                if (dominates(label_pool_[ex], label_pool_[new_idx], state_.weights))
                 {
-                    Label mid_label = curr;
-                    mid_label.station_id = mid_id;
-                    complete_route.push_back(mid_label);
+                    dominated = true;
+                    break;
                 }
             }
+            if (dominated)
+            {
+                stats_.labels_dominated++;
+            }
+            else if (bag_has_room(fp.to_station_id, bag))
+            {
+                bag.push_back(new_idx);
+                marked.insert(fp.to_station_id);
+            }
         }
-        return complete_route;
     }
 
-    LabelIndex McRaptorEngine::create_label(
+    Label McRaptorEngine::make_label(
         LabelIndex parent, StationID sid, const std::string &line, Direction dir,
         int tr, double arr, double cv, double cg, double diff,
-        int dep, bool fm, int rd)
+        int dep, bool fm, int rd) const
     {
         Label l;
         l.parent_index = parent;
@@ -298,11 +1042,19 @@ namespace pathfinding
         l.depth = dep;
         l.is_first_move = fm;
         l.created_round = rd;
-        label_pool_.push_back(l);
+        return l;
+    }
+
+    LabelIndex McRaptorEngine::create_label(
+        LabelIndex parent, StationID sid, const std::string &line, Direction dir,
+        int tr, double arr, double cv, double cg, double diff,
+        int dep, bool fm, int rd)
+    {
+        label_pool_.push_back(make_label(parent, sid, line, dir, tr, arr, cv, cg, diff, dep, fm, rd));
         return (LabelIndex)label_pool_.size() - 1;
     }
 
-    bool McRaptorEngine::check_visited(LabelIndex curr, StationID target)
+    bool McRaptorEngine::check_visited(LabelIndex curr, StationID target) const
     {
         while (curr != -1)
         {
@@ -313,10 +1065,24 @@ namespace pathfinding
         return false;
     }
 
-    bool McRaptorEngine::dominates(const Label &a, const Label &b, const ANPWeights &w)
+    bool McRaptorEngine::dominates(const Label &a, const Label &b, const ANPWeights &w) const
     {
         if (a.transfers > b.transfers)
             return false;
+        if (effort_.epsilon > 0.0)
+        {
+            // 완화 지배: 허용 범위 안이면 동률도 지배 (먼저 들어온 라벨 유지)
+            const double slack = 1.0 + effort_.epsilon;
+            if (a.arrival_time > b.arrival_time * slack)
+                return false;
+            if (w.transfer_difficulty > 0.0 && a.max_transfer_difficulty > b.max_transfer_difficulty * slack)
+                return false;
+            if (w.congestion > 0.0 && a.avg_congestion() > b.avg_congestion() * slack)
+                return false;
+            if (w.convenience > 0.0 && a.avg_convenience() < b.avg_convenience() * (1.0 - effort_.epsilon))
+                return false;
+            return true;
+        }
         if (a.arrival_time > b.arrival_time)
             return false;
         if (w.transfer_difficulty > 0.0 && a.max_transfer_difficulty > b.max_transfer_difficulty)
@@ -1,12 +1,52 @@
 #pragma once
 #include "types.h"
 #include "data_loader.h"
+#include "route_set.h"
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 #include <string>
+#include <functional>
+#include <algorithm>
 
 namespace pathfinding
 {
+    // 스트리밍 탐색 콜백: (완료 라운드, 현재까지의 목적지 라벨 전체)
+    // false 반환 시 이후 라운드를 수행하지 않고 종료
+    using RouteCallback = std::function<bool(int round, const std::vector<Label> &routes)>;
+    // 라운드 경계 검사: (완료 라운드, 현재 목적지 라벨 수), false 반환 시 이후 라운드 생략
+    // (스케줄러가 우선순위 높은 요청을 위해 탐색 예산을 줄일 때 사용, 호출 스레드 = 탐색 스레드)
+    using RoundGuard = std::function<bool(int round, size_t routes_found)>;
+
+    // 다중 출발: 현재 위치(GPS)에서 후보 역까지의 도보 접근 구간
+    // 도보 시간은 장애 유형별 보행 속도로 환산되어 출발 라벨의 arrival_time이 됨
+    struct AccessLeg
+    {
+        std::string station_cd;
+        double distance_m = 0.0;
+    };
+
+    // 정수 ID 접근 구간 (DataContainer::find_id로 한 번 변환해 두면 탐색마다 역 코드를 해석하지 않음)
+    struct AccessLegId
+    {
+        StationID station_id = 0;
+        double distance_m = 0.0;
+    };
+
+    // 탐색 강도 (기본값 = 요청 라운드 수의 전체 Pareto 탐색)
+    // 부하가 높을 때 QueryPool이 정책 단계에 따라 낮춤
+    // - epsilon: 완화 지배, 기존 라벨이 환승 수는 같거나 적고 나머지 기준이 (1+epsilon)배 이내면 새 라벨 폐기
+    //   (소요 시간/혼잡도/환승 난이도는 배율, 편의도는 (1-epsilon)배 이상)
+    // - max_bag_size: 목적지를 제외한 역당 라벨 상한, 가득 찬 bag에는 새 라벨을 넣지 않음 (0이면 무제한)
+    // - max_rounds: 요청 라운드(확장 포함) 상한 (0이면 요청값)
+    struct SearchEffort
+    {
+        int level = 0; // 정책 단계 (기록용, 0 = 전체 탐색)
+        double epsilon = 0.0;
+        size_t max_bag_size = 0;
+        int max_rounds = 0;
+    };
+
     class McRaptorEngine
     {
     public:
@@ -19,17 +59,238 @@ namespace pathfinding
             const std::string &disability_type,
             int max_rounds);
 
+        // 다중 출발 탐색: 모든 접근 역을 round 0에 함께 시드하여 1회 탐색
+        // (같은 역이 여러 번 주어지면 가장 짧은 접근 거리 사용)
+        std::vector<Label> find_routes(
+            const std::vector<AccessLeg> &origins,
+            const std::unordered_set<std::string> &dest_cds,
+            double departure_time,
+            const std::string &disability_type,
+            int max_rounds);
+
+        // 라운드마다 목적지 라벨이 새로 생기면 on_update 호출 (첫 경로를 즉시 전달)
+        // 콜백은 데이터 읽기 잠금을 보유한 상태로 호출되므로 DataContainer 갱신 금지
+        std::vector<Label> find_routes_streaming(
+            const std::string &origin_cd,
+            const std::unordered_set<std::string> &dest_cds,
+            double departure_time,
+            const std::string &disability_type,
+            int max_rounds,
+            const RouteCallback &on_update);
+        std::vector<Label> find_routes_streaming(
+            const std::vector<AccessLeg> &origins,
+            const std::unordered_set<std::string> &dest_cds,
+            double departure_time,
+            const std::string &disability_type,
+            int max_rounds,
+            const RouteCallback &on_update);
+
+        // 정수 ID 질의 (역 코드 변환/문자열 해시 조회 없음, 범위 밖 ID는 std::runtime_error)
+        std::vector<Label> find_routes(
+            const std::vector<AccessLegId> &origins,
+            const std::vector<StationID> &dest_ids,
+            double departure_time,
+            const std::string &disability_type,
+            int max_rounds);
+        std::vector<Label> find_routes_streaming(
+            const std::vector<AccessLegId> &origins,
+            const std::vector<StationID> &dest_ids,
+            double departure_time,
+            const std::string &disability_type,
+            int max_rounds,
+            const RouteCallback &on_update);
+
+        // 직전 탐색(find_routes/find_routes_streaming)을 이어서 max_rounds까지 추가 라운드 수행
+        // 완료된 라운드의 라벨/bag은 재사용, 직전 탐색이 없거나 중단된 경우 std::runtime_error
+        std::vector<Label> resume_routes(int max_rounds);
+        int completed_rounds() const { return state_.completed_rounds; }
+
+        // 경로 이탈 후 재탐색: 현재 역에서 새로 탐색하되, 직전 탐색(동일 목적지/장애 유형)의
+        // 탐색 트리에서 현재 역을 지나 목적지에 도달한 잔여 구간을 현재 시각 기준으로 재계산하여
+        // 목적지 bag에 먼저 채움 (on_update가 있으면 round 0으로 즉시 전달)
+        // 복구 경로가 있으면 이후 라운드에서 목표 가지치기: 환승 수/도착 시각/최대 환승 난이도가
+        // 모두 목적지 경로 이상인 라벨은 버림 (평균 혼잡도/편의도만 더 나은 경로는 찾지 못할 수 있음)
+        std::vector<Label> reroute(
+            const std::string &current_cd,
+            const std::unordered_set<std::string> &dest_cds,
+            double current_time,
+            const std::string &disability_type,
+            int max_rounds,
+            const RouteCallback &on_update = RouteCallback());
+        // 다중 출발 재탐색: 접근 역마다 해당 역 이후 잔여 구간을 복구
+        std::vector<Label> reroute(
+            const std::vector<AccessLeg> &origins,
+            const std::unordered_set<std::string> &dest_cds,
+            double current_time,
+            const std::string &disability_type,
+            int max_rounds,
+            const RouteCallback &on_update = RouteCallback());
+        std::vector<Label> reroute(
+            const std::vector<AccessLegId> &origins,
+            const std::vector<StationID> &dest_ids,
+            double current_time,
+            const std::string &disability_type,
+            int max_rounds,
+            const RouteCallback &on_update = RouteCallback());
+
+        // 보관용 엔진의 여유 label_pool_ 용량 해제 (세션별 재탐색 캐시)
+        void shrink() { label_pool_.shrink_to_fit(); }
+
         std::vector<Label> rank_routes(
             const std::vector<Label> &routes,
             const std::string &disability_type);
 
-        // 경로 재구성 (중간역 포함)
-        std::vector<Label> reconstruct_path(const Label &leaf_label);
+        // 경로 재구성 (중간역 포함): 출발역부터 (역 ID, 노선 ID) 정차 순서로 out을 채움
+        // 라벨 복사 없이 부모 체인을 따라가고 중간역은 노선별 위치 배열 구간으로 추가
+        void reconstruct_stops(const Label &leaf_label, std::vector<PathStop> &out) const;
+        std::vector<PathStop> reconstruct_stops(const Label &leaf_label) const;
+        // 정렬된 목적지 라벨 -> RouteSet (경로 재구성까지 수행, 이후 label_pool_과 무관)
+        RouteSet make_route_set(const std::vector<Label> &ranked) const;
+
+        // 경로 미발견(routes 비어 있음) 시 완료된 라운드를 재사용해 escalated_rounds까지 확장
+        // (escalated_rounds가 완료 라운드 이하이거나 직전 탐색이 중단되었으면 routes 그대로)
+        std::vector<Label> escalate(std::vector<Label> routes, int escalated_rounds);
+
+        const SearchStats &last_stats() const { return stats_; }
+        const DataContainer &data() const { return data_; }
+
+        // 이후 모든 탐색(find/resume/reroute)에 적용, 빈 함수로 해제
+        void set_round_guard(RoundGuard guard) { round_guard_ = std::move(guard); }
+
+        // 이후 탐색에 적용 (진행 중인 탐색을 resume하면 새 값으로 이어서 수행)
+        void set_effort(const SearchEffort &effort) { effort_ = effort; }
+        const SearchEffort &effort() const { return effort_; }
+
+        // 라운드 내 병렬 처리: 마킹된 역의 스캔(후보 라벨 생성)을 스레드별 버퍼로 나눠 수행하고
+        // 라운드마다 역 처리 순서대로 병합 (순차 실행과 같은 결과/라벨 순서)
+        // threads <= 1 이면 비활성화, 켜져 있어도 라운드의 처리 대상 라벨이
+        // PARALLEL_MIN_FRONTIER_LABELS 이상일 때만 병렬 (작은 라운드는 동기화 비용이 더 큼)
+        // 보조 스레드는 라운드마다 만들지 않고 프로세스 공용 집합을 재사용 (가장 큰 threads - 1개),
+        // 여러 엔진이 동시에 병렬 라운드를 돌리면 보조 스레드를 나눠 쓰고 부족하면 호출 스레드가 나머지를 수행
+        static constexpr size_t PARALLEL_MIN_FRONTIER_LABELS = 2048;
+        void set_parallel_threads(int threads) { parallel_threads_ = std::max(threads, 1); }
+        int parallel_threads() const { return parallel_threads_; }
+
+        // reroute 목표 가지치기: 복구 경로(목적지 bag)보다 나쁘지 않을 수 없는 중간 라벨을 폐기
+        // 평균 편의도/혼잡도는 경로가 길어지며 좋아질 수 있어 근사 (순위가 새 탐색보다 나빠질 수 있음)
+        // 기본값 false: 평균 기준 가중치가 없는 장애 유형에서만 자동 적용 (그때는 결과 동일)
+        void set_target_pruning(bool enabled) { target_pruning_ = enabled; }
+        bool target_pruning() const { return target_pruning_; }
 
     private:
+        // 진행 중인 탐색 상태 (라운드 단위 실행/재개용)
+        struct SearchState
+        {
+            std::vector<StationID> origin_ids; // 시드된 출발역 (접근 거리 오름차순)
+            std::unordered_set<StationID> dest_ids;
+            double departure_time = 0.0;
+            std::string disability_type;
+            ANPWeights weights = {};
+            DisabilityType dtype = DisabilityType::PHY;
+            double walk_speed = 0.0;
+            std::string day_type;
+
+            std::unordered_map<StationID, std::vector<LabelIndex>> bags;
+            std::unordered_set<StationID> marked; // 다음 라운드에서 처리할 역
+            int completed_rounds = 0;
+            bool aborted = false;
+            bool active = false; // begin_search 이후 재개 가능
+            // 목표 가지치기 (reroute에서 복구 경로가 있고 set_target_pruning 또는 평균 기준 가중치 없음)
+            bool target_pruning = false;
+        };
+
+        // 재탐색용 경로 잔여 구간 (탐색 트리 간선 단위)
+        struct RouteStep
+        {
+            bool transfer;      // true: 환승, false: 같은 노선 주행
+            StationID station;  // 간선 도착역
+            std::string line;   // 도착 시 노선
+            Direction dir;      // 주행 방향 (환승은 UNKNOWN)
+            bool operator==(const RouteStep &o) const
+            {
+                return transfer == o.transfer && station == o.station && line == o.line && dir == o.dir;
+            }
+        };
+        struct RouteSuffix
+        {
+            std::string start_line;
+            std::vector<RouteStep> steps;
+        };
+
+        // 라운드 스캔 결과 (병합 시 label_pool_에 추가 후 지배 검사)
+        struct Candidate
+        {
+            Label label;
+            bool transfer; // 환승 라벨은 같은 노선 라벨과만 지배 비교
+        };
+
+        // 라운드당 처리 역 상한 (초과 시 앞쪽 역만 반영하고 탐색 중단)
+        static constexpr size_t MAX_ROUND_STATIONS = 5000;
+
         const DataContainer &data_;
         std::vector<Label> label_pool_;
+        SearchStats stats_;
+        SearchState state_;
+        int parallel_threads_ = 1;
+        bool target_pruning_ = false;
+        RoundGuard round_guard_;
+        SearchEffort effort_;
+
+        // 역 코드 질의 -> 정수 ID (알 수 없는 코드는 std::runtime_error)
+        std::vector<AccessLegId> resolve_origins(const std::vector<AccessLeg> &origins) const;
+        std::vector<StationID> resolve_dests(const std::unordered_set<std::string> &dest_cds) const;
+        // 범위 밖 ID 검사 후 목적지 집합 (std::runtime_error)
+        std::unordered_set<StationID> checked_dests(const std::vector<StationID> &dest_ids) const;
 
+        void begin_search(
+            const std::vector<AccessLegId> &origins,
+            const std::unordered_set<StationID> &dest_ids,
+            double departure_time,
+            const std::string &disability_type);
+        void run_rounds(int max_rounds, const RouteCallback *on_update);
+        bool run_round(int round); // 중단(큐 폭증) 시 false
+        // 역 u의 이전 라운드 라벨에서 주행/환승 후보 생성 (label_pool_/bag 읽기 전용, 스레드 안전)
+        void scan_station(StationID u, int round, std::vector<Candidate> &out) const;
+        // 후보를 순서대로 label_pool_에 추가하고 지배되지 않으면 bag에 반영
+        void merge_candidate(Candidate &&c, std::unordered_set<StationID> &marked);
+        // 지배되지 않은 라벨을 v의 bag에 넣을 수 있는지 (SearchEffort::max_bag_size)
+        bool bag_has_room(StationID v, const std::vector<LabelIndex> &bag);
+        void scan_parallel(const std::vector<StationID> &queue, int round, std::unordered_set<StationID> &marked);
+        size_t destination_label_count() const;
+        // 목적지가 아닌 역의 라벨 l이 목적지 bag의 경로보다 나아질 수 없는지 (state_.target_pruning일 때만)
+        // dominates가 쓰는 기준 전부 비교 (환승 수/도착 시각/최대 환승 난이도는 경로를 늘려도 줄지 않아 정확)
+        bool bounded_by_target(const Label &l) const;
+        std::vector<Label> collect_results() const;
+
+        std::vector<RouteSuffix> extract_suffixes(StationID from_id) const;
+        size_t replay_suffixes(StationID from_id, const std::vector<RouteSuffix> &suffixes);
+        bool passes_through(const Label &from, const Label &to, StationID station) const;
+
+        // 비용 계산 (run_round / 재탐색 공용)
+        double segment_minutes(StationID from, StationID to) const;
+        double segment_congestion(StationID from, const std::string &line, Direction dir, double arrival_minutes) const;
+        LabelIndex create_transfer_label(LabelIndex parent, const std::string &next_line, int round); // 환승 불가 시 -1
+        LabelIndex create_ride_label(LabelIndex parent, StationID target, Direction dir, int round);  // 도달 불가 시 -1
+        LabelIndex create_footpath_label(LabelIndex parent, const Footpath &fp, int round);       // 허용 도보 시간 초과 시 -1
+        // 라벨에서 도보 연결로 이동한 라벨 생성 후 지배되지 않으면 bag에 추가, 추가된 역을 marked에 기록
+        void relax_footpaths(LabelIndex parent, int round, std::unordered_set<StationID> &marked);
+
+        // 환승 라벨 값 계산 (환승 데이터 없으면 false)
+        bool make_transfer_label(LabelIndex parent, const std::string &next_line, int round, Label &out) const;
+
+        Label make_label(
+            LabelIndex parent_idx,
+            StationID station_id,
+            const std::string &line,
+            Direction dir,
+            int transfers,
+            double arrival_time,
+            double conv_sum,
+            double cong_sum,
+            double max_diff,
+            int depth,
+            bool first_move,
+            int round) const;
         LabelIndex create_label(
             LabelIndex parent_idx,
             StationID station_id,
@@ -44,7 +305,7 @@ namespace pathfinding
             bool first_move,
             int round);
 
-        bool check_visited(LabelIndex curr_idx, StationID target_id);
-        bool dominates(const Label &a, const Label &b, const ANPWeights &w);
+        bool check_visited(LabelIndex curr_idx, StationID target_id) const;
+        bool dominates(const Label &a, const Label &b, const ANPWeights &w) const;
     };
 }
\ No newline at end of file
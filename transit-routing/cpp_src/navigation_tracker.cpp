@@ -0,0 +1,148 @@
+#include "navigation_tracker.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+namespace pathfinding
+{
+    namespace
+    {
+        constexpr double TO_RAD = 3.14159265358979323846 / 180.0;
+    }
+
+    NavigationTracker::NavigationTracker(const DataContainer &data, double deviation_threshold_m)
+        : data_(data), threshold_m_(deviation_threshold_m) {}
+
+    int32_t NavigationTracker::start(const std::vector<std::string> &route_codes)
+    {
+        if (route_codes.empty())
+            throw std::runtime_error("Navigation route is empty");
+
+        // 전처리는 세션 잠금 밖에서 (get_id는 알 수 없는 코드면 예외)
+        ActiveRoute route;
+        route.active = true;
+        {
+            std::shared_lock<std::shared_mutex> lock(data_.update_mutex);
+            for (const auto &cd : route_codes)
+            {
+                const StationInfo &s = data_.get_station(data_.get_id(cd));
+                route.ids.push_back(s.id);
+                route.lats.push_back(s.latitude);
+                route.lons.push_back(s.longitude);
+            }
+        }
+
+        size_t n = route.ids.size();
+        route.unit = DistanceKernels::to_unit(route.lats.data(), route.lons.data(), n);
+        route.cum_minutes.assign(n, 0.0);
+        for (size_t i = 1; i < n; ++i)
+            route.cum_minutes[i] = route.cum_minutes[i - 1] +
+                                   PathfindingUtils::ride_minutes(PathfindingUtils::haversine(
+                                       route.lats[i - 1], route.lons[i - 1], route.lats[i], route.lons[i]));
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        int32_t handle;
+        if (!free_.empty())
+        {
+            handle = free_.back();
+            free_.pop_back();
+            routes_[handle] = std::move(route);
+        }
+        else
+        {
+            handle = static_cast<int32_t>(routes_.size());
+            routes_.push_back(std::move(route));
+        }
+        ++active_;
+        return handle;
+    }
+
+    bool NavigationTracker::end(int32_t handle)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (handle < 0 || static_cast<size_t>(handle) >= routes_.size() || !routes_[handle].active)
+            return false;
+        routes_[handle] = ActiveRoute(); // 배열 메모리 반환
+        free_.push_back(handle);
+        --active_;
+        return true;
+    }
+
+    size_t NavigationTracker::active_count() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return active_;
+    }
+
+    void NavigationTracker::update_batch(const int32_t *handles, const double *lats, const double *lons, size_t n,
+                                         NavUpdate *out) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = NavUpdate();
+            int32_t h = handles[i];
+            if (h < 0 || static_cast<size_t>(h) >= routes_.size() || !routes_[h].active)
+            {
+                out[i].flags = NavUpdate::UNKNOWN;
+                continue;
+            }
+            update_one(routes_[h], lats[i], lons[i], out[i]);
+        }
+    }
+
+    void NavigationTracker::update_one(const ActiveRoute &route, double lat, double lon, NavUpdate &out) const
+    {
+        const size_t n = route.ids.size();
+        const double phi = lat * TO_RAD, lambda = lon * TO_RAD;
+        const double qx = std::cos(phi) * std::cos(lambda);
+        const double qy = std::cos(phi) * std::sin(lambda);
+        const double qz = std::sin(phi);
+        const double *xs = route.unit.x.data();
+        const double *ys = route.unit.y.data();
+        const double *zs = route.unit.z.data();
+
+        // 1단계: 최소 제곱 현 길이 (분기 없는 min 축약이라 자동 벡터화 대상)
+        double best_d2 = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < n; ++i)
+        {
+            double dx = xs[i] - qx, dy = ys[i] - qy, dz = zs[i] - qz;
+            best_d2 = std::min(best_d2, dx * dx + dy * dy + dz * dz);
+        }
+        // 2단계: 최솟값을 갖는 첫 인덱스 (Python 구현과 동일하게 동률이면 앞쪽)
+        size_t idx = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double dx = xs[i] - qx, dy = ys[i] - qy, dz = zs[i] - qz;
+            if (dx * dx + dy * dy + dz * dz <= best_d2)
+            {
+                idx = i;
+                break;
+            }
+        }
+
+        out.progress_index = static_cast<int32_t>(idx);
+        out.current_station = route.ids[idx];
+        out.distance_to_route = PathfindingUtils::haversine(lat, lon, route.lats[idx], route.lons[idx]);
+
+        if (out.distance_to_route > threshold_m_)
+        {
+            out.flags |= NavUpdate::DEVIATED;
+            return;
+        }
+        if (idx + 1 == n)
+        {
+            out.flags |= NavUpdate::ARRIVED;
+            return;
+        }
+
+        out.next_station = route.ids[idx + 1];
+        out.distance_to_next = PathfindingUtils::haversine(lat, lon, route.lats[idx + 1], route.lons[idx + 1]);
+        double minutes = out.distance_to_next / PathfindingUtils::RIDE_METERS_PER_MINUTE +
+                         (route.cum_minutes[n - 1] - route.cum_minutes[idx + 1]);
+        out.eta_seconds = minutes * 60.0;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "types.h"
+#include "data_loader.h"
+#include "distance_kernels.h"
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace pathfinding
+{
+    // 위치 업데이트 1건의 안내 결과
+    struct NavUpdate
+    {
+        enum Flag : uint8_t
+        {
+            DEVIATED = 1, // 가장 가까운 경로 역이 이탈 임계 거리 밖
+            ARRIVED = 2,  // 가장 가까운 경로 역이 마지막 역
+            UNKNOWN = 4,  // 등록되지 않은(종료된) 세션 핸들
+        };
+
+        int32_t progress_index = -1;  // 경로상 매칭된 역 인덱스
+        int32_t current_station = -1; // 매칭된 역 StationID
+        int32_t next_station = -1;    // 다음 역 StationID (도착/이탈 시 -1)
+        double distance_to_route = 0.0; // 매칭된 역까지 거리 (m)
+        double distance_to_next = 0.0;  // 다음 역까지 거리 (m)
+        double eta_seconds = 0.0;       // 목적지까지 예상 주행 시간 (초, 환승 도보 제외)
+        uint8_t flags = 0;
+    };
+
+    // 안내 중인 세션의 경로 매칭/진행 추적
+    // - 경로는 StationID 배열 + 좌표(SoA) + 누적 주행 시간으로 등록 시 1회 전처리
+    // - update_batch는 세션 상태를 변경하지 않음 (동일 입력 -> 동일 결과, 공유 잠금으로 병렬 호출 가능)
+    // - 매칭은 GuidanceService와 동일한 규칙: 경로 역 중 haversine 거리가 가장 가까운 역 (동률이면 앞쪽)
+    //   단위 구 위 현(chord) 길이는 haversine 거리에 단조이므로 제곱 현 길이 최소로 같은 역을 고름
+    class NavigationTracker
+    {
+    public:
+        explicit NavigationTracker(const DataContainer &data, double deviation_threshold_m = 800.0);
+
+        // 경로 등록 (역 코드 순서), 반환값은 세션 핸들
+        // 알 수 없는 역 코드나 빈 경로는 std::runtime_error
+        int32_t start(const std::vector<std::string> &route_codes);
+        // 세션 종료 (핸들 재사용), 이미 종료된 핸들이면 false
+        bool end(int32_t handle);
+        size_t active_count() const;
+
+        // n개의 (핸들, 위도, 경도) 일괄 처리, out은 n개 이상
+        void update_batch(const int32_t *handles, const double *lats, const double *lons, size_t n,
+                          NavUpdate *out) const;
+
+    private:
+        struct ActiveRoute
+        {
+            bool active = false;
+            std::vector<StationID> ids;
+            std::vector<double> lats;
+            std::vector<double> lons;
+            DistanceKernels::UnitPoints unit; // 매칭용 단위 벡터 좌표
+            std::vector<double> cum_minutes; // 0번 역부터 i번 역까지 누적 주행 시간
+        };
+
+        void update_one(const ActiveRoute &route, double lat, double lon, NavUpdate &out) const;
+
+        const DataContainer &data_;
+        double threshold_m_;
+
+        mutable std::shared_mutex mutex_;
+        std::vector<ActiveRoute> routes_;
+        std::vector<int32_t> free_;
+        size_t active_ = 0;
+    };
+}
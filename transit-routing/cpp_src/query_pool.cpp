@@ -0,0 +1,357 @@
+#include "query_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+namespace pathfinding
+{
+    void LatencyWindow::add(double ms)
+    {
+        if (samples_.size() < CAPACITY)
+        {
+            samples_.push_back(ms);
+            return;
+        }
+        samples_[next_] = ms;
+        next_ = (next_ + 1) % CAPACITY;
+    }
+
+    double LatencyWindow::percentile(double p) const
+    {
+        if (samples_.empty())
+            return 0.0;
+        std::vector<double> sorted(samples_);
+        size_t k = static_cast<size_t>(std::ceil(p * sorted.size()));
+        k = std::min(sorted.size() - 1, k > 0 ? k - 1 : 0);
+        std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+        return sorted[k];
+    }
+
+    double LatencyWindow::max() const
+    {
+        if (samples_.empty())
+            return 0.0;
+        return *std::max_element(samples_.begin(), samples_.end());
+    }
+
+    QueryPool::QueryPool(const DataContainer &data, size_t threads, AdmissionPolicy policy,
+                         EffortPolicy effort_policy)
+        : data_(data), policy_(policy), effort_policy_(std::move(effort_policy))
+    {
+        counters_.effort_counts.assign(effort_policy_.size() + 1, 0);
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+            workers_.emplace_back(&QueryPool::worker_loop, this);
+    }
+
+    QueryPool::~QueryPool()
+    {
+        shutdown();
+    }
+
+    void QueryPool::submit(QueryRequest request, DoneFn done, StartFn start)
+    {
+        QueryResult refused;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            QueryPriority priority = request.priority;
+            PriorityClass &cls = classes_[class_index(priority)];
+            ++counters_.submitted;
+            ++cls.counters.submitted;
+            if (stopping_)
+            {
+                ++counters_.cancelled;
+                refused.cancelled = true;
+            }
+            else
+            {
+                refused.error = admission_error(priority);
+                if (refused.error.empty())
+                {
+                    cls.queue.push_back({std::move(request), std::move(done), std::move(start), Clock::now()});
+                    if (priority == QueryPriority::HIGH)
+                        high_waiting_.store(cls.queue.size(), std::memory_order_relaxed);
+                    counters_.peak_queued = std::max(counters_.peak_queued, queued_locked());
+                    cv_.notify_one();
+                    return;
+                }
+                ++counters_.rejected;
+                ++cls.counters.rejected;
+                refused.rejected = true;
+            }
+        }
+        done(std::move(refused));
+    }
+
+    void QueryPool::shutdown()
+    {
+        std::deque<Job> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            for (auto &cls : classes_)
+            {
+                for (auto &job : cls.queue)
+                    pending.push_back(std::move(job));
+                cls.queue.clear();
+            }
+            high_waiting_.store(0, std::memory_order_relaxed);
+            counters_.cancelled += pending.size();
+        }
+        cv_.notify_all();
+
+        for (auto &job : pending)
+        {
+            QueryResult cancelled;
+            cancelled.cancelled = true;
+            job.done(std::move(cancelled));
+        }
+        for (auto &w : workers_)
+            if (w.joinable())
+                w.join();
+    }
+
+    size_t QueryPool::queued() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queued_locked();
+    }
+
+    size_t QueryPool::queued_locked() const
+    {
+        size_t total = 0;
+        for (const auto &cls : classes_)
+            total += cls.queue.size();
+        return total;
+    }
+
+    size_t QueryPool::queued_ahead(QueryPriority priority) const
+    {
+        size_t ahead = 0;
+        for (size_t i = 0; i <= class_index(priority); ++i)
+            ahead += classes_[i].queue.size();
+        return ahead;
+    }
+
+    size_t QueryPool::running() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return running_;
+    }
+
+    QueryPoolStats QueryPool::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        QueryPoolStats out = counters_;
+        out.queued = queued_locked();
+        out.running = running_;
+        out.wait_ms_p50 = wait_window_.percentile(0.50);
+        out.wait_ms_p99 = wait_window_.percentile(0.99);
+        out.wait_ms_max = wait_window_.max();
+        out.service_ms_p50 = service_window_.percentile(0.50);
+        out.service_ms_p99 = service_window_.percentile(0.99);
+        out.estimated_wait_ms = estimated_wait_ms(QueryPriority::NORMAL);
+        for (size_t i = 0; i < QUERY_PRIORITY_COUNT; ++i)
+        {
+            const PriorityClass &cls = classes_[i];
+            QueryClassStats &c = out.classes[i];
+            c = cls.counters;
+            c.queued = cls.queue.size();
+            c.wait_ms_p50 = cls.wait_window.percentile(0.50);
+            c.wait_ms_p99 = cls.wait_window.percentile(0.99);
+            c.service_ms_p50 = cls.service_window.percentile(0.50);
+            c.service_ms_p99 = cls.service_window.percentile(0.99);
+            c.latency_ms_p50 = cls.latency_window.percentile(0.50);
+            c.latency_ms_p99 = cls.latency_window.percentile(0.99);
+        }
+        return out;
+    }
+
+    SearchEffort QueryPool::choose_effort()
+    {
+        if (++wait_samples_ % WAIT_P99_REFRESH == 0)
+            recent_wait_p99_ = wait_window_.percentile(0.99);
+
+        double queue_per_worker = static_cast<double>(queued_locked()) / workers_.size();
+        SearchEffort effort;
+        for (size_t i = 0; i < effort_policy_.size(); ++i)
+        {
+            const EffortLevel &lv = effort_policy_[i];
+            if ((lv.queue_per_worker > 0.0 && queue_per_worker >= lv.queue_per_worker) ||
+                (lv.wait_p99_ms > 0.0 && recent_wait_p99_ >= lv.wait_p99_ms))
+            {
+                effort = lv.effort;
+                effort.level = static_cast<int>(i) + 1;
+            }
+        }
+        counters_.effort_level = effort.level;
+        return effort;
+    }
+
+    double QueryPool::estimated_wait_ms(QueryPriority priority) const
+    {
+        // 유휴 워커가 있으면 즉시 실행
+        size_t ahead = queued_ahead(priority);
+        if (running_ + ahead < workers_.size())
+            return 0.0;
+        return (ahead + 1) * counters_.service_ms_avg / workers_.size();
+    }
+
+    std::string QueryPool::admission_error(QueryPriority priority) const
+    {
+        size_t waiting = queued_locked();
+        if (policy_.max_queue > 0 && waiting >= policy_.max_queue)
+            return "query queue full (" + std::to_string(waiting) + " waiting)";
+        if (policy_.max_wait_ms > 0.0 && priority != QueryPriority::LOW)
+        {
+            double estimate = estimated_wait_ms(priority);
+            if (estimate > policy_.max_wait_ms)
+                return "estimated queue wait " + std::to_string(static_cast<long>(estimate)) +
+                       "ms exceeds budget";
+        }
+        return std::string();
+    }
+
+    void QueryPool::worker_loop()
+    {
+        for (;;)
+        {
+            Job job;
+            PriorityClass *cls = nullptr;
+            double wait_ms = 0.0;
+            bool background = false;
+            SearchEffort effort;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]
+                         { return stopping_ || queued_locked() > 0; });
+                // 우선순위 순으로 첫 대기 작업
+                auto it = std::find_if(classes_.begin(), classes_.end(), [](const PriorityClass &c)
+                                       { return !c.queue.empty(); });
+                if (it == classes_.end())
+                    return; // stopping_
+                cls = &*it;
+                job = std::move(cls->queue.front());
+                cls->queue.pop_front();
+                if (job.request.priority == QueryPriority::HIGH)
+                    high_waiting_.store(cls->queue.size(), std::memory_order_relaxed);
+                ++running_;
+
+                wait_ms = std::chrono::duration<double, std::milli>(Clock::now() - job.enqueued).count();
+                cls->wait_window.add(wait_ms);
+                background = job.request.priority == QueryPriority::LOW;
+                if (!background)
+                {
+                    wait_window_.add(wait_ms);
+                    effort = choose_effort();
+                }
+            }
+
+            QueryResult result;
+            bool executed = false;
+            Clock::time_point started = Clock::now();
+            if (!background && policy_.max_wait_ms > 0.0 && wait_ms > policy_.max_wait_ms)
+            {
+                result.rejected = true;
+                result.error = "queue wait " + std::to_string(static_cast<long>(wait_ms)) + "ms exceeded budget";
+            }
+            else if (job.start && !job.start())
+            {
+                result.cancelled = true;
+            }
+            else
+            {
+                result = execute(job.request, effort);
+                executed = true;
+            }
+            double service_ms = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+
+            // 통계를 먼저 반영 (done 이후 조회하는 호출자가 이 작업을 포함한 값을 보도록)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --running_;
+                if (executed)
+                {
+                    ++counters_.completed;
+                    ++cls->counters.completed;
+                    ++counters_.effort_counts[effort.level];
+                    counters_.failed += !result.error.empty();
+                    cls->counters.preempted += result.preempted;
+                    service_window_.add(service_ms);
+                    cls->service_window.add(service_ms);
+                    cls->latency_window.add(wait_ms + service_ms);
+                    counters_.service_ms_avg = counters_.completed == 1
+                                                   ? service_ms
+                                                   : counters_.service_ms_avg +
+                                                         SERVICE_EWMA_ALPHA * (service_ms - counters_.service_ms_avg);
+                }
+                else if (result.rejected)
+                {
+                    ++counters_.shed;
+                    ++cls->counters.shed;
+                }
+                else
+                    ++counters_.cancelled;
+            }
+            job.done(std::move(result));
+        }
+    }
+
+    QueryResult QueryPool::execute(const QueryRequest &request, const SearchEffort &effort) const
+    {
+        QueryResult result;
+        std::unique_ptr<McRaptorEngine> owned;
+        McRaptorEngine *engine = request.engine;
+        if (!engine)
+        {
+            owned = std::make_unique<McRaptorEngine>(data_);
+            engine = owned.get();
+        }
+
+        engine->set_effort(effort);
+        result.effort_level = effort.level;
+
+        // NORMAL: HIGH 작업이 대기 중이면 경로를 찾은 시점의 라운드 경계에서 종료
+        // LOW: HIGH 작업이 대기 중이면 경로 유무와 관계없이 다음 라운드 경계에서 종료 (결과는 preempted)
+        if (request.priority == QueryPriority::NORMAL)
+            engine->set_round_guard([this](int, size_t routes_found)
+                                    { return routes_found == 0 || high_waiting_.load(std::memory_order_relaxed) == 0; });
+        else if (request.priority == QueryPriority::LOW)
+            engine->set_round_guard([this](int, size_t)
+                                    { return high_waiting_.load(std::memory_order_relaxed) == 0; });
+        try
+        {
+            std::vector<Label> routes;
+            if (request.reroute)
+                routes = engine->reroute(request.origins, request.dest_cds, request.departure_time,
+                                         request.disability_type, request.max_rounds, request.on_update);
+            else if (request.on_update)
+                routes = engine->find_routes_streaming(request.origins, request.dest_cds, request.departure_time,
+                                                       request.disability_type, request.max_rounds, request.on_update);
+            else
+                routes = engine->find_routes(request.origins, request.dest_cds, request.departure_time,
+                                             request.disability_type, request.max_rounds);
+            result.preempted = engine->last_stats().preempted;
+
+            // 경로 미발견 시 완료된 라운드를 재사용해 확장 (중단된 탐색은 재개 불가 -> 빈 결과 유지)
+            routes = engine->escalate(std::move(routes), request.escalated_rounds);
+
+            result.routes = engine->rank_routes(routes, request.disability_type);
+            if (request.build_route_set)
+                result.route_set = engine->make_route_set(result.routes);
+            result.engine = std::move(owned);
+        }
+        catch (const std::exception &e)
+        {
+            result.error = e.what();
+            if (result.error.empty())
+                result.error = "query failed";
+        }
+        // 반환된 엔진이 풀보다 오래 살 수 있으므로 검사 함수 해제, 이후 직접 탐색은 전체 탐색
+        engine->set_round_guard(RoundGuard());
+        engine->set_effort(SearchEffort());
+        return result;
+    }
+}
@@ -0,0 +1,241 @@
+#pragma once
+#include "types.h"
+#include "data_loader.h"
+#include "engine.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace pathfinding
+{
+    // 스케줄링 우선순위 (값이 작을수록 먼저 실행)
+    // - HIGH: 안내 중 경로 이탈 재탐색 (WebSocket)
+    // - NORMAL: 경로 조회 (REST)
+    // - LOW: 백그라운드 작업 (캐시 예열), HIGH/NORMAL 대기 작업이 없을 때만 시작
+    //   결과를 캐시에 저장하므로 탐색 강도 축소 없이 전체 탐색하고 대기 시간 예산도 적용하지 않음
+    //   HIGH 작업이 대기 중이면 라운드 경계에서 바로 종료 (preempted 결과, 캐시에 저장하지 않음)
+    //   (대기 시간은 풀 전체 대기 통계와 탐색 강도 결정에서 제외)
+    enum class QueryPriority
+    {
+        HIGH = 0,
+        NORMAL = 1,
+        LOW = 2,
+    };
+    constexpr size_t QUERY_PRIORITY_COUNT = 3;
+
+    // 비동기 경로 탐색 요청 (PathfindingServiceCPP.calculate_route와 동일한 단계)
+    struct QueryRequest
+    {
+        std::vector<AccessLeg> origins;
+        std::unordered_set<std::string> dest_cds;
+        double departure_time = 0.0;
+        std::string disability_type;
+        int max_rounds = 0;
+        // 경로 미발견 시 resume_routes로 확장할 라운드 (max_rounds 이하이면 확장 안 함)
+        int escalated_rounds = 0;
+        QueryPriority priority = QueryPriority::NORMAL;
+        // 호출자 소유 엔진 (선택, 완료 전까지 다른 곳에서 사용 금지), 없으면 워커가 생성
+        McRaptorEngine *engine = nullptr;
+        bool reroute = false;   // engine의 직전 탐색 트리를 재사용 (McRaptorEngine::reroute)
+        RouteCallback on_update; // 라운드별 중간 결과 (워커 스레드에서 호출)
+        bool build_route_set = false; // 결과 경로 재구성까지 워커에서 수행 (QueryResult::route_set)
+    };
+
+    // 탐색 결과: 경로 재구성을 위해 엔진 소유권을 함께 넘김
+    struct QueryResult
+    {
+        std::unique_ptr<McRaptorEngine> engine; // 워커가 생성한 엔진 (요청에 엔진이 있으면 비어 있음)
+        std::vector<Label> routes; // rank_routes 정렬 결과 (목적지 라벨 전체)
+        RouteSet route_set;        // build_route_set 요청 시 routes의 재구성 결과
+        std::string error;         // 탐색 중 예외 메시지 또는 거절 사유 (비어 있으면 성공)
+        bool cancelled = false;    // 실행 전 취소 또는 풀 종료
+        bool rejected = false;     // 과부하: 제출 거절 또는 대기 예산 초과로 폐기 (탐색 안 함)
+        bool preempted = false;    // 우선순위 높은 요청 대기로 라운드 예산이 줄어든 결과
+        int effort_level = 0;      // 적용된 탐색 강도 단계 (0 = 전체 탐색)
+    };
+
+    // 과부하 제어 (0이면 해당 제한 없음)
+    // - max_queue: 전체 대기 작업 수(모든 우선순위 합)가 상한이면 제출 즉시 거절
+    // - max_wait_ms: 대기 시간 예산
+    //   제출 시 예상 대기(앞선 대기 작업 수 / 워커 수 * 최근 평균 처리 시간)가 예산을 넘으면 거절하고,
+    //   꺼낸 시점에 실제 대기가 예산을 넘은 작업은 탐색 없이 폐기 (이미 응답 시한을 놓친 요청)
+    struct AdmissionPolicy
+    {
+        size_t max_queue = 0;
+        double max_wait_ms = 0.0;
+    };
+
+    // 부하 적응 탐색 강도 단계
+    // 작업을 꺼낼 때 (남은 대기 작업 수 / 워커 수) >= queue_per_worker 이거나
+    // 최근 p99 대기 시간 >= wait_p99_ms 이면 해당 단계의 SearchEffort로 탐색 (0 이하 기준은 사용 안 함)
+    // 조건을 만족하는 가장 높은 단계 적용, effort.level은 단계 번호(1부터)로 덮어씀
+    struct EffortLevel
+    {
+        double queue_per_worker = 0.0;
+        double wait_p99_ms = 0.0;
+        SearchEffort effort;
+    };
+    using EffortPolicy = std::vector<EffortLevel>; // 낮은 단계부터, 비어 있으면 항상 전체 탐색
+
+    // 우선순위별 통계 (백분위수는 최근 LatencyWindow::CAPACITY건 기준)
+    struct QueryClassStats
+    {
+        uint64_t submitted = 0;
+        uint64_t completed = 0;
+        uint64_t rejected = 0;
+        uint64_t shed = 0;
+        uint64_t preempted = 0; // 라운드 예산이 줄어든 채 완료
+        size_t queued = 0;
+        double wait_ms_p50 = 0.0;
+        double wait_ms_p99 = 0.0;
+        double service_ms_p50 = 0.0;
+        double service_ms_p99 = 0.0;
+        double latency_ms_p50 = 0.0; // 대기 + 수행
+        double latency_ms_p99 = 0.0;
+    };
+
+    // 풀 상태/지연 통계 (백분위수는 최근 LatencyWindow::CAPACITY건 기준)
+    struct QueryPoolStats
+    {
+        uint64_t submitted = 0; // 제출 (거절 포함)
+        uint64_t completed = 0; // 탐색 수행 (오류 포함)
+        uint64_t failed = 0;    // 탐색 중 예외
+        uint64_t rejected = 0;  // 제출 시 거절 (대기열 상한/예상 대기 초과)
+        uint64_t shed = 0;      // 대기 예산 초과로 폐기
+        uint64_t cancelled = 0; // 실행 전 취소 또는 종료
+        size_t queued = 0;
+        size_t running = 0;
+        size_t peak_queued = 0;
+        double wait_ms_p50 = 0.0; // 대기열 대기 시간
+        double wait_ms_p99 = 0.0;
+        double wait_ms_max = 0.0;
+        double service_ms_p50 = 0.0; // 탐색 수행 시간
+        double service_ms_p99 = 0.0;
+        double service_ms_avg = 0.0;   // 지수 이동 평균 (예상 대기 계산용)
+        double estimated_wait_ms = 0.0; // 지금 NORMAL로 제출하면 예상되는 대기 시간
+        int effort_level = 0;                 // 마지막으로 시작한 작업의 탐색 강도 단계
+        std::vector<uint64_t> effort_counts;  // 단계별 완료 작업 수 (0 = 전체 탐색)
+        std::array<QueryClassStats, QUERY_PRIORITY_COUNT> classes; // QueryPriority 순
+    };
+
+    // 최근 N건 지연 시간 (링 버퍼, 호출자가 잠금 관리)
+    class LatencyWindow
+    {
+    public:
+        static constexpr size_t CAPACITY = 1024;
+
+        void add(double ms);
+        // p: 0~1, 표본이 없으면 0
+        double percentile(double p) const;
+        double max() const;
+
+    private:
+        std::vector<double> samples_;
+        size_t next_ = 0;
+    };
+
+    // 고정 크기 워커 풀
+    // - 요청마다 워커가 새 엔진을 생성해 탐색 (팩토리 패턴과 동일, DataContainer는 읽기 잠금으로 공유)
+    // - 우선순위 큐: HIGH 대기 작업을 항상 먼저 꺼냄
+    //   HIGH 작업이 대기 중이면 실행 중인 NORMAL 작업은 라운드 경계에서 예산을 줄임
+    //   (목적지 경로를 하나 이상 찾았으면 남은 라운드/확장을 생략하고 현재 결과로 완료)
+    //   LOW 작업은 경로 유무와 관계없이 라운드 경계에서 종료
+    // - start: 워커가 작업을 꺼낸 직후 호출, false면 실행 없이 cancelled로 완료 (선택)
+    // - done: 워커 스레드에서 정확히 1회 호출 (종료 시 대기 작업은 cancelled)
+    class QueryPool
+    {
+    public:
+        using StartFn = std::function<bool()>;
+        using DoneFn = std::function<void(QueryResult &&)>;
+
+        // threads == 0 이면 hardware_concurrency
+        QueryPool(const DataContainer &data, size_t threads, AdmissionPolicy policy = AdmissionPolicy(),
+                  EffortPolicy effort_policy = EffortPolicy());
+        ~QueryPool();
+
+        QueryPool(const QueryPool &) = delete;
+        QueryPool &operator=(const QueryPool &) = delete;
+
+        // 종료 후 제출은 즉시 cancelled, 과부하면 즉시 rejected로 완료 (호출 스레드에서 done 호출)
+        void submit(QueryRequest request, DoneFn done, StartFn start = StartFn());
+        // 대기 작업 취소 후 실행 중인 작업 완료까지 대기 (중복 호출 가능)
+        void shutdown();
+
+        size_t thread_count() const { return workers_.size(); }
+        size_t queued() const;
+        size_t running() const;
+        const AdmissionPolicy &policy() const { return policy_; }
+        const EffortPolicy &effort_policy() const { return effort_policy_; }
+        QueryPoolStats stats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Job
+        {
+            QueryRequest request;
+            DoneFn done;
+            StartFn start;
+            Clock::time_point enqueued;
+        };
+
+        // 우선순위별 대기열과 지연 창 (mutex_ 보호)
+        struct PriorityClass
+        {
+            std::deque<Job> queue;
+            QueryClassStats counters;
+            LatencyWindow wait_window;
+            LatencyWindow service_window;
+            LatencyWindow latency_window;
+        };
+
+        // 처리 시간 지수 이동 평균 가중치
+        static constexpr double SERVICE_EWMA_ALPHA = 0.2;
+        // 탐색 강도 결정에 쓰는 p99 대기 시간 갱신 주기 (대기 표본 수)
+        static constexpr size_t WAIT_P99_REFRESH = 64;
+
+        const DataContainer &data_;
+        const AdmissionPolicy policy_;
+        const EffortPolicy effort_policy_;
+        std::vector<std::thread> workers_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::array<PriorityClass, QUERY_PRIORITY_COUNT> classes_;
+        size_t running_ = 0;
+        bool stopping_ = false;
+        // HIGH 대기 작업 수 (NORMAL 탐색의 라운드 경계 검사용, 잠금 없이 읽음)
+        std::atomic<size_t> high_waiting_{0};
+
+        // 통계 (mutex_ 보호)
+        QueryPoolStats counters_;
+        LatencyWindow wait_window_;
+        LatencyWindow service_window_;
+        double recent_wait_p99_ = 0.0;
+        size_t wait_samples_ = 0;
+
+        // 아래는 mutex_ 보유 상태에서 호출
+        size_t queued_locked() const;
+        // priority 작업보다 먼저 실행될 대기 작업 수
+        size_t queued_ahead(QueryPriority priority) const;
+        // 제출 거절 사유 (허용이면 빈 문자열)
+        std::string admission_error(QueryPriority priority) const;
+        double estimated_wait_ms(QueryPriority priority) const;
+        // 현재 부하에 맞는 탐색 강도 (작업을 꺼낸 직후)
+        SearchEffort choose_effort();
+
+        void worker_loop();
+        QueryResult execute(const QueryRequest &request, const SearchEffort &effort) const;
+        static size_t class_index(QueryPriority priority) { return static_cast<size_t>(priority); }
+    };
+}
@@ -0,0 +1,265 @@
+#include "query_sketch.h"
+#include "data_loader.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pathfinding
+{
+    namespace
+    {
+        size_t round_up_pow2(size_t n)
+        {
+            size_t p = 1;
+            while (p < n)
+                p <<= 1;
+            return p;
+        }
+
+        QuerySketchOptions checked(QuerySketchOptions options)
+        {
+            options.width = round_up_pow2(std::max<size_t>(options.width, 64));
+            options.depth = std::clamp<size_t>(options.depth, 1, 16);
+            options.top_k = std::max<size_t>(options.top_k, 1);
+            options.epochs = std::clamp<size_t>(options.epochs, 1, QuerySketch::MAX_EPOCHS);
+            if (!(options.window_seconds > 0.0))
+                options.window_seconds = QuerySketchOptions().window_seconds;
+            return options;
+        }
+    }
+
+    QuerySketch::QuerySketch(const DataContainer &data, QuerySketchOptions options)
+        : data_(data),
+          options_(checked(options)),
+          width_mask_(options_.width - 1),
+          epoch_seconds_(options_.window_seconds / static_cast<double>(options_.epochs)),
+          cell_stride_(round_up_pow2(options_.epochs)),
+          counts_(new std::atomic<uint32_t>[options_.depth * options_.width * cell_stride_]),
+          candidates_(new Candidate[round_up_pow2(options_.top_k * 4)]),
+          candidate_mask_(round_up_pow2(options_.top_k * 4) - 1)
+    {
+        clear();
+    }
+
+    QuerySketch::Key QuerySketch::make_key(StationID origin, StationID destination, DisabilityType profile, int slot)
+    {
+        return (Key(origin) << 32) | (Key(destination) << 16) | (Key(static_cast<uint8_t>(profile)) << 8) |
+               Key(static_cast<uint8_t>(slot));
+    }
+
+    // splitmix64 마무리 단계 (행별 열 번호는 상/하위 32비트로 이중 해싱)
+    uint64_t QuerySketch::mix(Key key)
+    {
+        uint64_t z = key + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    std::atomic<uint32_t> *QuerySketch::cell(size_t row, size_t col) const
+    {
+        return &counts_[(row * options_.width + col) * cell_stride_];
+    }
+
+    uint64_t QuerySketch::window_sum(const std::atomic<uint32_t> *cell) const
+    {
+        uint64_t sum = 0;
+        for (size_t e = 0; e < options_.epochs; ++e)
+            sum += cell[e].load(std::memory_order_relaxed);
+        return sum;
+    }
+
+    int QuerySketch::time_slot(double timestamp) const
+    {
+        uint64_t bucket = static_cast<uint64_t>(std::floor(timestamp / 1800.0)) & (~uint64_t(0) >> 8);
+        uint64_t cached = slot_cache_.load(std::memory_order_relaxed);
+        if ((cached >> 8) == bucket)
+            return static_cast<int>(cached & 0xFF);
+        int slot = PathfindingUtils::get_time_slot(timestamp);
+        slot_cache_.store((bucket << 8) | static_cast<uint64_t>(slot), std::memory_order_relaxed);
+        return slot;
+    }
+
+    void QuerySketch::record(StationID origin, StationID destination, DisabilityType profile, double departure_time)
+    {
+        int64_t epoch = static_cast<int64_t>(std::floor(departure_time / epoch_seconds_));
+        int64_t current = current_epoch_.load(std::memory_order_acquire);
+        if (epoch > current && advance(epoch))
+            current = epoch;
+        size_t epoch_slot = current < 0 ? 0 : static_cast<size_t>(current) % options_.epochs;
+
+        Key key = make_key(origin, destination, profile, time_slot(departure_time));
+        uint64_t h = mix(key);
+        uint32_t h1 = static_cast<uint32_t>(h);
+        uint32_t h2 = static_cast<uint32_t>(h >> 32) | 1;
+        uint64_t count = std::numeric_limits<uint64_t>::max();
+        for (size_t row = 0; row < options_.depth; ++row)
+        {
+            std::atomic<uint32_t> *c = cell(row, (h1 + row * h2) & width_mask_);
+            c[epoch_slot].fetch_add(1, std::memory_order_relaxed);
+            count = std::min(count, window_sum(c));
+        }
+
+        offer(key, count);
+    }
+
+    bool QuerySketch::record(const std::string &origin_cd, const std::string &destination_cd,
+                             const std::string &disability_type, double departure_time)
+    {
+        int32_t origin = data_.find_id(origin_cd);
+        int32_t destination = data_.find_id(destination_cd);
+        if (origin < 0 || destination < 0)
+            return false;
+        record(static_cast<StationID>(origin), static_cast<StationID>(destination),
+               PathfindingUtils::str_to_disability(disability_type), departure_time);
+        return true;
+    }
+
+    uint64_t QuerySketch::estimate(StationID origin, StationID destination, DisabilityType profile, int slot) const
+    {
+        return estimate_key(make_key(origin, destination, profile, slot));
+    }
+
+    uint64_t QuerySketch::estimate_key(Key key) const
+    {
+        uint64_t h = mix(key);
+        uint32_t h1 = static_cast<uint32_t>(h);
+        uint32_t h2 = static_cast<uint32_t>(h >> 32) | 1;
+        uint64_t best = std::numeric_limits<uint64_t>::max();
+        for (size_t row = 0; row < options_.depth; ++row)
+            best = std::min(best, window_sum(cell(row, (h1 + row * h2) & width_mask_)));
+        return best;
+    }
+
+    void QuerySketch::offer(Key key, uint64_t count)
+    {
+        const Key tagged = key | OCCUPIED;
+        size_t start = static_cast<size_t>(mix(key) >> 40);
+        Candidate *victim = nullptr;
+        Key victim_key = 0;
+        uint64_t victim_count = std::numeric_limits<uint64_t>::max();
+        for (size_t i = 0; i < PROBES; ++i)
+        {
+            Candidate &c = candidates_[(start + i) & candidate_mask_];
+            Key k = c.key.load(std::memory_order_relaxed);
+            if (k == 0)
+            {
+                if (c.key.compare_exchange_strong(k, tagged, std::memory_order_relaxed))
+                    k = tagged;
+            }
+            if (k == tagged)
+            {
+                c.count.store(count, std::memory_order_relaxed);
+                return;
+            }
+            uint64_t n = c.count.load(std::memory_order_relaxed);
+            if (n < victim_count)
+            {
+                victim = &c;
+                victim_key = k;
+                victim_count = n;
+            }
+        }
+        // 탐사 범위가 가득 참: 추정값이 가장 작은 후보보다 크면 교체 (경합 시 교체 생략)
+        if (victim && count > victim_count &&
+            victim->key.compare_exchange_strong(victim_key, tagged, std::memory_order_relaxed))
+            victim->count.store(count, std::memory_order_relaxed);
+    }
+
+    bool QuerySketch::advance(int64_t epoch)
+    {
+        std::unique_lock<std::mutex> lock(rotate_mutex_, std::try_to_lock);
+        if (!lock.owns_lock())
+            return false;
+        int64_t current = current_epoch_.load(std::memory_order_acquire);
+        if (epoch <= current)
+            return true;
+
+        // 창에서 빠지는 구간 비우기 (한 창 이상 건너뛰면 전체)
+        const int64_t epochs = static_cast<int64_t>(options_.epochs);
+        int64_t first = std::max(current + 1, epoch - epochs + 1);
+        for (int64_t e = first; e <= epoch; ++e)
+        {
+            size_t slot = static_cast<size_t>(e % epochs);
+            for (size_t i = 0; i < options_.depth * options_.width; ++i)
+                counts_[i * cell_stride_ + slot].store(0, std::memory_order_relaxed);
+        }
+        current_epoch_.store(epoch, std::memory_order_release);
+
+        // 후보 추정값 갱신, 창에서 사라진 후보는 비움 (교체 기준이 오래된 값에 묶이지 않도록)
+        for (size_t i = 0; i <= candidate_mask_; ++i)
+        {
+            Candidate &c = candidates_[i];
+            Key k = c.key.load(std::memory_order_relaxed);
+            if (k == 0)
+                continue;
+            uint64_t n = estimate_key(k & ~OCCUPIED);
+            if (n == 0)
+                c.key.compare_exchange_strong(k, 0, std::memory_order_relaxed);
+            c.count.store(n, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    std::vector<HeavyHitter> QuerySketch::top(size_t k) const
+    {
+        if (k == 0)
+            k = options_.top_k;
+
+        std::vector<Key> keys;
+        for (size_t i = 0; i <= candidate_mask_; ++i)
+        {
+            Key key = candidates_[i].key.load(std::memory_order_relaxed);
+            if (key != 0)
+                keys.push_back(key & ~OCCUPIED);
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        std::vector<HeavyHitter> out;
+        out.reserve(keys.size());
+        for (Key key : keys)
+        {
+            uint64_t count = estimate_key(key);
+            if (count == 0)
+                continue;
+            HeavyHitter hh;
+            hh.origin = static_cast<StationID>(key >> 32);
+            hh.destination = static_cast<StationID>(key >> 16);
+            hh.profile = static_cast<DisabilityType>(static_cast<uint8_t>(key >> 8));
+            hh.slot = static_cast<int>(key & 0xFF);
+            hh.count = count;
+            out.push_back(hh);
+        }
+        std::sort(out.begin(), out.end(), [](const HeavyHitter &a, const HeavyHitter &b)
+                  { return a.count != b.count ? a.count > b.count
+                                              : std::tie(a.origin, a.destination, a.profile, a.slot) <
+                                                    std::tie(b.origin, b.destination, b.profile, b.slot); });
+        if (out.size() > k)
+            out.resize(k);
+        return out;
+    }
+
+    uint64_t QuerySketch::total() const
+    {
+        // 기록마다 행 0의 카운터 하나가 증가하므로 행 0 전체 합 = 창 내 기록 수
+        uint64_t sum = 0;
+        for (size_t col = 0; col < options_.width; ++col)
+            sum += window_sum(cell(0, col));
+        return sum;
+    }
+
+    void QuerySketch::clear()
+    {
+        std::lock_guard<std::mutex> lock(rotate_mutex_);
+        for (size_t i = 0; i < options_.depth * options_.width * cell_stride_; ++i)
+            counts_[i].store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i <= candidate_mask_; ++i)
+        {
+            candidates_[i].key.store(0, std::memory_order_relaxed);
+            candidates_[i].count.store(0, std::memory_order_relaxed);
+        }
+        current_epoch_.store(-1, std::memory_order_release);
+    }
+}
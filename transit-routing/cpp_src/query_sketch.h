@@ -0,0 +1,106 @@
+#pragma once
+#include "types.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pathfinding
+{
+    class DataContainer;
+
+    struct QuerySketchOptions
+    {
+        size_t width = 1 << 14; // 행당 카운터 수 (2의 거듭제곱으로 올림)
+        size_t depth = 4;       // 해시 행 수 (추정 오차 확률 ~ e^-depth)
+        size_t top_k = 64;      // 유지할 상위 항목 수 (후보 테이블은 4배)
+        double window_seconds = 3600.0;
+        size_t epochs = 6; // 창을 나누는 구간 수 (1~16, 구간 단위로 오래된 집계 폐기)
+    };
+
+    // 상위 빈도 질의 (origin, destination, profile, slot)
+    struct HeavyHitter
+    {
+        StationID origin = 0;
+        StationID destination = 0;
+        DisabilityType profile = DisabilityType::PHY;
+        int slot = 0;       // 출발 시각 30분 단위 슬롯 (0~47, PathfindingUtils::get_time_slot)
+        uint64_t count = 0; // 창 내 추정 빈도 (해시 충돌로 과대 추정, 구간 전환 경계의 몇 건은 빠질 수 있음)
+    };
+
+    // 질의 빈도 스트리밍 집계: 슬라이딩 창 count-min sketch + 상위 K 후보 테이블
+    // - 키: (출발역 ID, 도착역 ID, 장애 유형, 30분 슬롯) 48비트
+    // - 창: depth x width 칸마다 epochs개 구간 카운터를 한 캐시 라인에 둠
+    //   기록 시각(departure_time)이 다음 구간으로 넘어가면 가장 오래된 구간을 비우고 재사용
+    //   (창 기준 시각은 마지막 기록 시각, 기록이 없으면 집계가 그대로 유지됨)
+    // - 추정: 행마다 칸의 구간 합 중 최솟값
+    //   기록 1건 = 행마다 캐시 라인 1개에 relaxed fetch_add 1회 + 같은 라인 읽기 (공유 전역 카운터 없음)
+    // - 상위 K: 기록마다 추정값으로 후보 테이블(선형 탐사 8칸) 갱신, 가득 차면 추정값이 더 작은 후보를 교체
+    //   top()은 후보를 창 기준으로 다시 추정해 정렬
+    // 기록 경로는 잠금 없음 (relaxed 원자 연산), 구간 전환은 한 스레드만 try_lock으로 수행하고
+    // 나머지는 전환이 끝날 때까지 이전 구간에 기록 (경계의 몇 건은 인접 구간으로 집계될 수 있음)
+    class QuerySketch
+    {
+    public:
+        static constexpr size_t MAX_EPOCHS = 16; // 칸 크기 <= 64바이트
+
+        QuerySketch(const DataContainer &data, QuerySketchOptions options = QuerySketchOptions());
+
+        QuerySketch(const QuerySketch &) = delete;
+        QuerySketch &operator=(const QuerySketch &) = delete;
+
+        void record(StationID origin, StationID destination, DisabilityType profile, double departure_time);
+        // 역 코드 입력 (DataContainer::find_id), 알 수 없는 역이면 기록하지 않고 false
+        bool record(const std::string &origin_cd, const std::string &destination_cd,
+                    const std::string &disability_type, double departure_time);
+
+        uint64_t estimate(StationID origin, StationID destination, DisabilityType profile, int slot) const;
+        // 추정 빈도 내림차순 상위 k개 (k == 0 이면 options.top_k)
+        std::vector<HeavyHitter> top(size_t k = 0) const;
+        // 창 내 전체 기록 수
+        uint64_t total() const;
+        void clear();
+
+        const QuerySketchOptions &options() const { return options_; }
+        const DataContainer &data() const { return data_; }
+        // 30분 슬롯 (같은 30분 구간의 시각은 마지막 변환 결과를 재사용해 localtime 호출 생략)
+        int time_slot(double timestamp) const;
+
+    private:
+        using Key = uint64_t;
+        static constexpr Key OCCUPIED = Key(1) << 63; // 후보 테이블 빈 칸(0)과 구분
+        static constexpr size_t PROBES = 8;
+
+        struct Candidate
+        {
+            std::atomic<Key> key{0};
+            std::atomic<uint64_t> count{0};
+        };
+
+        const DataContainer &data_;
+        const QuerySketchOptions options_;
+        const size_t width_mask_;
+        const double epoch_seconds_;
+        const size_t cell_stride_; // epochs를 2의 거듭제곱으로 올림
+
+        // [행][열][구간] 카운터
+        std::unique_ptr<std::atomic<uint32_t>[]> counts_;
+        std::unique_ptr<Candidate[]> candidates_;
+        const size_t candidate_mask_;
+
+        std::atomic<int64_t> current_epoch_{-1};
+        mutable std::atomic<uint64_t> slot_cache_{~uint64_t(0)}; // (30분 구간 번호 << 8) | 슬롯
+        std::mutex rotate_mutex_;
+
+        static Key make_key(StationID origin, StationID destination, DisabilityType profile, int slot);
+        static uint64_t mix(Key key);
+        std::atomic<uint32_t> *cell(size_t row, size_t col) const;
+        uint64_t window_sum(const std::atomic<uint32_t> *cell) const;
+        uint64_t estimate_key(Key key) const;
+        void offer(Key key, uint64_t count);
+        // epoch까지 구간 전환 (잠금을 얻지 못하면 false, 다른 스레드가 전환 중)
+        bool advance(int64_t epoch);
+    };
+}
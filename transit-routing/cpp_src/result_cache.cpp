@@ -0,0 +1,336 @@
+#include "result_cache.h"
+#include "data_loader.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pathfinding
+{
+    namespace
+    {
+        // 파일 형식 (호스트 바이트 순서, 같은 서버의 워커 간 공유 용도)
+        // 헤더: "KMRCACHE" | u32 형식 버전 | u32 0 | u64 network_fingerprint | u64 content_fingerprint | u64 항목 수
+        // 항목 (오래 사용되지 않은 것부터): u32 키 길이 | u32 페이로드 길이 | 키 | 페이로드
+        constexpr char FILE_MAGIC[8] = {'K', 'M', 'R', 'C', 'A', 'C', 'H', 'E'};
+        constexpr uint32_t FILE_VERSION = 1;
+        constexpr size_t HEADER_SIZE = sizeof(FILE_MAGIC) + 4 + 4 + 8 + 8 + 8;
+        constexpr size_t ENTRY_HEADER_SIZE = 4 + 4;
+
+        template <typename T>
+        void write_value(std::ostream &out, T v)
+        {
+            out.write(reinterpret_cast<const char *>(&v), sizeof(v));
+        }
+
+        template <typename T>
+        T read_value(const char *p)
+        {
+            T v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        // 저장 중 임시 파일 이름 (프로세스 ID + 프로세스 내 일련번호, 동시 저장끼리 겹치지 않도록)
+        std::string temp_path(const std::string &path)
+        {
+            static std::atomic<uint64_t> sequence{0};
+#ifdef _WIN32
+            long pid = static_cast<long>(_getpid());
+#else
+            long pid = static_cast<long>(getpid());
+#endif
+            return path + ".tmp." + std::to_string(pid) + "." + std::to_string(sequence.fetch_add(1));
+        }
+
+        // 읽기 전용 파일 매핑 (mmap이 없는 플랫폼은 전체를 읽어 보관)
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(const std::string &path)
+            {
+#ifdef _WIN32
+                std::ifstream in(path, std::ios::binary);
+                if (!in)
+                    return;
+                buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+                data_ = buffer_.data();
+                size_ = buffer_.size();
+                open_ = true;
+#else
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    if (errno == ENOENT)
+                        return;
+                    throw std::runtime_error("result cache: cannot open " + path);
+                }
+                struct stat st;
+                if (::fstat(fd, &st) != 0)
+                {
+                    ::close(fd);
+                    throw std::runtime_error("result cache: cannot stat " + path);
+                }
+                size_ = static_cast<size_t>(st.st_size);
+                if (size_ > 0)
+                {
+                    void *mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapped == MAP_FAILED)
+                    {
+                        ::close(fd);
+                        throw std::runtime_error("result cache: cannot map " + path);
+                    }
+                    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+                    data_ = static_cast<const char *>(mapped);
+                }
+                ::close(fd); // 매핑은 fd를 닫아도 유지
+                open_ = true;
+#endif
+            }
+
+            ~MappedFile()
+            {
+#ifndef _WIN32
+                if (data_)
+                    ::munmap(const_cast<char *>(data_), size_);
+#endif
+            }
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            bool is_open() const { return open_; }
+            const char *data() const { return data_; }
+            size_t size() const { return size_; }
+
+        private:
+            const char *data_ = nullptr;
+            size_t size_ = 0;
+            bool open_ = false;
+#ifdef _WIN32
+            std::string buffer_;
+#endif
+        };
+    }
+
+    ResultCache::ResultCache(const DataContainer &data, size_t capacity)
+        : data_(data), capacity_(capacity)
+    {
+        index_.reserve(capacity);
+    }
+
+    ResultCache::Payload ResultCache::get(const std::string &key)
+    {
+        uint64_t version = data_.data_version();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it == index_.end())
+        {
+            ++counters_.misses;
+            return nullptr;
+        }
+        if (it->second->data_version != version)
+        {
+            erase_locked(it->second);
+            ++counters_.stale;
+            ++counters_.misses;
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        ++counters_.hits;
+        return entries_.front().payload;
+    }
+
+    bool ResultCache::contains(const std::string &key) const
+    {
+        uint64_t version = data_.data_version();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        return it != index_.end() && it->second->data_version == version;
+    }
+
+    void ResultCache::put(const std::string &key, std::string payload, uint64_t data_version)
+    {
+        if (capacity_ == 0)
+            return;
+        auto value = std::make_shared<const std::string>(std::move(payload));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        insert_locked(key, std::move(value), data_version);
+        ++counters_.inserts;
+    }
+
+    void ResultCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        index_.clear();
+        counters_.bytes = 0;
+    }
+
+    size_t ResultCache::save(const std::string &path) const
+    {
+        uint64_t version = 0;
+        const uint64_t content = data_.content_fingerprint(&version);
+
+        // 페이로드는 공유 포인터라 잠금 안에서는 키 복사만 발생
+        std::vector<std::pair<std::string, Payload>> items;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items.reserve(entries_.size());
+            for (auto it = entries_.rbegin(); it != entries_.rend(); ++it)
+                if (it->data_version == version && it->key.size() <= UINT32_MAX && it->payload->size() <= UINT32_MAX)
+                    items.emplace_back(it->key, it->payload);
+        }
+
+        const std::string tmp = temp_path(path);
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out)
+                throw std::runtime_error("result cache: cannot write " + tmp);
+            out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+            write_value<uint32_t>(out, FILE_VERSION);
+            write_value<uint32_t>(out, 0);
+            write_value<uint64_t>(out, data_.network_fingerprint());
+            write_value<uint64_t>(out, content);
+            write_value<uint64_t>(out, items.size());
+            for (const auto &item : items)
+            {
+                write_value<uint32_t>(out, static_cast<uint32_t>(item.first.size()));
+                write_value<uint32_t>(out, static_cast<uint32_t>(item.second->size()));
+                out.write(item.first.data(), static_cast<std::streamsize>(item.first.size()));
+                out.write(item.second->data(), static_cast<std::streamsize>(item.second->size()));
+            }
+            out.close();
+            if (!out)
+            {
+                std::remove(tmp.c_str());
+                throw std::runtime_error("result cache: write failed " + tmp);
+            }
+        }
+
+#ifdef _WIN32
+        std::remove(path.c_str()); // rename이 기존 파일을 덮어쓰지 않음
+#endif
+        if (std::rename(tmp.c_str(), path.c_str()) != 0)
+        {
+            std::remove(tmp.c_str());
+            throw std::runtime_error("result cache: cannot replace " + path);
+        }
+        return items.size();
+    }
+
+    size_t ResultCache::load(const std::string &path)
+    {
+        MappedFile file(path);
+        if (!file.is_open())
+            return 0;
+        const char *base = file.data();
+        const size_t size = file.size();
+        if (size < HEADER_SIZE || std::memcmp(base, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+            throw std::runtime_error("result cache: not a cache file " + path);
+        if (read_value<uint32_t>(base + 8) != FILE_VERSION)
+            throw std::runtime_error("result cache: unsupported file version " + path);
+
+        const uint64_t network = read_value<uint64_t>(base + 16);
+        const uint64_t content = read_value<uint64_t>(base + 24);
+        const uint64_t count = read_value<uint64_t>(base + 32);
+        uint64_t version = 0;
+        if (network != data_.network_fingerprint() || content != data_.content_fingerprint(&version))
+            return 0;
+
+        // 구조를 먼저 모두 검증 (잘린 파일에서 일부만 복원하지 않음)
+        struct Span
+        {
+            const char *key;
+            uint32_t key_size;
+            const char *payload;
+            uint32_t payload_size;
+        };
+        std::vector<Span> spans;
+        spans.reserve(static_cast<size_t>(std::min<uint64_t>(count, (size - HEADER_SIZE) / ENTRY_HEADER_SIZE)));
+        size_t pos = HEADER_SIZE;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            if (size - pos < ENTRY_HEADER_SIZE)
+                throw std::runtime_error("result cache: truncated file " + path);
+            uint32_t key_size = read_value<uint32_t>(base + pos);
+            uint32_t payload_size = read_value<uint32_t>(base + pos + 4);
+            pos += ENTRY_HEADER_SIZE;
+            if (size - pos < static_cast<uint64_t>(key_size) + payload_size)
+                throw std::runtime_error("result cache: truncated file " + path);
+            spans.push_back({base + pos, key_size, base + pos + key_size, payload_size});
+            pos += static_cast<size_t>(key_size) + payload_size;
+        }
+        if (pos != size)
+            throw std::runtime_error("result cache: trailing data in " + path);
+
+        // 오래된 항목부터 넣어 LRU 순서 유지 (용량을 넘는 앞쪽 항목은 어차피 밀려나므로 건너뜀)
+        size_t adopted = 0;
+        size_t first = spans.size() > capacity_ ? spans.size() - capacity_ : 0;
+        for (size_t i = first; i < spans.size(); ++i)
+        {
+            const Span &span = spans[i];
+            std::string key(span.key, span.key_size);
+            auto value = std::make_shared<const std::string>(span.payload, span.payload_size);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (index_.count(key))
+                continue; // 시작 후 이미 계산된 결과가 더 최신
+            insert_locked(key, std::move(value), version);
+            ++counters_.restored;
+            ++adopted;
+        }
+        return adopted;
+    }
+
+    size_t ResultCache::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    ResultCacheStats ResultCache::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ResultCacheStats out = counters_;
+        out.size = entries_.size();
+        out.capacity = capacity_;
+        return out;
+    }
+
+    void ResultCache::insert_locked(const std::string &key, Payload value, uint64_t data_version)
+    {
+        auto it = index_.find(key);
+        if (it != index_.end())
+            erase_locked(it->second);
+        while (entries_.size() >= capacity_)
+        {
+            erase_locked(std::prev(entries_.end()));
+            ++counters_.evictions;
+        }
+
+        counters_.bytes += value->size();
+        entries_.push_front({key, std::move(value), data_version});
+        index_[key] = entries_.begin();
+    }
+
+    void ResultCache::erase_locked(EntryList::iterator it)
+    {
+        counters_.bytes -= it->payload->size();
+        index_.erase(it->key);
+        entries_.erase(it);
+    }
+}
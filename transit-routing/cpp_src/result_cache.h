@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace pathfinding
+{
+    class DataContainer;
+
+    struct ResultCacheStats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t stale = 0;     // 데이터 갱신 이전 결과라 폐기 (미스에 포함)
+        uint64_t inserts = 0;
+        uint64_t evictions = 0; // 용량 초과로 제거
+        size_t size = 0;
+        size_t capacity = 0;
+        size_t bytes = 0; // 저장된 페이로드 크기 합
+        uint64_t restored = 0; // 파일에서 복원한 항목 (load)
+    };
+
+    // 프로세스 내 경로 결과 캐시 (키: 서비스 cache_key, 값: route_payload.h 바이너리 페이로드)
+    // - 용량(항목 수) 초과 시 가장 오래 조회되지 않은 항목부터 제거 (LRU)
+    // - 항목마다 계산 시작 시점의 DataContainer::data_version을 기록하고,
+    //   조회 시 현재 버전과 다르면 폐기 후 미스 (혼잡도/편의시설 갱신 이전 결과를 반환하지 않음)
+    // - 풀 워커(CacheWarmer)와 Python 요청 스레드에서 동시 사용 가능 (단일 mutex, 조회당 해시 1회)
+    // - save/load로 재시작 간 보존 (data_version은 프로세스마다 다르므로 파일에는 내용 지문을 기록,
+    //   적재한 네트워크의 DataContainer::content_fingerprint와 같을 때만 복원)
+    class ResultCache
+    {
+    public:
+        using Payload = std::shared_ptr<const std::string>;
+
+        ResultCache(const DataContainer &data, size_t capacity);
+
+        // 없거나 오래된 항목이면 nullptr
+        Payload get(const std::string &key);
+        // 통계/LRU 순서를 바꾸지 않는 최신 항목 존재 확인
+        bool contains(const std::string &key) const;
+        // data_version: 결과 계산을 시작할 때 읽은 버전 (계산 중 갱신되었으면 저장 즉시 오래된 항목)
+        void put(const std::string &key, std::string payload, uint64_t data_version);
+        void clear();
+
+        // 현재 데이터 버전 항목을 파일로 저장 (임시 파일에 쓴 뒤 rename, 여러 프로세스가 같은 경로에 저장해도
+        // 마지막 저장본 하나가 온전히 남음), 저장한 항목 수 반환, 쓰기 실패 시 std::runtime_error
+        size_t save(const std::string &path) const;
+        // save로 만든 파일을 mmap해 현재 데이터 버전 항목으로 복원 (이미 있는 키는 유지)
+        // 파일이 없거나 지문(네트워크 ID 체계/데이터 내용)이 다르면 0, 형식이 잘못된 파일이면 std::runtime_error
+        size_t load(const std::string &path);
+
+        size_t size() const;
+        size_t capacity() const { return capacity_; }
+        const DataContainer &data() const { return data_; }
+        ResultCacheStats stats() const;
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            Payload payload;
+            uint64_t data_version;
+        };
+        using EntryList = std::list<Entry>; // 앞쪽이 최근 사용
+
+        void erase_locked(EntryList::iterator it);
+        // 같은 키 항목을 교체하고 용량 초과분을 제거한 뒤 맨 앞에 추가
+        void insert_locked(const std::string &key, Payload value, uint64_t data_version);
+
+        const DataContainer &data_;
+        const size_t capacity_;
+
+        mutable std::mutex mutex_;
+        EntryList entries_;
+        std::unordered_map<std::string, EntryList::iterator> index_;
+        ResultCacheStats counters_;
+    };
+}
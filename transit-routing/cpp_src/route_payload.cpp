@@ -0,0 +1,435 @@
+#include "route_payload.h"
+#include "data_loader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace pathfinding
+{
+    namespace
+    {
+        // 응답 딕셔너리 반올림 자릿수 (_build_routes_info와 동일)
+        constexpr int TIME_DIGITS = 1;
+        constexpr int SCORE_DIGITS = 4;
+        constexpr int METRIC_DIGITS = 2;
+
+        int64_t quantize(double value, int digits)
+        {
+            return std::llround(value * std::pow(10.0, digits));
+        }
+
+        double dequantize(int64_t q, int digits)
+        {
+            return static_cast<double>(q) / std::pow(10.0, digits);
+        }
+
+        size_t route_count(const RouteSet &routes, size_t max_routes)
+        {
+            return std::min(routes.size(), max_routes);
+        }
+
+        uint64_t total_found(const RouteSet &routes, const RoutePayloadMeta &meta)
+        {
+            return std::max<uint64_t>(meta.total_routes_found, routes.size());
+        }
+
+        // ---------------- 바이너리 ----------------
+
+        void put_varint(std::string &out, uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<char>(v));
+        }
+
+        void put_signed(std::string &out, int64_t v)
+        {
+            put_varint(out, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+        }
+
+        void put_string(std::string &out, const std::string &s)
+        {
+            put_varint(out, s.size());
+            out += s;
+        }
+
+        class Reader
+        {
+        public:
+            explicit Reader(const std::string &buf) : buf_(buf) {}
+
+            uint8_t byte()
+            {
+                need(1);
+                return static_cast<uint8_t>(buf_[pos_++]);
+            }
+
+            uint64_t varint()
+            {
+                uint64_t v = 0;
+                for (int shift = 0; shift < 64; shift += 7)
+                {
+                    uint8_t b = byte();
+                    v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                    if (!(b & 0x80))
+                        return v;
+                }
+                fail("varint too long");
+            }
+
+            int64_t signed_varint()
+            {
+                uint64_t v = varint();
+                return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+            }
+
+            // 남은 바이트 수를 넘는 개수는 거부 (요소마다 최소 1바이트)
+            size_t count()
+            {
+                uint64_t n = varint();
+                if (n > buf_.size() - pos_)
+                    fail("count exceeds payload size");
+                return static_cast<size_t>(n);
+            }
+
+            std::string string()
+            {
+                size_t n = count();
+                std::string s = buf_.substr(pos_, n);
+                pos_ += n;
+                return s;
+            }
+
+            uint64_t fixed64()
+            {
+                uint64_t v = 0;
+                for (int i = 0; i < 8; ++i)
+                    v |= static_cast<uint64_t>(byte()) << (8 * i);
+                return v;
+            }
+
+            bool done() const { return pos_ == buf_.size(); }
+
+            [[noreturn]] void fail(const std::string &why) const
+            {
+                throw std::runtime_error("Invalid route payload: " + why);
+            }
+
+        private:
+            void need(size_t n) const
+            {
+                if (buf_.size() - pos_ < n)
+                    fail("truncated");
+            }
+
+            const std::string &buf_;
+            size_t pos_ = 0;
+        };
+
+        // ---------------- JSON ----------------
+
+        void put_json_string(std::string &out, const std::string &s)
+        {
+            out.push_back('"');
+            for (char ch : s)
+            {
+                auto c = static_cast<unsigned char>(ch);
+                switch (c)
+                {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                case '\b':
+                    out += "\\b";
+                    break;
+                case '\f':
+                    out += "\\f";
+                    break;
+                default:
+                    if (c < 0x20)
+                    {
+                        char esc[8];
+                        std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+                        out += esc;
+                    }
+                    else
+                    {
+                        out.push_back(ch); // UTF-8 그대로 (ensure_ascii=False)
+                    }
+                }
+            }
+            out.push_back('"');
+        }
+
+        // 양자화 정수 -> Python repr(round(x, digits))와 같은 10진 표기 (소수점 이하 최소 1자리)
+        void put_json_fixed(std::string &out, int64_t q, int digits)
+        {
+            if (q < 0)
+                out.push_back('-');
+            uint64_t mag = q < 0 ? static_cast<uint64_t>(-(q + 1)) + 1 : static_cast<uint64_t>(q);
+            uint64_t scale = 1;
+            for (int i = 0; i < digits; ++i)
+                scale *= 10;
+
+            out += std::to_string(mag / scale);
+            out.push_back('.');
+            std::string frac = std::to_string(mag % scale);
+            frac.insert(0, static_cast<size_t>(digits) - frac.size(), '0');
+            while (frac.size() > 1 && frac.back() == '0')
+                frac.pop_back();
+            out += frac;
+        }
+
+        void put_json_key(std::string &out, const char *key, bool first = false)
+        {
+            if (!first)
+                out += ", ";
+            out.push_back('"');
+            out += key;
+            out += "\": ";
+        }
+
+        const std::string &line_of(const DataContainer &data, int32_t line_id)
+        {
+            static const std::string empty;
+            return line_id < 0 ? empty : data.line_name(static_cast<LineID>(line_id));
+        }
+    }
+
+    std::string encode_route_payload(const RouteSet &routes, const DataContainer &data,
+                                     const RoutePayloadMeta &meta, size_t max_routes)
+    {
+        size_t n = route_count(routes, max_routes);
+        std::string out(ROUTE_PAYLOAD_MAGIC, sizeof(ROUTE_PAYLOAD_MAGIC));
+        out.push_back(static_cast<char>(ROUTE_PAYLOAD_VERSION));
+        uint64_t fingerprint = data.network_fingerprint();
+        for (int i = 0; i < 8; ++i)
+            out.push_back(static_cast<char>((fingerprint >> (8 * i)) & 0xFF));
+
+        put_varint(out, static_cast<uint64_t>(std::max(meta.effort_level, 0)));
+        put_varint(out, total_found(routes, meta));
+        put_string(out, meta.origin);
+        put_string(out, meta.origin_cd);
+        put_string(out, meta.destination);
+        put_string(out, meta.destination_cd);
+
+        put_varint(out, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            put_varint(out, static_cast<uint64_t>(std::max(routes.transfers[i], 0)));
+            put_signed(out, quantize(routes.arrival_time[i], TIME_DIGITS));
+            put_signed(out, quantize(routes.score[i], SCORE_DIGITS));
+            put_signed(out, quantize(routes.avg_convenience[i], METRIC_DIGITS));
+            put_signed(out, quantize(routes.avg_congestion[i], METRIC_DIGITS));
+            put_signed(out, quantize(routes.max_transfer_difficulty[i], METRIC_DIGITS));
+
+            size_t begin = routes.path_begin(i);
+            size_t end = routes.path_end(i);
+            put_varint(out, end - begin);
+            for (size_t k = begin; k < end; ++k)
+                put_varint(out, static_cast<uint64_t>(routes.path_stations[k]));
+
+            // 노선은 구간 단위 (경로당 환승 수 + 1개)
+            size_t runs = 0;
+            for (size_t k = begin; k < end; ++k)
+                runs += k == begin || routes.path_lines[k] != routes.path_lines[k - 1];
+            put_varint(out, runs);
+            for (size_t k = begin; k < end;)
+            {
+                size_t run_end = k;
+                while (run_end < end && routes.path_lines[run_end] == routes.path_lines[k])
+                    ++run_end;
+                put_varint(out, static_cast<uint64_t>(routes.path_lines[k] + 1));
+                put_varint(out, run_end - k);
+                k = run_end;
+            }
+        }
+        return out;
+    }
+
+    RoutePayload decode_route_payload(const std::string &payload, const DataContainer &data)
+    {
+        Reader in(payload);
+        for (char c : ROUTE_PAYLOAD_MAGIC)
+            if (in.byte() != static_cast<uint8_t>(c))
+                in.fail("bad magic");
+        uint8_t version = in.byte();
+        if (version != ROUTE_PAYLOAD_VERSION)
+            in.fail("unsupported version " + std::to_string(version));
+        if (in.fixed64() != data.network_fingerprint())
+            in.fail("network fingerprint mismatch (station data changed)");
+
+        RoutePayload result;
+        RoutePayloadMeta &meta = result.meta;
+        meta.effort_level = static_cast<int>(in.varint());
+        meta.total_routes_found = in.varint();
+        meta.origin = in.string();
+        meta.origin_cd = in.string();
+        meta.destination = in.string();
+        meta.destination_cd = in.string();
+
+        RouteSet &routes = result.routes;
+        size_t n = in.count();
+        routes.reserve(n);
+        size_t station_count = data.station_count();
+        size_t line_count = data.line_names().size();
+        for (size_t i = 0; i < n; ++i)
+        {
+            routes.transfers.push_back(static_cast<int32_t>(in.varint()));
+            routes.arrival_time.push_back(dequantize(in.signed_varint(), TIME_DIGITS));
+            routes.score.push_back(dequantize(in.signed_varint(), SCORE_DIGITS));
+            routes.avg_convenience.push_back(dequantize(in.signed_varint(), METRIC_DIGITS));
+            routes.avg_congestion.push_back(dequantize(in.signed_varint(), METRIC_DIGITS));
+            routes.max_transfer_difficulty.push_back(dequantize(in.signed_varint(), METRIC_DIGITS));
+
+            size_t stops = in.count();
+            for (size_t k = 0; k < stops; ++k)
+            {
+                uint64_t sid = in.varint();
+                if (sid >= station_count)
+                    in.fail("station id out of range");
+                routes.path_stations.push_back(static_cast<int32_t>(sid));
+            }
+
+            size_t runs = in.count();
+            size_t covered = 0;
+            for (size_t r = 0; r < runs; ++r)
+            {
+                uint64_t line = in.varint();
+                uint64_t length = in.varint();
+                if (line > line_count || length > stops - covered)
+                    in.fail("bad line run");
+                routes.path_lines.insert(routes.path_lines.end(), length, static_cast<int32_t>(line) - 1);
+                covered += length;
+            }
+            if (covered != stops)
+                in.fail("line runs do not cover stops");
+            routes.path_offsets.push_back(static_cast<int64_t>(routes.path_stations.size()));
+        }
+        if (!in.done())
+            in.fail("trailing bytes");
+        return result;
+    }
+
+    std::string route_payload_json(const RouteSet &routes, const DataContainer &data,
+                                   const RoutePayloadMeta &meta, size_t max_routes)
+    {
+        size_t n = route_count(routes, max_routes);
+        std::string out;
+        out.reserve(512 + n * 1024);
+
+        out.push_back('{');
+        put_json_key(out, "origin", true);
+        put_json_string(out, meta.origin);
+        put_json_key(out, "origin_cd");
+        put_json_string(out, meta.origin_cd);
+        put_json_key(out, "destination");
+        put_json_string(out, meta.destination);
+        put_json_key(out, "destination_cd");
+        put_json_string(out, meta.destination_cd);
+
+        put_json_key(out, "routes");
+        out.push_back('[');
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (i > 0)
+                out += ", ";
+            size_t begin = routes.path_begin(i);
+            size_t end = routes.path_end(i);
+
+            out.push_back('{');
+            put_json_key(out, "rank", true);
+            out += std::to_string(i + 1);
+
+            put_json_key(out, "route_sequence");
+            out.push_back('[');
+            for (size_t k = begin; k < end; ++k)
+            {
+                if (k > begin)
+                    out += ", ";
+                put_json_string(out, data.get_code(static_cast<StationID>(routes.path_stations[k])));
+            }
+            out.push_back(']');
+
+            put_json_key(out, "route_lines");
+            out.push_back('[');
+            for (size_t k = begin; k < end; ++k)
+            {
+                if (k > begin)
+                    out += ", ";
+                put_json_string(out, line_of(data, routes.path_lines[k]));
+            }
+            out.push_back(']');
+
+            put_json_key(out, "total_time");
+            put_json_fixed(out, quantize(routes.arrival_time[i], TIME_DIGITS), TIME_DIGITS);
+            put_json_key(out, "transfers");
+            out += std::to_string(routes.transfers[i]);
+
+            // 환승 = 노선이 바뀌는 지점 (환승역 = 바뀐 뒤 첫 역), _extract_transfer_info와 동일
+            std::string stations = "[";
+            std::string info = "[";
+            for (size_t k = begin; k + 1 < end; ++k)
+            {
+                if (routes.path_lines[k] == routes.path_lines[k + 1])
+                    continue;
+                if (stations.size() > 1)
+                {
+                    stations += ", ";
+                    info += ", ";
+                }
+                const std::string &code = data.get_code(static_cast<StationID>(routes.path_stations[k + 1]));
+                put_json_string(stations, code);
+                info.push_back('[');
+                put_json_string(info, code);
+                info += ", ";
+                put_json_string(info, line_of(data, routes.path_lines[k]));
+                info += ", ";
+                put_json_string(info, line_of(data, routes.path_lines[k + 1]));
+                info.push_back(']');
+            }
+            put_json_key(out, "transfer_stations");
+            out += stations;
+            out.push_back(']');
+            put_json_key(out, "transfer_info");
+            out += info;
+            out.push_back(']');
+
+            put_json_key(out, "score");
+            put_json_fixed(out, quantize(routes.score[i], SCORE_DIGITS), SCORE_DIGITS);
+            put_json_key(out, "avg_convenience");
+            put_json_fixed(out, quantize(routes.avg_convenience[i], METRIC_DIGITS), METRIC_DIGITS);
+            put_json_key(out, "avg_congestion");
+            put_json_fixed(out, quantize(routes.avg_congestion[i], METRIC_DIGITS), METRIC_DIGITS);
+            put_json_key(out, "max_transfer_difficulty");
+            put_json_fixed(out, quantize(routes.max_transfer_difficulty[i], METRIC_DIGITS), METRIC_DIGITS);
+            out.push_back('}');
+        }
+        out.push_back(']');
+
+        put_json_key(out, "total_routes_found");
+        out += std::to_string(total_found(routes, meta));
+        put_json_key(out, "routes_returned");
+        out += std::to_string(n);
+        put_json_key(out, "effort_level");
+        out += std::to_string(meta.effort_level);
+        out.push_back('}');
+        return out;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "route_set.h"
+#include <cstdint>
+#include <string>
+
+namespace pathfinding
+{
+    class DataContainer;
+
+    // 경로 응답 머리 정보 (캐시 페이로드에 경로와 함께 저장)
+    struct RoutePayloadMeta
+    {
+        std::string origin;
+        std::string origin_cd;
+        std::string destination;
+        std::string destination_cd;
+        int effort_level = 0;
+        uint64_t total_routes_found = 0; // 인코딩 시 0이면 RouteSet 경로 수
+    };
+
+    struct RoutePayload
+    {
+        RoutePayloadMeta meta;
+        RouteSet routes; // 라벨 없음 (labels 비어 있음), 기준 값은 양자화된 값
+    };
+
+    // 캐시/전송용 경로 결과 직렬화 (RouteSet 상위 max_routes개)
+    //
+    // 바이너리 (버전 1, 정수는 LEB128 varint, 부호 있는 값은 zigzag):
+    //   "\0RSB" | 버전 u8 | 네트워크 지문 u64 LE | effort_level | total_routes_found
+    //   | origin | origin_cd | destination | destination_cd (길이 + UTF-8)
+    //   | 경로 수 | 경로마다: transfers, arrival_time*10, score*1e4, avg_convenience*100,
+    //     avg_congestion*100, max_transfer_difficulty*100 (응답 반올림 자릿수와 동일한 정수)
+    //     | 정차 수 | 역 ID... | 노선 구간 수 | (노선 ID + 1, 구간 길이)...
+    // - 역/노선 ID는 적재 순서에 따라 달라지므로 DataContainer::network_fingerprint가 다르면 디코딩 거부
+    // - 첫 바이트가 NUL이라 JSON 페이로드와 구분됨
+    //
+    // JSON: 서비스 응답 딕셔너리와 같은 키/순서의 UTF-8 JSON (json.dumps(ensure_ascii=False) 형식)
+    inline constexpr char ROUTE_PAYLOAD_MAGIC[] = {'\0', 'R', 'S', 'B'};
+    inline constexpr uint8_t ROUTE_PAYLOAD_VERSION = 1;
+
+    std::string encode_route_payload(const RouteSet &routes, const DataContainer &data,
+                                     const RoutePayloadMeta &meta, size_t max_routes);
+    std::string route_payload_json(const RouteSet &routes, const DataContainer &data,
+                                   const RoutePayloadMeta &meta, size_t max_routes);
+    // 잘못된 페이로드, 지원하지 않는 버전, 네트워크 지문 불일치 시 std::runtime_error
+    RoutePayload decode_route_payload(const std::string &payload, const DataContainer &data);
+}
@@ -0,0 +1,34 @@
+#include "route_set.h"
+
+namespace pathfinding
+{
+    void RouteSet::reserve(size_t routes)
+    {
+        labels.reserve(routes);
+        arrival_time.reserve(routes);
+        transfers.reserve(routes);
+        score.reserve(routes);
+        avg_convenience.reserve(routes);
+        avg_congestion.reserve(routes);
+        max_transfer_difficulty.reserve(routes);
+        path_offsets.reserve(routes + 1);
+    }
+
+    void RouteSet::append(const Label &leaf, const std::vector<PathStop> &stops)
+    {
+        labels.push_back(leaf);
+        arrival_time.push_back(leaf.arrival_time);
+        transfers.push_back(leaf.transfers);
+        score.push_back(leaf.score_cache);
+        avg_convenience.push_back(leaf.avg_convenience());
+        avg_congestion.push_back(leaf.avg_congestion());
+        max_transfer_difficulty.push_back(leaf.max_transfer_difficulty);
+
+        for (const auto &stop : stops)
+        {
+            path_stations.push_back(static_cast<int32_t>(stop.station_id));
+            path_lines.push_back(stop.line_id);
+        }
+        path_offsets.push_back(static_cast<int64_t>(path_stations.size()));
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "types.h"
+#include <cstdint>
+#include <vector>
+
+namespace pathfinding
+{
+    // 탐색 결과 묶음 (rank_routes 정렬 순)
+    // - 목적지 라벨과 재구성된 경로(중간역 포함)를 직접 소유하므로 엔진의 label_pool_과 무관
+    //   (엔진을 다음 탐색에 재사용하거나 폐기해도 유효)
+    // - 기준 값은 경로별 연속 배열(SoA), 경로 역/노선은 CSR:
+    //   i번째 경로 = path_stations/path_lines[path_offsets[i] .. path_offsets[i+1])
+    // - Python에는 배열을 복사 없이 NumPy 뷰로 노출, Label 객체는 요청 시에만 생성
+    struct RouteSet
+    {
+        std::vector<Label> labels; // 목적지 라벨 (score_cache = rank_routes 점수), 캐시에서 디코딩한 결과는 비어 있음
+
+        std::vector<double> arrival_time;
+        std::vector<int32_t> transfers;
+        std::vector<double> score;
+        std::vector<double> avg_convenience;
+        std::vector<double> avg_congestion;
+        std::vector<double> max_transfer_difficulty;
+
+        std::vector<int64_t> path_offsets{0};
+        std::vector<int32_t> path_stations; // StationID
+        std::vector<int32_t> path_lines;    // LineID (DataContainer::line_name), 알 수 없는 노선은 -1
+
+        size_t size() const { return arrival_time.size(); }
+        size_t path_begin(size_t i) const { return static_cast<size_t>(path_offsets[i]); }
+        size_t path_end(size_t i) const { return static_cast<size_t>(path_offsets[i + 1]); }
+
+        void reserve(size_t routes);
+        // 정렬된 목적지 라벨 1개와 그 경로 (McRaptorEngine::reconstruct_stops 결과) 추가
+        void append(const Label &leaf, const std::vector<PathStop> &stops);
+    };
+}
@@ -0,0 +1,204 @@
+#include "snapshot.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace pathfinding
+{
+    namespace
+    {
+        constexpr const char *SNAPSHOT_MAGIC = "KINDMAP_SNAPSHOT";
+        constexpr int SNAPSHOT_VERSION = 2;
+        constexpr int SNAPSHOT_MIN_VERSION = 1;
+
+        std::vector<std::string> split(const std::string &s, char sep)
+        {
+            std::vector<std::string> out;
+            if (s.empty())
+                return out;
+            size_t start = 0;
+            while (true)
+            {
+                size_t pos = s.find(sep, start);
+                if (pos == std::string::npos)
+                {
+                    out.push_back(s.substr(start));
+                    break;
+                }
+                out.push_back(s.substr(start, pos - start));
+                start = pos + 1;
+            }
+            return out;
+        }
+
+        std::string join(const std::vector<std::string> &items, char sep)
+        {
+            std::string out;
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                if (i > 0)
+                    out += sep;
+                out += items[i];
+            }
+            return out;
+        }
+
+        [[noreturn]] void fail(const std::string &path, size_t line_no, const std::string &why)
+        {
+            throw std::runtime_error("Invalid snapshot " + path + ":" + std::to_string(line_no) + ": " + why);
+        }
+    }
+
+    NetworkSnapshot read_snapshot(const std::string &path)
+    {
+        std::ifstream in(path);
+        if (!in)
+            throw std::runtime_error("Cannot open snapshot: " + path);
+
+        NetworkSnapshot snap;
+        std::string line;
+        size_t line_no = 0;
+
+        // 헤더 검증
+        if (!std::getline(in, line))
+            fail(path, 1, "empty file");
+        ++line_no;
+        auto header = split(line, '\t');
+        if (header.size() != 2 || header[0] != SNAPSHOT_MAGIC)
+            fail(path, line_no, "missing header");
+        int version = std::stoi(header[1]);
+        if (version < SNAPSHOT_MIN_VERSION || version > SNAPSHOT_VERSION)
+            fail(path, line_no, "unsupported version " + header[1]);
+
+        while (std::getline(in, line))
+        {
+            ++line_no;
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            auto f = split(line, '\t');
+            const std::string &tag = f[0];
+            try
+            {
+                if (tag == "S" && f.size() == 6)
+                {
+                    snap.stations.push_back({f[1], f[2], f[3], std::stod(f[4]), std::stod(f[5])});
+                }
+                else if (tag == "O" && f.size() == 4)
+                {
+                    snap.orders.push_back({f[1], f[2], std::stoi(f[3])});
+                }
+                else if (tag == "T" && f.size() == 7)
+                {
+                    snap.topology.push_back({f[1], f[2], split(f[3], ','), split(f[4], ','),
+                                             split(f[5], ','), split(f[6], ',')});
+                }
+                else if (tag == "X" && f.size() == 5)
+                {
+                    snap.transfers.push_back({f[1], f[2], f[3], std::stod(f[4])});
+                }
+                else if (tag == "C" && f.size() == 6)
+                {
+                    SnapshotCongestion c{f[1], f[2], f[3], f[4], {}};
+                    for (const auto &kv : split(f[5], ','))
+                    {
+                        size_t eq = kv.find('=');
+                        if (eq == std::string::npos)
+                            fail(path, line_no, "bad congestion slot");
+                        c.slots.emplace_back(kv.substr(0, eq), std::stod(kv.substr(eq + 1)));
+                    }
+                    snap.congestion.push_back(std::move(c));
+                }
+                else if (tag == "F" && f.size() == 6)
+                {
+                    snap.facilities.push_back({f[1], {std::stod(f[2]), std::stod(f[3]), std::stod(f[4]), std::stod(f[5])}});
+                }
+                else if (tag == "D" && f.size() == 3)
+                {
+                    // 행 번호 순서대로, 행 길이 = 역 수 (역 레코드가 먼저 기록됨)
+                    size_t n = snap.stations.size();
+                    if (std::stoul(f[1]) * n != snap.distance_matrix.size())
+                        fail(path, line_no, "distance matrix row out of order");
+                    auto values = split(f[2], ',');
+                    if (values.size() != n)
+                        fail(path, line_no, "distance matrix row length");
+                    for (const auto &v : values)
+                        snap.distance_matrix.push_back(std::stof(v));
+                }
+                else
+                {
+                    fail(path, line_no, "unknown record '" + tag + "'");
+                }
+            }
+            catch (const std::invalid_argument &)
+            {
+                fail(path, line_no, "bad number");
+            }
+            catch (const std::out_of_range &)
+            {
+                fail(path, line_no, "number out of range");
+            }
+        }
+        if (!snap.distance_matrix.empty() && snap.distance_matrix.size() != snap.stations.size() * snap.stations.size())
+            fail(path, line_no, "incomplete distance matrix");
+        return snap;
+    }
+
+    void write_snapshot(const NetworkSnapshot &snap, const std::string &path)
+    {
+        std::ofstream out(path);
+        if (!out)
+            throw std::runtime_error("Cannot write snapshot: " + path);
+
+        // 좌표/거리는 손실 없이 재현되도록 충분한 자릿수 사용
+        out.precision(17);
+        out << SNAPSHOT_MAGIC << '\t' << SNAPSHOT_VERSION << '\n';
+
+        for (const auto &s : snap.stations)
+            out << "S\t" << s.station_cd << '\t' << s.name << '\t' << s.line << '\t'
+                << s.latitude << '\t' << s.longitude << '\n';
+        for (const auto &o : snap.orders)
+            out << "O\t" << o.station_cd << '\t' << o.line << '\t' << o.order << '\n';
+        for (const auto &t : snap.topology)
+            out << "T\t" << t.station_cd << '\t' << t.line << '\t' << join(t.up, ',') << '\t'
+                << join(t.down, ',') << '\t' << join(t.in, ',') << '\t' << join(t.out, ',') << '\n';
+        for (const auto &x : snap.transfers)
+            out << "X\t" << x.station_cd << '\t' << x.from_line << '\t' << x.to_line << '\t' << x.distance << '\n';
+        for (const auto &c : snap.congestion)
+        {
+            out << "C\t" << c.station_cd << '\t' << c.line << '\t' << c.direction << '\t' << c.day << '\t';
+            for (size_t i = 0; i < c.slots.size(); ++i)
+            {
+                if (i > 0)
+                    out << ',';
+                out << c.slots[i].first << '=' << c.slots[i].second;
+            }
+            out << '\n';
+        }
+        for (const auto &fc : snap.facilities)
+            out << "F\t" << fc.station_cd << '\t' << fc.scores[0] << '\t' << fc.scores[1] << '\t'
+                << fc.scores[2] << '\t' << fc.scores[3] << '\n';
+
+        // 거리 행렬은 float 왕복에 충분한 9자리 (역 수가 바뀐 행렬은 기록하지 않음)
+        size_t n = snap.stations.size();
+        if (n > 0 && snap.distance_matrix.size() == n * n)
+        {
+            out.precision(9);
+            for (size_t i = 0; i < n; ++i)
+            {
+                out << "D\t" << i << '\t';
+                const float *row = snap.distance_matrix.data() + i * n;
+                for (size_t j = 0; j < n; ++j)
+                {
+                    if (j > 0)
+                        out << ',';
+                    out << row[j];
+                }
+                out << '\n';
+            }
+        }
+
+        if (!out)
+            throw std::runtime_error("Failed while writing snapshot: " + path);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+#include <utility>
+
+namespace pathfinding
+{
+    // 네트워크 스냅샷 (DataContainer 로딩 입력을 Python 의존 없이 표현)
+    // - load_from_python은 Python dict를 이 구조체로 변환한 뒤 load_snapshot으로 적재
+    // - 오프라인 도구(tools/)는 파일에서 직접 읽어 동일한 경로로 적재
+
+    struct SnapshotStation
+    {
+        std::string station_cd;
+        std::string name;
+        std::string line;
+        double latitude = 0.0;
+        double longitude = 0.0;
+    };
+
+    struct SnapshotOrder
+    {
+        std::string station_cd;
+        std::string line;
+        int order = 0;
+    };
+
+    struct SnapshotTopology
+    {
+        std::string station_cd;
+        std::string line;
+        std::vector<std::string> up;
+        std::vector<std::string> down;
+        std::vector<std::string> in;
+        std::vector<std::string> out;
+    };
+
+    struct SnapshotTransfer
+    {
+        std::string station_cd;
+        std::string from_line;
+        std::string to_line;
+        double distance = 0.0;
+    };
+
+    struct SnapshotCongestion
+    {
+        std::string station_cd;
+        std::string line;
+        std::string direction;
+        std::string day;
+        std::vector<std::pair<std::string, double>> slots; // t_0 ~ t_1410
+    };
+
+    // 유형별(PHY, VIS, AUD, ELD) 정규화된 편의시설 점수
+    struct SnapshotFacility
+    {
+        std::string station_cd;
+        std::array<double, 4> scores = {0.0, 0.0, 0.0, 0.0};
+    };
+
+    struct NetworkSnapshot
+    {
+        std::vector<SnapshotStation> stations; // 순서 = StationID 부여 순서
+        std::vector<SnapshotOrder> orders;
+        std::vector<SnapshotTopology> topology;
+        std::vector<SnapshotTransfer> transfers;
+        std::vector<SnapshotCongestion> congestion;
+        std::vector<SnapshotFacility> facilities;
+        // 역 간 haversine 거리 (미터, stations.size()^2 행 우선), 비어 있으면 적재 시 계산
+        std::vector<float> distance_matrix;
+    };
+
+    // 탭 구분 텍스트 포맷 (첫 줄: "KINDMAP_SNAPSHOT\t<version>")
+    // 버전 2: 거리 행렬 레코드(D) 추가, 버전 1 파일도 읽기 가능
+    // 실패 시 std::runtime_error
+    NetworkSnapshot read_snapshot(const std::string &path);
+    void write_snapshot(const NetworkSnapshot &snapshot, const std::string &path);
+}
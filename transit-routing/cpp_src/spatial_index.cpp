@@ -0,0 +1,262 @@
+#include "spatial_index.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace pathfinding
+{
+    namespace
+    {
+        constexpr double TO_RAD = 3.14159265358979323846 / 180.0;
+        constexpr double TARGET_PER_CELL = 2.0;   // 자동 셀 크기 기준 (셀당 평균 역 수)
+        constexpr double MIN_CELL_M = 50.0;
+        constexpr double MAX_CELLS = 1 << 22;     // 좌표 이상치로 격자가 과도하게 커지는 것 방지
+        constexpr double MAX_CELL_INDEX = 1e9;    // 원거리 질의 좌표의 셀 번호 오버플로 방지
+        constexpr double PLANAR_MARGIN_M = 100000.0; // 격자 밖 이 거리까지는 평면 근사 하한 사용
+
+        bool closer(const SpatialIndex::Hit &a, const SpatialIndex::Hit &b)
+        {
+            return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+        }
+    }
+
+    SpatialIndex::SpatialIndex(const DataContainer &data, double cell_size_m)
+    {
+        struct Point
+        {
+            StationID id;
+            double lat;
+            double lon;
+        };
+        std::vector<Point> points;
+        {
+            std::shared_lock<std::shared_mutex> lock(data.update_mutex);
+            size_t n = data.station_count();
+            points.reserve(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const StationInfo &s = data.get_station(static_cast<StationID>(i));
+                if (s.latitude == 0.0 && s.longitude == 0.0)
+                    continue;
+                if (!std::isfinite(s.latitude) || !std::isfinite(s.longitude))
+                    continue;
+                points.push_back({static_cast<StationID>(i), s.latitude, s.longitude});
+            }
+        }
+
+        cell_start_.assign(1, 0);
+        if (points.empty())
+            return;
+
+        double min_lat = points[0].lat, max_lat = points[0].lat;
+        double min_lon = points[0].lon, max_lon = points[0].lon;
+        for (const auto &p : points)
+        {
+            min_lat = std::min(min_lat, p.lat);
+            max_lat = std::max(max_lat, p.lat);
+            min_lon = std::min(min_lon, p.lon);
+            max_lon = std::max(max_lon, p.lon);
+        }
+        lat0_ = min_lat;
+        lon0_ = min_lon;
+        m_per_deg_lon_ = M_PER_DEG_LAT * std::cos((min_lat + max_lat) * 0.5 * TO_RAD);
+
+        double width = std::max(to_x(max_lon), 1.0);
+        double height = std::max(to_y(max_lat), 1.0);
+        cell_m_ = cell_size_m > 0.0 ? cell_size_m
+                                    : std::max(MIN_CELL_M, std::sqrt(width * height * TARGET_PER_CELL / points.size()));
+        if ((width / cell_m_ + 1.0) * (height / cell_m_ + 1.0) > MAX_CELLS)
+            cell_m_ = std::sqrt(width * height / MAX_CELLS) + 1.0;
+        nx_ = static_cast<int64_t>(width / cell_m_) + 1;
+        ny_ = static_cast<int64_t>(height / cell_m_) + 1;
+
+        // 투영 거리 -> 실제 거리 하한 보정 계수
+        // 경도 방향 축척은 cos(위도)에 비례하므로 평면 근사 범위(격자 + 여유) 내 cos가 가장 작은 위도 기준
+        margin_cells_ = static_cast<int64_t>(PLANAR_MARGIN_M / cell_m_) + 1;
+        double lat_lo = min_lat - margin_cells_ * cell_m_ / M_PER_DEG_LAT;
+        double lat_hi = min_lat + (ny_ + margin_cells_) * cell_m_ / M_PER_DEG_LAT;
+        double cos_mid = m_per_deg_lon_ / M_PER_DEG_LAT;
+        double cos_min = std::min(std::cos(lat_lo * TO_RAD), std::cos(lat_hi * TO_RAD));
+        scale_floor_ = std::min(1.0, cos_min / cos_mid) * 0.999;
+
+        // 셀 단위 계수 정렬 (같은 셀의 역 좌표가 메모리상 연속되도록 패킹)
+        std::vector<uint32_t> cell_of(points.size());
+        cell_start_.assign(static_cast<size_t>(nx_ * ny_) + 1, 0);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            int64_t c = cell_y(to_y(points[i].lat)) * nx_ + cell_x(to_x(points[i].lon));
+            cell_of[i] = static_cast<uint32_t>(c);
+            ++cell_start_[c + 1];
+        }
+        for (size_t c = 1; c < cell_start_.size(); ++c)
+            cell_start_[c] += cell_start_[c - 1];
+
+        ids_.resize(points.size());
+        lats_.resize(points.size());
+        lons_.resize(points.size());
+        std::vector<uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            uint32_t slot = fill[cell_of[i]]++;
+            ids_[slot] = points[i].id;
+            lats_[slot] = points[i].lat;
+            lons_[slot] = points[i].lon;
+        }
+    }
+
+    int64_t SpatialIndex::cell_x(double x) const
+    {
+        double c = std::floor(x / cell_m_);
+        return static_cast<int64_t>(std::max(-MAX_CELL_INDEX, std::min(MAX_CELL_INDEX, c)));
+    }
+
+    int64_t SpatialIndex::cell_y(double y) const
+    {
+        double c = std::floor(y / cell_m_);
+        return static_cast<int64_t>(std::max(-MAX_CELL_INDEX, std::min(MAX_CELL_INDEX, c)));
+    }
+
+    int64_t SpatialIndex::ring_gap(int64_t cx, int64_t cy) const
+    {
+        int64_t gap_x = cx < 0 ? -cx : std::max<int64_t>(0, cx - (nx_ - 1));
+        int64_t gap_y = cy < 0 ? -cy : std::max<int64_t>(0, cy - (ny_ - 1));
+        return std::max(gap_x, gap_y);
+    }
+
+    void SpatialIndex::scan_cell(int64_t cx, int64_t cy, double lat, double lon, size_t k, std::vector<Hit> &best) const
+    {
+        size_t c = static_cast<size_t>(cy * nx_ + cx);
+        scan_range(cell_start_[c], cell_start_[c + 1], lat, lon, k, best);
+    }
+
+    void SpatialIndex::scan_range(uint32_t begin, uint32_t end, double lat, double lon, size_t k, std::vector<Hit> &best) const
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            Hit h{ids_[i], PathfindingUtils::haversine(lat, lon, lats_[i], lons_[i])};
+            if (best.size() == k && !closer(h, best.back()))
+                continue;
+            if (best.size() == k)
+                best.pop_back();
+            best.insert(std::upper_bound(best.begin(), best.end(), h, closer), h);
+        }
+    }
+
+    void SpatialIndex::scan_within(uint32_t begin, uint32_t end, double lat, double lon, double radius_m,
+                                   std::vector<Hit> &hits) const
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            double d = PathfindingUtils::haversine(lat, lon, lats_[i], lons_[i]);
+            if (d <= radius_m)
+                hits.push_back({ids_[i], d});
+        }
+    }
+
+    std::vector<SpatialIndex::Hit> SpatialIndex::nearest(double lat, double lon, size_t k) const
+    {
+        std::vector<Hit> best;
+        k = std::min(k, ids_.size());
+        if (k == 0)
+            return best;
+        best.reserve(k);
+
+        int64_t cx = cell_x(to_x(lon));
+        int64_t cy = cell_y(to_y(lat));
+        int64_t r_first = ring_gap(cx, cy); // 격자와 처음 겹치는 링
+        if (r_first > margin_cells_)
+        {
+            // 원거리 질의는 평면 근사 하한이 성립하지 않으므로 전체 순회 (정확도 우선)
+            scan_range(0, static_cast<uint32_t>(ids_.size()), lat, lon, k, best);
+            return best;
+        }
+        double bound_m = cell_m_ * scale_floor_;
+        int64_t r_last = std::max({cx, nx_ - 1 - cx, cy, ny_ - 1 - cy});
+
+        for (int64_t r = r_first; r <= r_last; ++r)
+        {
+            int64_t y_lo = std::max<int64_t>(0, cy - r), y_hi = std::min(ny_ - 1, cy + r);
+            for (int64_t y = y_lo; y <= y_hi; ++y)
+            {
+                if (y == cy - r || y == cy + r)
+                {
+                    int64_t x_lo = std::max<int64_t>(0, cx - r), x_hi = std::min(nx_ - 1, cx + r);
+                    for (int64_t x = x_lo; x <= x_hi; ++x)
+                        scan_cell(x, y, lat, lon, k, best);
+                }
+                else
+                {
+                    if (cx - r >= 0 && cx - r < nx_)
+                        scan_cell(cx - r, y, lat, lon, k, best);
+                    if (r > 0 && cx + r >= 0 && cx + r < nx_)
+                        scan_cell(cx + r, y, lat, lon, k, best);
+                }
+            }
+            // 링 r+1 이후의 역은 투영 거리로 최소 r 셀 이상 떨어져 있음
+            if (best.size() == k && best.back().distance <= r * bound_m)
+                break;
+        }
+        return best;
+    }
+
+    std::vector<SpatialIndex::Hit> SpatialIndex::within(double lat, double lon, double radius_m) const
+    {
+        std::vector<Hit> hits;
+        if (ids_.empty() || !(radius_m >= 0.0))
+            return hits;
+
+        double qx = to_x(lon), qy = to_y(lat);
+        if (ring_gap(cell_x(qx), cell_y(qy)) > margin_cells_)
+        {
+            // 원거리 질의는 전체 순회 (nearest와 동일한 이유)
+            scan_within(0, static_cast<uint32_t>(ids_.size()), lat, lon, radius_m, hits);
+        }
+        else
+        {
+            double reach = radius_m / scale_floor_;
+            int64_t x_lo = std::max<int64_t>(0, cell_x(qx - reach)), x_hi = std::min(nx_ - 1, cell_x(qx + reach));
+            int64_t y_lo = std::max<int64_t>(0, cell_y(qy - reach)), y_hi = std::min(ny_ - 1, cell_y(qy + reach));
+            for (int64_t y = y_lo; x_lo <= x_hi && y <= y_hi; ++y)
+                scan_within(cell_start_[y * nx_ + x_lo], cell_start_[y * nx_ + x_hi + 1], lat, lon, radius_m, hits);
+        }
+        std::sort(hits.begin(), hits.end(), closer);
+        return hits;
+    }
+
+    void SpatialIndex::nearest_batch(const double *lats, const double *lons, size_t n, size_t k,
+                                     int32_t *out_ids, double *out_dists) const
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::vector<Hit> hits = nearest(lats[i], lons[i], k);
+            int32_t *row_ids = out_ids + i * k;
+            double *row_dists = out_dists + i * k;
+            for (size_t j = 0; j < k; ++j)
+            {
+                row_ids[j] = j < hits.size() ? static_cast<int32_t>(hits[j].id) : -1;
+                row_dists[j] = j < hits.size() ? hits[j].distance : std::numeric_limits<double>::infinity();
+            }
+        }
+    }
+
+    void SpatialIndex::within_batch(const double *lats, const double *lons, size_t n, double radius_m,
+                                    std::vector<int64_t> &offsets, std::vector<int32_t> &out_ids,
+                                    std::vector<double> &out_dists) const
+    {
+        offsets.assign(1, 0);
+        offsets.reserve(n + 1);
+        out_ids.clear();
+        out_dists.clear();
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (const Hit &h : within(lats[i], lons[i], radius_m))
+            {
+                out_ids.push_back(static_cast<int32_t>(h.id));
+                out_dists.push_back(h.distance);
+            }
+            offsets.push_back(static_cast<int64_t>(out_ids.size()));
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "types.h"
+#include "data_loader.h"
+#include <cstdint>
+#include <vector>
+
+namespace pathfinding
+{
+    // 역 좌표 공간 인덱스 (균일 격자)
+    // - DataContainer의 StationInfo 좌표로 1회 구축, 엔진과 동일한 StationID 공간 사용
+    // - 좌표는 구축 시점에 복사되므로 이후 DataContainer 갱신과 무관 (역 좌표는 실시간 갱신 대상 아님)
+    // - 좌표가 (0, 0)인 역은 좌표 누락으로 보고 제외
+    // - 반환 거리는 haversine 미터 (PathfindingUtils::haversine과 동일)
+    // - 구축 이후 읽기 전용이므로 여러 스레드에서 동시 조회 가능
+    class SpatialIndex
+    {
+    public:
+        struct Hit
+        {
+            StationID id;
+            double distance;
+        };
+
+        // cell_size_m <= 0 이면 셀당 평균 2개 역이 되도록 자동 결정
+        explicit SpatialIndex(const DataContainer &data, double cell_size_m = 0.0);
+
+        size_t size() const { return ids_.size(); }
+        double cell_size() const { return cell_m_; }
+
+        // 가까운 순 최대 k개
+        std::vector<Hit> nearest(double lat, double lon, size_t k) const;
+        // 반경 radius_m 이내 (가까운 순)
+        std::vector<Hit> within(double lat, double lon, double radius_m) const;
+
+        // 배치 조회 (n개 위치)
+        // - nearest: out_ids/out_dists는 n*k 행 우선 배열, 역이 k개 미만이면 나머지는 -1 / +inf
+        // - within: CSR 형식, i번째 위치의 결과는 out_ids[offsets[i] .. offsets[i+1])
+        void nearest_batch(const double *lats, const double *lons, size_t n, size_t k,
+                           int32_t *out_ids, double *out_dists) const;
+        void within_batch(const double *lats, const double *lons, size_t n, double radius_m,
+                          std::vector<int64_t> &offsets, std::vector<int32_t> &out_ids,
+                          std::vector<double> &out_dists) const;
+
+    private:
+        // 등장방형 투영 (기준 위도 cos 보정, 미터 단위)
+        double to_x(double lon) const { return (lon - lon0_) * m_per_deg_lon_; }
+        double to_y(double lat) const { return (lat - lat0_) * M_PER_DEG_LAT; }
+        int64_t cell_x(double x) const;
+        int64_t cell_y(double y) const;
+        int64_t ring_gap(int64_t cx, int64_t cy) const; // 셀에서 격자까지의 체비쇼프 거리 (셀 단위)
+        // 가까운 순 상위 k개 유지 (best는 정렬 상태)
+        void scan_cell(int64_t cx, int64_t cy, double lat, double lon, size_t k, std::vector<Hit> &best) const;
+        void scan_range(uint32_t begin, uint32_t end, double lat, double lon, size_t k, std::vector<Hit> &best) const;
+        void scan_within(uint32_t begin, uint32_t end, double lat, double lon, double radius_m, std::vector<Hit> &hits) const;
+
+        static constexpr double M_PER_DEG_LAT = 111194.92664455873; // 6371000 * pi / 180
+
+        double lat0_ = 0.0;
+        double lon0_ = 0.0;
+        double m_per_deg_lon_ = M_PER_DEG_LAT;
+        double cell_m_ = 0.0;
+        double scale_floor_ = 1.0;    // 투영 거리 대비 실제 거리 하한 비율
+        int64_t margin_cells_ = 0;    // 평면 근사 허용 범위 (격자 밖 셀 수)
+        int64_t nx_ = 0;
+        int64_t ny_ = 0;
+
+        // 셀 순서로 정렬된 역 (CSR: cell_start_[c] .. cell_start_[c+1])
+        std::vector<uint32_t> cell_start_;
+        std::vector<StationID> ids_;
+        std::vector<double> lats_;
+        std::vector<double> lons_;
+    };
+}
@@ -0,0 +1,202 @@
+#include "station_search.h"
+#include "utils.h"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+namespace pathfinding
+{
+    namespace
+    {
+        // 한글 음절 (U+AC00 ~ U+D7A3) = 0xAC00 + (초성 * 21 + 중성) * 28 + 종성
+        constexpr char32_t HANGUL_BASE = 0xAC00;
+        constexpr char32_t HANGUL_LAST = 0xD7A3;
+        constexpr char32_t SYLLABLES_PER_CHOSUNG = 21 * 28;
+
+        // 초성 순서 -> 호환 자모 (ㄱ ㄲ ㄴ ㄷ ㄸ ㄹ ㅁ ㅂ ㅃ ㅅ ㅆ ㅇ ㅈ ㅉ ㅊ ㅋ ㅌ ㅍ ㅎ)
+        constexpr char32_t CHOSUNG_JAMO[19] = {
+            0x3131, 0x3132, 0x3134, 0x3137, 0x3138, 0x3139, 0x3141, 0x3142, 0x3143, 0x3145,
+            0x3146, 0x3147, 0x3148, 0x3149, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E};
+
+        struct Candidate
+        {
+            StationNameIndex::MatchRank rank;
+            uint32_t length;
+            uint32_t key;
+        };
+    }
+
+    StationNameIndex::StationNameIndex(const std::vector<std::string> &codes, const std::vector<std::string> &names)
+    {
+        if (codes.size() != names.size())
+            throw std::invalid_argument("codes and names must have the same length");
+
+        // 키별 역 묶음 (키 순서 고정): 정규화 이름과, 다르면 원래 이름도 키로 등록
+        // (원래 이름 키가 있어야 "역" 한 글자 입력, 괄호 안 별칭 "이수" 등이 일치)
+        std::map<std::string, std::vector<uint32_t>> groups;
+        stations_.reserve(codes.size());
+        for (size_t i = 0; i < codes.size(); ++i)
+        {
+            uint32_t id = static_cast<uint32_t>(stations_.size());
+            std::string key = PathfindingUtils::normalize_station_name(names[i]);
+            if (key.empty())
+                key = names[i];
+            groups[key].push_back(id);
+            if (key != names[i])
+                groups[names[i]].push_back(id);
+            stations_.push_back({codes[i], names[i]});
+        }
+
+        key_offsets_.reserve(groups.size() + 1);
+        key_stations_.reserve(groups.size() + 1);
+        key_offsets_.push_back(0);
+        key_stations_.push_back(0);
+        for (auto &[key, ids] : groups)
+        {
+            for (char32_t c : decode(key))
+            {
+                chars_.push_back(c);
+                chosung_.push_back(chosung(c));
+            }
+            key_offsets_.push_back(static_cast<uint32_t>(chars_.size()));
+
+            std::sort(ids.begin(), ids.end(), [this](uint32_t a, uint32_t b)
+                      { return stations_[a].station_cd < stations_[b].station_cd; });
+            key_station_ids_.insert(key_station_ids_.end(), ids.begin(), ids.end());
+            key_stations_.push_back(static_cast<uint32_t>(key_station_ids_.size()));
+        }
+    }
+
+    std::vector<StationNameIndex::Hit> StationNameIndex::search(const std::string &query, size_t limit) const
+    {
+        std::vector<Hit> hits;
+        std::vector<char32_t> q = decode(PathfindingUtils::normalize_station_name(query));
+        if (q.empty())
+        {
+            // 정규화로 비는 질의 ("역", "(이수)")는 원래 질의(앞뒤 공백 제거)로 검색
+            const char *ws = " \t\n\r\f\v";
+            size_t first = query.find_first_not_of(ws);
+            if (first != std::string::npos)
+                q = decode(query.substr(first, query.find_last_not_of(ws) + 1 - first));
+        }
+        if (q.empty() || limit == 0)
+            return hits;
+
+        bool has_jamo = std::any_of(q.begin(), q.end(), is_chosung_jamo);
+        std::vector<Candidate> candidates;
+        for (uint32_t k = 0; k + 1 < key_offsets_.size(); ++k)
+        {
+            uint32_t begin = key_offsets_[k];
+            uint32_t end = key_offsets_[k + 1];
+            uint32_t length = end - begin;
+            if (length < q.size())
+                continue;
+
+            const char32_t *first = chars_.data() + begin;
+            const char32_t *last = chars_.data() + end;
+            const char32_t *pos = std::search(first, last, q.begin(), q.end());
+            if (pos != last)
+            {
+                MatchRank rank = pos != first ? MatchRank::SUBSTRING
+                                              : (length == q.size() ? MatchRank::EXACT : MatchRank::PREFIX);
+                candidates.push_back({rank, length, k});
+                continue;
+            }
+            if (!has_jamo)
+                continue;
+
+            // 초성 비교: 같은 위치의 chosung_과 함께 보기 위해 인덱스로 탐색
+            const char32_t *cho = chosung_.data() + begin;
+            for (uint32_t at = 0; at + q.size() <= length; ++at)
+            {
+                bool matched = true;
+                for (size_t j = 0; j < q.size() && matched; ++j)
+                    matched = q[j] == first[at + j] || q[j] == cho[at + j];
+                if (matched)
+                {
+                    candidates.push_back({at == 0 ? MatchRank::CHOSUNG_PREFIX : MatchRank::CHOSUNG_SUBSTRING, length, k});
+                    break;
+                }
+            }
+        }
+
+        // 키마다 역이 1개 이상이고 역은 최대 2개 키(정규화/원래 이름)에 속하므로 상위 2 * limit개 키만 정렬하면 충분
+        auto by_rank = [](const Candidate &a, const Candidate &b)
+        {
+            if (a.rank != b.rank)
+                return a.rank < b.rank;
+            if (a.length != b.length)
+                return a.length < b.length;
+            return a.key < b.key; // 키는 정규화 이름 순으로 저장됨
+        };
+        size_t top = limit < candidates.size() / 2 ? 2 * limit : candidates.size();
+        std::partial_sort(candidates.begin(), candidates.begin() + top, candidates.end(), by_rank);
+
+        // 두 키가 모두 일치한 역은 순위가 좋은(먼저 나오는) 키에서 1회만
+        std::vector<bool> emitted(stations_.size(), false);
+        for (size_t i = 0; i < top && hits.size() < limit; ++i)
+        {
+            const Candidate &c = candidates[i];
+            for (uint32_t s = key_stations_[c.key]; s < key_stations_[c.key + 1] && hits.size() < limit; ++s)
+            {
+                uint32_t id = key_station_ids_[s];
+                if (emitted[id])
+                    continue;
+                emitted[id] = true;
+                const Station &st = stations_[id];
+                hits.push_back({st.station_cd, st.name, c.rank});
+            }
+        }
+        return hits;
+    }
+
+    std::vector<char32_t> StationNameIndex::decode(const std::string &text)
+    {
+        std::vector<char32_t> out;
+        out.reserve(text.size());
+        const auto *p = reinterpret_cast<const unsigned char *>(text.data());
+        const auto *end = p + text.size();
+        while (p < end)
+        {
+            unsigned char b = *p;
+            size_t extra = b < 0x80 ? 0 : (b >> 5) == 0x6 ? 1 : (b >> 4) == 0xE ? 2 : (b >> 3) == 0x1E ? 3 : 4;
+            if (extra == 4 || static_cast<size_t>(end - p) <= extra)
+            {
+                out.push_back(0xFFFD);
+                ++p;
+                continue;
+            }
+
+            char32_t c = extra == 0 ? b : b & (0x3F >> extra);
+            bool valid = true;
+            for (size_t i = 1; i <= extra; ++i)
+            {
+                valid = valid && (p[i] & 0xC0) == 0x80;
+                c = (c << 6) | (p[i] & 0x3F);
+            }
+            if (!valid)
+            {
+                out.push_back(0xFFFD);
+                ++p;
+                continue;
+            }
+            if (c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+            out.push_back(c);
+            p += extra + 1;
+        }
+        return out;
+    }
+
+    char32_t StationNameIndex::chosung(char32_t c)
+    {
+        if (c < HANGUL_BASE || c > HANGUL_LAST)
+            return c;
+        return CHOSUNG_JAMO[(c - HANGUL_BASE) / SYLLABLES_PER_CHOSUNG];
+    }
+
+    bool StationNameIndex::is_chosung_jamo(char32_t c)
+    {
+        return std::find(std::begin(CHOSUNG_JAMO), std::end(CHOSUNG_JAMO), c) != std::end(CHOSUNG_JAMO);
+    }
+}
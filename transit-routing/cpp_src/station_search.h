@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pathfinding
+{
+    // 역 이름 자동완성 인덱스
+    // - 검색 키: PathfindingUtils::normalize_station_name 결과와 원래 이름 (질의도 같은 규칙으로 정규화,
+    //   정규화로 비는 질의는 원래 질의로 검색), 두 키가 모두 일치한 역은 좋은 순위로 1회만
+    // - 같은 키의 역(환승역의 호선별 코드)은 한 키로 묶어 1회만 비교
+    // - 키는 코드포인트 배열로 미리 풀어 하나의 연속 배열에 저장하고, 한글 음절의 초성 배열을 함께 보관
+    //   (역 수백 개 규모에서는 트라이보다 연속 배열 선형 비교가 빠름, 질의당 수 마이크로초)
+    // - 질의의 자모 자음(ㄱ~ㅎ)은 같은 초성의 음절과 일치 (예: "ㄱㄴ" -> 강남, "강ㄴ" -> 강남)
+    // - 순위: 정확 일치 < 접두 일치 < 부분 일치 < 초성 접두 < 초성 부분, 같은 순위는 키 길이, 키 순, 키 안에서는 역 코드 순
+    // - ASCII 영문은 대소문자 구분 없음
+    // - 구축 이후 읽기 전용이므로 여러 스레드에서 동시 조회 가능
+    class StationNameIndex
+    {
+    public:
+        enum class MatchRank : uint8_t
+        {
+            EXACT = 0,
+            PREFIX = 1,
+            SUBSTRING = 2,
+            CHOSUNG_PREFIX = 3,
+            CHOSUNG_SUBSTRING = 4,
+        };
+
+        struct Hit
+        {
+            std::string station_cd;
+            std::string name; // 원래 역 이름
+            MatchRank rank;
+        };
+
+        // codes[i]의 역 이름이 names[i] (길이가 다르면 std::invalid_argument)
+        StationNameIndex(const std::vector<std::string> &codes, const std::vector<std::string> &names);
+
+        size_t size() const { return stations_.size(); }
+        size_t key_count() const { return key_offsets_.size() - 1; }
+
+        // 순위순 최대 limit개 (빈 질의 또는 limit == 0이면 빈 결과)
+        std::vector<Hit> search(const std::string &query, size_t limit) const;
+
+    private:
+        struct Station
+        {
+            std::string station_cd;
+            std::string name;
+        };
+
+        // UTF-8 -> 코드포인트 (ASCII 대문자는 소문자로, 잘못된 바이트는 U+FFFD)
+        static std::vector<char32_t> decode(const std::string &text);
+        // 한글 음절이면 초성 자모(호환 자모 ㄱ~ㅎ), 아니면 그대로
+        static char32_t chosung(char32_t c);
+        static bool is_chosung_jamo(char32_t c);
+
+        std::vector<Station> stations_;
+        // 키는 이름 순 (키 번호 순서 = 이름 순서)
+        // 키 k의 코드포인트/초성: chars_[key_offsets_[k] .. key_offsets_[k+1]), 초성은 같은 위치의 chosung_
+        std::vector<char32_t> chars_;
+        std::vector<char32_t> chosung_;
+        std::vector<uint32_t> key_offsets_;
+        // 키 k의 역: stations_ 인덱스 key_station_ids_[key_stations_[k] .. key_stations_[k+1]) (코드 순)
+        std::vector<uint32_t> key_stations_;
+        std::vector<uint32_t> key_station_ids_;
+    };
+}
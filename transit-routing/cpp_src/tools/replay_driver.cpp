@@ -0,0 +1,207 @@
+// 쿼리 로그 재생 드라이버
+//
+// FastAPI/Redis 없이 엔진만 격리하여, 기록된 운영 쿼리를 스냅샷에 대해 재생하고
+// 처리량/지연시간 백분위수/프로필별 통계를 출력한다.
+//
+// 사용법:
+//   replay_driver --snapshot net.snap --log queries.csv [--threads 8]
+//                 [--mode closed|open] [--rate 200] [--speed 60]
+//                 [--max-rounds 5] [--repeat 1] [--no-rank] [--intra-threads 1]
+//
+// - closed: 각 스레드가 이전 쿼리 완료 직후 다음 쿼리 실행 (최대 처리량 측정)
+// - open:   도착 시각을 고정 (--rate QPS 또는 기록된 timestamp를 --speed 배속 재생)
+//           지연시간 = 완료 시각 - 예정 도착 시각 (대기열 지연 포함, coordinated omission 방지)
+// - --intra-threads: 쿼리 1건 내부 라운드 병렬 스캔 스레드 수 (대형 쿼리 지연 측정은 --threads 1과 함께)
+
+#include "engine.h"
+#include "tools/tool_common.h"
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <thread>
+#include <unordered_set>
+
+using namespace pathfinding;
+using namespace pathfinding::tools;
+
+namespace
+{
+    struct Sample
+    {
+        size_t query_idx;
+        double latency_us;
+        bool ok;    // 예외 없이 완료
+        bool found; // 경로 1개 이상
+    };
+
+    struct ReplayConfig
+    {
+        int threads = 1;
+        bool open_loop = false;
+        double rate = 0.0;  // open-loop 고정 QPS (0이면 기록된 timestamp 사용)
+        double speed = 1.0; // 기록된 timestamp 재생 배속
+        int max_rounds = 5;
+        int intra_threads = 1; // McRaptorEngine::set_parallel_threads
+        bool rank = true;
+    };
+
+    // open-loop 예정 도착 시각 (시작 시점 기준, 마이크로초)
+    std::vector<double> schedule_arrivals(const std::vector<QueryRecord> &queries, const ReplayConfig &cfg)
+    {
+        std::vector<double> offsets(queries.size(), 0.0);
+        if (queries.empty())
+            return offsets;
+
+        if (cfg.rate > 0.0)
+        {
+            for (size_t i = 0; i < queries.size(); ++i)
+                offsets[i] = i * 1e6 / cfg.rate;
+            return offsets;
+        }
+
+        // 로그 순서를 유지하되 역행하는 timestamp는 직전 값으로 보정
+        double base = queries[0].timestamp;
+        double last = 0.0;
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            double off = (queries[i].timestamp - base) * 1e6 / cfg.speed;
+            last = std::max(last, off);
+            offsets[i] = last;
+        }
+        return offsets;
+    }
+
+    std::vector<Sample> run_replay(const DataContainer &data, const std::vector<QueryRecord> &queries,
+                                   const std::vector<double> &arrivals, const ReplayConfig &cfg, double &wall_us)
+    {
+        std::atomic<size_t> next{0};
+        std::vector<std::vector<Sample>> per_thread(cfg.threads);
+        Clock::time_point start = Clock::now();
+
+        auto worker = [&](int tid)
+        {
+            // 엔진은 label_pool_을 소유하므로 스레드마다 별도 인스턴스 (서비스와 동일한 사용 방식)
+            McRaptorEngine engine(data);
+            engine.set_parallel_threads(cfg.intra_threads);
+            auto &out = per_thread[tid];
+
+            while (true)
+            {
+                size_t i = next.fetch_add(1);
+                if (i >= queries.size())
+                    break;
+                const QueryRecord &q = queries[i];
+
+                Clock::time_point issued = Clock::now();
+                if (cfg.open_loop)
+                {
+                    issued = start + std::chrono::microseconds(static_cast<int64_t>(arrivals[i]));
+                    std::this_thread::sleep_until(issued);
+                }
+
+                bool ok = true;
+                bool found = false;
+                try
+                {
+                    auto routes = engine.find_routes(q.origin_cd, {q.dest_cd}, q.timestamp, q.profile, cfg.max_rounds);
+                    if (cfg.rank && !routes.empty())
+                        routes = engine.rank_routes(routes, q.profile);
+                    found = !routes.empty();
+                }
+                catch (const std::exception &)
+                {
+                    ok = false;
+                }
+                out.push_back({i, elapsed_us(issued, Clock::now()), ok, found});
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 0; t < cfg.threads; ++t)
+            pool.emplace_back(worker, t);
+        for (auto &th : pool)
+            th.join();
+
+        wall_us = elapsed_us(start, Clock::now());
+
+        std::vector<Sample> all;
+        for (auto &v : per_thread)
+            all.insert(all.end(), v.begin(), v.end());
+        return all;
+    }
+
+    void report(const std::vector<QueryRecord> &queries, const std::vector<Sample> &samples,
+                const ReplayConfig &cfg, double wall_us)
+    {
+        LatencyStats overall;
+        std::map<std::string, LatencyStats> by_profile;
+        size_t errors = 0, empty = 0;
+
+        for (const auto &s : samples)
+        {
+            if (!s.ok)
+            {
+                ++errors;
+                continue;
+            }
+            if (!s.found)
+                ++empty;
+            overall.add(s.latency_us);
+            by_profile[queries[s.query_idx].profile].add(s.latency_us);
+        }
+
+        double secs = wall_us / 1e6;
+        std::printf("mode=%s threads=%d intra_threads=%d max_rounds=%d queries=%zu\n",
+                    cfg.open_loop ? "open" : "closed", cfg.threads, cfg.intra_threads, cfg.max_rounds,
+                    samples.size());
+        std::printf("wall=%.3fs throughput=%.1f q/s errors=%zu no_route=%zu\n\n",
+                    secs, secs > 0 ? samples.size() / secs : 0.0, errors, empty);
+
+        LatencyStats::print_header();
+        overall.print_row("all");
+        for (auto &kv : by_profile)
+            kv.second.print_row(kv.first);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        Args args(argc, argv);
+        ReplayConfig cfg;
+        cfg.threads = std::max(1, args.get_int("threads", static_cast<int>(std::thread::hardware_concurrency())));
+        cfg.open_loop = args.get("mode", "closed") == "open";
+        cfg.rate = args.get_double("rate", 0.0);
+        cfg.speed = std::max(1e-6, args.get_double("speed", 1.0));
+        cfg.max_rounds = args.get_int("max-rounds", 5);
+        cfg.intra_threads = std::max(1, args.get_int("intra-threads", 1));
+        cfg.rank = !args.has("no-rank");
+        int repeat = std::max(1, args.get_int("repeat", 1));
+
+        auto data = load_container(args.require("snapshot"));
+        auto log = read_query_log(args.require("log"));
+
+        // 반복 재생: 쿼리(출발 시각 포함)는 그대로, 도착 일정만 로그 길이만큼 밀어서 이어 붙임
+        std::vector<double> base = schedule_arrivals(log, cfg);
+        double span = base.empty() ? 0.0 : base.back() + (cfg.rate > 0.0 ? 1e6 / cfg.rate : 1e6 / cfg.speed);
+        std::vector<QueryRecord> queries;
+        std::vector<double> arrivals;
+        for (int r = 0; r < repeat; ++r)
+            for (size_t i = 0; i < log.size(); ++i)
+            {
+                queries.push_back(log[i]);
+                arrivals.push_back(base[i] + r * span);
+            }
+
+        double wall_us = 0.0;
+        auto samples = run_replay(*data, queries, arrivals, cfg, wall_us);
+        report(queries, samples, cfg, wall_us);
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "replay_driver: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,287 @@
+// 읽기/쓰기 동시성 스트레스 벤치마크
+//
+// N개의 리더 스레드가 find_routes를 반복 실행하는 동안 M개의 라이터 스레드가
+// 편의시설 점수/혼잡도 갱신을 지정한 빈도로 적용하여, update_mutex 경합이
+// 쿼리 지연시간과 갱신 대기 시간에 미치는 영향을 측정한다.
+// ThreadSanitizer 빌드(-DPATHFINDING_SANITIZE=thread)로 실행하면 데이터 경합 검증용으로도 사용된다.
+//
+// 사용법:
+//   stress_bench --snapshot net.snap [--log queries.csv | --queries 1000]
+//                [--readers 4] [--writers 1] [--facility-rate 10] [--congestion-rate 10]
+//                [--batch 50] [--duration 10] [--max-rounds 5] [--seed 42]
+//
+// - --facility-rate / --congestion-rate: 라이터 스레드당 초당 갱신 횟수 (0이면 비활성)
+// - --batch: 갱신 1회에 포함되는 역(또는 혼잡도 행) 수
+// - 라이터 지연시간 = 쓰기 잠금 대기 + 적용 시간 (무경합 적용 시간을 함께 출력)
+
+#include "engine.h"
+#include "tools/tool_common.h"
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <thread>
+
+using namespace pathfinding;
+using namespace pathfinding::tools;
+
+namespace
+{
+    const char *PROFILES[] = {"PHY", "VIS", "AUD", "ELD"};
+    constexpr size_t UPDATE_POOL = 64; // 미리 생성해 두는 갱신 묶음 수
+
+    struct StressConfig
+    {
+        int readers = 4;
+        int writers = 1;
+        double facility_rate = 10.0;
+        double congestion_rate = 10.0;
+        size_t batch = 50;
+        double duration_s = 10.0;
+        int max_rounds = 5;
+    };
+
+    struct UpdatePool
+    {
+        std::vector<std::vector<SnapshotFacility>> facility;
+        std::vector<std::vector<SnapshotCongestion>> congestion;
+    };
+
+    std::vector<QueryRecord> random_queries(const NetworkSnapshot &snap, size_t n, std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<size_t> station(0, snap.stations.size() - 1);
+        std::uniform_int_distribution<int> profile(0, 3);
+        std::uniform_int_distribution<int> slot(10, 46); // 05:00 ~ 23:00
+        double midnight = static_cast<double>(std::time(nullptr) / 86400 * 86400);
+
+        std::vector<QueryRecord> out;
+        while (out.size() < n)
+        {
+            const auto &o = snap.stations[station(rng)];
+            const auto &d = snap.stations[station(rng)];
+            if (o.station_cd == d.station_cd)
+                continue;
+            out.push_back({o.station_cd, d.station_cd, PROFILES[profile(rng)], midnight + slot(rng) * 1800.0});
+        }
+        return out;
+    }
+
+    // 갱신 묶음은 측정 전에 생성 (라이터 지연시간에 생성 비용이 섞이지 않도록)
+    UpdatePool build_update_pool(const NetworkSnapshot &snap, size_t batch, std::mt19937 &rng)
+    {
+        UpdatePool pool;
+        std::uniform_int_distribution<size_t> station(0, snap.stations.size() - 1);
+        std::uniform_real_distribution<double> score(0.0, 1.0);
+
+        // 혼잡도 갱신 대상: 스냅샷에 있는 행, 없으면 역별 상행 평일 행을 합성
+        std::vector<SnapshotCongestion> base = snap.congestion;
+        if (base.empty())
+        {
+            for (const auto &s : snap.stations)
+            {
+                SnapshotCongestion c{s.station_cd, s.line, "up", "weekday", {}};
+                for (int t = 0; t < 1440; t += 30)
+                    c.slots.emplace_back("t_" + std::to_string(t), 0.0);
+                base.push_back(std::move(c));
+            }
+        }
+        std::uniform_int_distribution<size_t> cong_row(0, base.size() - 1);
+
+        for (size_t k = 0; k < UPDATE_POOL; ++k)
+        {
+            std::vector<SnapshotFacility> fac;
+            std::vector<SnapshotCongestion> cong;
+            for (size_t i = 0; i < batch; ++i)
+            {
+                fac.push_back({snap.stations[station(rng)].station_cd, {score(rng), score(rng), score(rng), score(rng)}});
+
+                SnapshotCongestion c = base[cong_row(rng)];
+                for (auto &slot : c.slots)
+                    slot.second = score(rng);
+                cong.push_back(std::move(c));
+            }
+            pool.facility.push_back(std::move(fac));
+            pool.congestion.push_back(std::move(cong));
+        }
+        return pool;
+    }
+
+    struct ReaderResult
+    {
+        LatencyStats latency;
+        size_t errors = 0;
+    };
+
+    struct WriterResult
+    {
+        LatencyStats facility;
+        LatencyStats congestion;
+    };
+
+    // 고정 주기 실행 (밀린 틱은 즉시 따라잡음)
+    class Ticker
+    {
+    public:
+        explicit Ticker(double rate)
+            : enabled_(rate > 0.0),
+              interval_(enabled_ ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate))
+                                 : Clock::duration::zero()),
+              next_(Clock::now() + interval_) {}
+
+        bool due(Clock::time_point now) const { return enabled_ && now >= next_; }
+        void advance() { next_ += interval_; }
+        Clock::time_point next() const { return enabled_ ? next_ : Clock::time_point::max(); }
+
+    private:
+        bool enabled_;
+        Clock::duration interval_;
+        Clock::time_point next_;
+    };
+
+    // 경합 없는 상태의 적용 시간 (라이터 대기 시간 추정용 기준값)
+    void measure_uncontended(DataContainer &data, const UpdatePool &pool, LatencyStats &fac, LatencyStats &cong)
+    {
+        for (size_t k = 0; k < UPDATE_POOL; ++k)
+        {
+            Clock::time_point t0 = Clock::now();
+            data.apply_facility_scores(pool.facility[k]);
+            Clock::time_point t1 = Clock::now();
+            data.apply_congestion(pool.congestion[k]);
+            fac.add(elapsed_us(t0, t1));
+            cong.add(elapsed_us(t1, Clock::now()));
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        Args args(argc, argv);
+        StressConfig cfg;
+        cfg.readers = std::max(1, args.get_int("readers", 4));
+        cfg.writers = std::max(0, args.get_int("writers", 1));
+        cfg.facility_rate = args.get_double("facility-rate", 10.0);
+        cfg.congestion_rate = args.get_double("congestion-rate", 10.0);
+        cfg.batch = static_cast<size_t>(std::max(1, args.get_int("batch", 50)));
+        cfg.duration_s = std::max(0.1, args.get_double("duration", 10.0));
+        cfg.max_rounds = args.get_int("max-rounds", 5);
+        std::mt19937 rng(static_cast<uint32_t>(args.get_int("seed", 42)));
+
+        auto data = load_container(args.require("snapshot"));
+        NetworkSnapshot snap = data->to_snapshot();
+        if (snap.stations.size() < 2)
+            throw std::runtime_error("Snapshot has fewer than 2 stations");
+
+        auto queries = args.has("log") ? read_query_log(args.require("log"))
+                                       : random_queries(snap, static_cast<size_t>(args.get_int("queries", 1000)), rng);
+        if (queries.empty())
+            throw std::runtime_error("No queries to run");
+        UpdatePool pool = build_update_pool(snap, cfg.batch, rng);
+
+        LatencyStats base_fac, base_cong;
+        measure_uncontended(*data, pool, base_fac, base_cong);
+
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> next_query{0};
+        std::vector<ReaderResult> reader_results(cfg.readers);
+        std::vector<WriterResult> writer_results(cfg.writers);
+
+        auto reader = [&](int tid)
+        {
+            McRaptorEngine engine(*data);
+            auto &out = reader_results[tid];
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const QueryRecord &q = queries[next_query.fetch_add(1) % queries.size()];
+                Clock::time_point t0 = Clock::now();
+                try
+                {
+                    auto routes = engine.find_routes(q.origin_cd, {q.dest_cd}, q.timestamp, q.profile, cfg.max_rounds);
+                    if (!routes.empty())
+                        engine.rank_routes(routes, q.profile);
+                }
+                catch (const std::exception &)
+                {
+                    ++out.errors;
+                }
+                out.latency.add(elapsed_us(t0, Clock::now()));
+            }
+        };
+
+        auto writer = [&](int tid)
+        {
+            auto &out = writer_results[tid];
+            Ticker fac_tick(cfg.facility_rate), cong_tick(cfg.congestion_rate);
+            size_t k = static_cast<size_t>(tid);
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                Clock::time_point now = Clock::now();
+                if (fac_tick.due(now))
+                {
+                    data->apply_facility_scores(pool.facility[k++ % UPDATE_POOL]);
+                    out.facility.add(elapsed_us(now, Clock::now()));
+                    fac_tick.advance();
+                }
+                else if (cong_tick.due(now))
+                {
+                    data->apply_congestion(pool.congestion[k++ % UPDATE_POOL]);
+                    out.congestion.add(elapsed_us(now, Clock::now()));
+                    cong_tick.advance();
+                }
+                else
+                {
+                    // 다음 갱신 시각까지 대기 (종료 확인을 위해 최대 10ms 단위)
+                    Clock::time_point wake = std::min(fac_tick.next(), cong_tick.next());
+                    std::this_thread::sleep_until(std::min(wake, now + std::chrono::milliseconds(10)));
+                }
+            }
+        };
+
+        Clock::time_point start = Clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < cfg.readers; ++t)
+            threads.emplace_back(reader, t);
+        for (int t = 0; t < cfg.writers; ++t)
+            threads.emplace_back(writer, t);
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(cfg.duration_s));
+        stop = true;
+        for (auto &th : threads)
+            th.join();
+        double secs = elapsed_us(start, Clock::now()) / 1e6;
+
+        LatencyStats reads, fac, cong;
+        size_t errors = 0;
+        for (auto &r : reader_results)
+        {
+            reads.merge(r.latency);
+            errors += r.errors;
+        }
+        for (auto &w : writer_results)
+        {
+            fac.merge(w.facility);
+            cong.merge(w.congestion);
+        }
+
+        std::printf("readers=%d writers=%d facility_rate=%.1f/s congestion_rate=%.1f/s batch=%zu max_rounds=%d\n",
+                    cfg.readers, cfg.writers, cfg.facility_rate, cfg.congestion_rate, cfg.batch, cfg.max_rounds);
+        std::printf("wall=%.3fs reads=%zu (%.1f q/s, errors=%zu) facility_updates=%zu (%.1f/s) "
+                    "congestion_updates=%zu (%.1f/s)\n\n",
+                    secs, reads.count(), reads.count() / secs, errors, fac.count(), fac.count() / secs,
+                    cong.count(), cong.count() / secs);
+
+        LatencyStats::print_header();
+        reads.print_row("read");
+        fac.print_row("facility");
+        cong.print_row("congestion");
+        base_fac.print_row("fac_idle");
+        base_cong.print_row("cong_idle");
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "stress_bench: %s\n", e.what());
+        return 1;
+    }
+}
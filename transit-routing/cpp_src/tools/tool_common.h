@@ -0,0 +1,203 @@
+#pragma once
+// 오프라인 도구(tools/) 공용 헬퍼: 인자 파싱, 스냅샷/쿼리 로그 로딩, 지연시간 통계
+#include "data_loader.h"
+#include "snapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pathfinding
+{
+    namespace tools
+    {
+        using Clock = std::chrono::steady_clock;
+
+        inline double elapsed_us(Clock::time_point from, Clock::time_point to)
+        {
+            return std::chrono::duration<double, std::micro>(to - from).count();
+        }
+
+        // "--key value" / "--flag" 형태의 단순 인자 파서
+        class Args
+        {
+        public:
+            Args(int argc, char **argv)
+            {
+                for (int i = 1; i < argc; ++i)
+                {
+                    std::string key = argv[i];
+                    if (key.rfind("--", 0) != 0)
+                        throw std::runtime_error("Unexpected argument: " + key);
+                    key = key.substr(2);
+                    if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0)
+                        values_[key] = argv[++i];
+                    else
+                        values_[key] = "";
+                }
+            }
+
+            bool has(const std::string &key) const { return values_.count(key) > 0; }
+
+            std::string get(const std::string &key, const std::string &def = "") const
+            {
+                auto it = values_.find(key);
+                return it != values_.end() ? it->second : def;
+            }
+
+            std::string require(const std::string &key) const
+            {
+                auto it = values_.find(key);
+                if (it == values_.end() || it->second.empty())
+                    throw std::runtime_error("Missing required argument --" + key);
+                return it->second;
+            }
+
+            int get_int(const std::string &key, int def) const
+            {
+                return has(key) ? std::stoi(get(key)) : def;
+            }
+
+            double get_double(const std::string &key, double def) const
+            {
+                return has(key) ? std::stod(get(key)) : def;
+            }
+
+        private:
+            std::map<std::string, std::string> values_;
+        };
+
+        // 스냅샷 파일 -> 공유 DataContainer
+        inline std::unique_ptr<DataContainer> load_container(const std::string &path)
+        {
+            auto data = std::make_unique<DataContainer>();
+            data->load_snapshot(read_snapshot(path));
+            return data;
+        }
+
+        // 기록된 쿼리 한 건 (origin, destination, profile, timestamp)
+        struct QueryRecord
+        {
+            std::string origin_cd;
+            std::string dest_cd;
+            std::string profile;
+            double timestamp = 0.0;
+        };
+
+        // CSV: origin_cd,dest_cd,profile,timestamp ('#' 주석, 헤더 행 허용)
+        inline std::vector<QueryRecord> read_query_log(const std::string &path)
+        {
+            std::ifstream in(path);
+            if (!in)
+                throw std::runtime_error("Cannot open query log: " + path);
+
+            std::vector<QueryRecord> out;
+            std::string line;
+            while (std::getline(in, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (line.empty() || line[0] == '#' || line.rfind("origin", 0) == 0)
+                    continue;
+
+                std::vector<std::string> f;
+                std::stringstream ss(line);
+                std::string cell;
+                while (std::getline(ss, cell, ','))
+                    f.push_back(cell);
+                if (f.size() != 4)
+                    throw std::runtime_error("Bad query log line: " + line);
+                out.push_back({f[0], f[1], f[2], std::stod(f[3])});
+            }
+            return out;
+        }
+
+        inline void write_query_log(const std::vector<QueryRecord> &records, const std::string &path)
+        {
+            std::ofstream out(path);
+            if (!out)
+                throw std::runtime_error("Cannot write query log: " + path);
+            out.precision(15);
+            out << "origin_cd,dest_cd,profile,timestamp\n";
+            for (const auto &r : records)
+                out << r.origin_cd << ',' << r.dest_cd << ',' << r.profile << ',' << r.timestamp << '\n';
+        }
+
+        // 지연시간 샘플 (마이크로초) 및 백분위수
+        class LatencyStats
+        {
+        public:
+            void add(double us)
+            {
+                samples_.push_back(us);
+                sorted_ = false;
+            }
+
+            void merge(const LatencyStats &o)
+            {
+                samples_.insert(samples_.end(), o.samples_.begin(), o.samples_.end());
+                sorted_ = false;
+            }
+
+            size_t count() const { return samples_.size(); }
+
+            double percentile(double p)
+            {
+                if (samples_.empty())
+                    return 0.0;
+                sort();
+                size_t idx = static_cast<size_t>(p / 100.0 * (samples_.size() - 1) + 0.5);
+                return samples_[std::min(idx, samples_.size() - 1)];
+            }
+
+            double mean() const
+            {
+                if (samples_.empty())
+                    return 0.0;
+                double sum = 0.0;
+                for (double s : samples_)
+                    sum += s;
+                return sum / samples_.size();
+            }
+
+            double max()
+            {
+                sort();
+                return samples_.empty() ? 0.0 : samples_.back();
+            }
+
+            // "label  n  mean  p50  p90  p99  p99.9  max" (ms 단위)
+            void print_row(const std::string &label)
+            {
+                std::printf("%-12s %8zu %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n", label.c_str(), count(),
+                            mean() / 1000.0, percentile(50) / 1000.0, percentile(90) / 1000.0,
+                            percentile(99) / 1000.0, percentile(99.9) / 1000.0, max() / 1000.0);
+            }
+
+            static void print_header()
+            {
+                std::printf("%-12s %8s %9s %9s %9s %9s %9s %9s\n", "", "count", "mean_ms", "p50_ms",
+                            "p90_ms", "p99_ms", "p99.9_ms", "max_ms");
+            }
+
+        private:
+            void sort()
+            {
+                if (!sorted_)
+                {
+                    std::sort(samples_.begin(), samples_.end());
+                    sorted_ = true;
+                }
+            }
+
+            std::vector<double> samples_;
+            bool sorted_ = false;
+        };
+    }
+}
@@ -0,0 +1,341 @@
+// 최악 쿼리 탐색 도구 (지연시간 꼬리 추적)
+//
+// OD 쌍 x 장애 유형 x 출발 시간대를 전수 또는 적응형으로 탐색하여
+// 생성 라벨 수 / 라운드 수 / 실행 시간 기준으로 순위를 매기고,
+// 상위 케이스를 replay_driver 입력 형식(CSV)의 회귀 코퍼스로 저장한다.
+//
+// 사용법:
+//   worst_case_sweep --snapshot net.snap [--mode adaptive|exhaustive]
+//                    [--profiles PHY,VIS,AUD,ELD] [--slots 480,1080 | --slots all]
+//                    [--date 2025-03-12] [--rank-by labels|rounds|time]
+//                    [--samples 2000] [--generations 4] [--elite 25]
+//                    [--stride 1] [--top 50] [--repeat 3] [--threads 8]
+//                    [--max-rounds 5] [--out worst_cases.csv]
+//
+// - exhaustive: 모든 (origin, dest) 쌍 (--stride로 역 간격 조절) x 유형 x 시간대
+// - adaptive:   무작위 샘플에서 시작하여 상위(elite) 케이스의 이웃
+//               (인접역/환승역, 인접 시간대, 다른 장애 유형)을 세대별로 확장
+
+#include "engine.h"
+#include "utils.h"
+#include "tools/tool_common.h"
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+using namespace pathfinding;
+using namespace pathfinding::tools;
+
+namespace
+{
+    const char *PROFILE_NAMES[] = {"PHY", "VIS", "AUD", "ELD"};
+
+    struct Candidate
+    {
+        StationID origin;
+        StationID dest;
+        int profile; // PROFILE_NAMES 인덱스
+        int slot;    // 자정 기준 분 (30분 단위)
+
+        uint64_t key() const
+        {
+            return (static_cast<uint64_t>(origin) << 32) | (static_cast<uint64_t>(dest) << 16) |
+                   (static_cast<uint64_t>(profile) << 12) | static_cast<uint64_t>(slot / 30);
+        }
+    };
+
+    struct Measurement
+    {
+        Candidate c;
+        SearchStats stats;
+        double wall_us = 0.0;
+        size_t routes = 0;
+        bool error = false;
+    };
+
+    struct SweepConfig
+    {
+        std::vector<int> profiles;
+        std::vector<int> slots;
+        double day_start = 0.0; // --date 자정 (로컬 시간) Unix timestamp
+        std::string rank_by = "labels";
+        int max_rounds = 5;
+        int threads = 1;
+    };
+
+    double parse_date(const std::string &date)
+    {
+        std::tm tm = {};
+        if (std::sscanf(date.c_str(), "%d-%d-%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday) != 3)
+            throw std::runtime_error("Bad --date (YYYY-MM-DD): " + date);
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+        tm.tm_isdst = -1;
+        return static_cast<double>(std::mktime(&tm));
+    }
+
+    std::vector<std::string> split_csv(const std::string &s)
+    {
+        std::vector<std::string> out;
+        std::stringstream ss(s);
+        std::string cell;
+        while (std::getline(ss, cell, ','))
+            if (!cell.empty())
+                out.push_back(cell);
+        return out;
+    }
+
+    double rank_score(const Measurement &m, const std::string &rank_by)
+    {
+        if (rank_by == "rounds")
+            return m.stats.rounds * 1e9 + static_cast<double>(m.stats.labels_created);
+        if (rank_by == "time")
+            return m.wall_us;
+        return static_cast<double>(m.stats.labels_created);
+    }
+
+    // 후보 목록을 스레드별 엔진으로 병렬 실행
+    std::vector<Measurement> evaluate(const DataContainer &data, const std::vector<Candidate> &cands,
+                                      const SweepConfig &cfg)
+    {
+        std::vector<Measurement> out(cands.size());
+        std::atomic<size_t> next{0};
+
+        auto worker = [&]()
+        {
+            McRaptorEngine engine(data);
+            while (true)
+            {
+                size_t i = next.fetch_add(1);
+                if (i >= cands.size())
+                    break;
+                const Candidate &c = cands[i];
+                Measurement &m = out[i];
+                m.c = c;
+
+                const std::string profile = PROFILE_NAMES[c.profile];
+                Clock::time_point t0 = Clock::now();
+                try
+                {
+                    auto routes = engine.find_routes(data.get_code(c.origin), {data.get_code(c.dest)},
+                                                     cfg.day_start + c.slot * 60.0, profile, cfg.max_rounds);
+                    if (!routes.empty())
+                        routes = engine.rank_routes(routes, profile);
+                    m.routes = routes.size();
+                }
+                catch (const std::exception &)
+                {
+                    m.error = true;
+                }
+                m.wall_us = elapsed_us(t0, Clock::now());
+                m.stats = engine.last_stats();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 0; t < cfg.threads; ++t)
+            pool.emplace_back(worker);
+        for (auto &th : pool)
+            th.join();
+        return out;
+    }
+
+    // 노선상 인접역 + 환승 도착역
+    std::vector<StationID> station_neighbors(const DataContainer &data, StationID id)
+    {
+        std::vector<StationID> out;
+        const auto &lines = data.get_lines(id);
+        for (const auto &line : lines)
+        {
+            const auto &dl = data.get_next_stations(id, line);
+            for (const auto *dir : {&dl.up, &dl.down, &dl.in, &dl.out})
+                if (!dir->empty())
+                    out.push_back(dir->front());
+        }
+        if (!lines.empty())
+        {
+            for (const auto &t_line : data.get_transfer_lines(id))
+            {
+                const TransferData *td = data.get_transfer(id, lines.front(), t_line);
+                if (td)
+                    out.push_back(td->to_station_id);
+            }
+        }
+        return out;
+    }
+
+    std::vector<Candidate> neighbors(const DataContainer &data, const Candidate &c, const SweepConfig &cfg)
+    {
+        std::vector<Candidate> out;
+        for (StationID o : station_neighbors(data, c.origin))
+            if (o != c.dest)
+                out.push_back({o, c.dest, c.profile, c.slot});
+        for (StationID d : station_neighbors(data, c.dest))
+            if (d != c.origin)
+                out.push_back({c.origin, d, c.profile, c.slot});
+        for (int delta : {-30, 30})
+        {
+            int slot = c.slot + delta;
+            if (slot >= 0 && slot < 1440)
+                out.push_back({c.origin, c.dest, c.profile, slot});
+        }
+        for (int p : cfg.profiles)
+            if (p != c.profile)
+                out.push_back({c.origin, c.dest, p, c.slot});
+        return out;
+    }
+
+    std::vector<Candidate> exhaustive_candidates(const DataContainer &data, const SweepConfig &cfg, int stride)
+    {
+        std::vector<Candidate> out;
+        StationID n = static_cast<StationID>(data.station_count());
+        for (StationID o = 0; o < n; o += stride)
+            for (StationID d = 0; d < n; d += stride)
+            {
+                if (o == d)
+                    continue;
+                for (int p : cfg.profiles)
+                    for (int slot : cfg.slots)
+                        out.push_back({o, d, p, slot});
+            }
+        return out;
+    }
+
+    std::vector<Measurement> adaptive_sweep(const DataContainer &data, const SweepConfig &cfg, int samples,
+                                            int generations, int elite, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> station_dist(0, static_cast<int>(data.station_count()) - 1);
+        std::uniform_int_distribution<size_t> profile_dist(0, cfg.profiles.size() - 1);
+        std::uniform_int_distribution<size_t> slot_dist(0, cfg.slots.size() - 1);
+
+        std::unordered_set<uint64_t> seen;
+        std::vector<Candidate> batch;
+        int attempts = 0;
+        while (static_cast<int>(batch.size()) < samples && attempts++ < samples * 20)
+        {
+            Candidate c{static_cast<StationID>(station_dist(rng)), static_cast<StationID>(station_dist(rng)),
+                        cfg.profiles[profile_dist(rng)], cfg.slots[slot_dist(rng)]};
+            if (c.origin != c.dest && seen.insert(c.key()).second)
+                batch.push_back(c);
+        }
+
+        std::vector<Measurement> all;
+        for (int g = 0; g <= generations && !batch.empty(); ++g)
+        {
+            auto results = evaluate(data, batch, cfg);
+            all.insert(all.end(), results.begin(), results.end());
+            std::fprintf(stderr, "[gen %d] evaluated %zu (total %zu)\n", g, batch.size(), all.size());
+
+            // 현재까지 상위 elite개의 이웃 중 미평가 후보를 다음 세대로
+            std::partial_sort(all.begin(), all.begin() + std::min<size_t>(elite, all.size()), all.end(),
+                              [&](const Measurement &a, const Measurement &b)
+                              { return rank_score(a, cfg.rank_by) > rank_score(b, cfg.rank_by); });
+            batch.clear();
+            for (size_t i = 0; i < std::min<size_t>(elite, all.size()); ++i)
+                for (const auto &n : neighbors(data, all[i].c, cfg))
+                    if (seen.insert(n.key()).second)
+                        batch.push_back(n);
+        }
+        return all;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        Args args(argc, argv);
+        SweepConfig cfg;
+        cfg.threads = std::max(1, args.get_int("threads", static_cast<int>(std::thread::hardware_concurrency())));
+        cfg.max_rounds = args.get_int("max-rounds", 5);
+        cfg.rank_by = args.get("rank-by", "labels");
+        cfg.day_start = parse_date(args.get("date", "2025-03-12"));
+
+        for (const auto &p : split_csv(args.get("profiles", "PHY,VIS,AUD,ELD")))
+            cfg.profiles.push_back(static_cast<int>(PathfindingUtils::str_to_disability(p)));
+
+        std::string slots = args.get("slots", "480,1080");
+        if (slots == "all")
+            for (int s = 0; s < 1440; s += 30)
+                cfg.slots.push_back(s);
+        else
+            for (const auto &s : split_csv(slots))
+                cfg.slots.push_back(std::stoi(s) / 30 * 30);
+        if (cfg.profiles.empty() || cfg.slots.empty())
+            throw std::runtime_error("--profiles/--slots must not be empty");
+
+        auto data = load_container(args.require("snapshot"));
+        if (data->station_count() < 2)
+            throw std::runtime_error("Snapshot has fewer than 2 stations");
+
+        std::vector<Measurement> results;
+        if (args.get("mode", "adaptive") == "exhaustive")
+        {
+            auto cands = exhaustive_candidates(*data, cfg, std::max(1, args.get_int("stride", 1)));
+            std::fprintf(stderr, "exhaustive: %zu candidates\n", cands.size());
+            results = evaluate(*data, cands, cfg);
+        }
+        else
+        {
+            results = adaptive_sweep(*data, cfg, args.get_int("samples", 2000), args.get_int("generations", 4),
+                                     args.get_int("elite", 25), static_cast<uint32_t>(args.get_int("seed", 42)));
+        }
+
+        std::sort(results.begin(), results.end(), [&](const Measurement &a, const Measurement &b)
+                  { return rank_score(a, cfg.rank_by) > rank_score(b, cfg.rank_by); });
+        size_t top = std::min<size_t>(static_cast<size_t>(args.get_int("top", 50)), results.size());
+        results.resize(top);
+
+        // 상위 케이스는 반복 측정하여 실행 시간 중앙값 사용 (잡음 제거)
+        int repeat = std::max(1, args.get_int("repeat", 3));
+        if (repeat > 1)
+        {
+            std::vector<Candidate> cands;
+            for (const auto &m : results)
+                cands.push_back(m.c);
+            std::vector<std::vector<double>> times(results.size());
+            for (int r = 0; r < repeat; ++r)
+            {
+                auto again = evaluate(*data, cands, cfg);
+                for (size_t i = 0; i < again.size(); ++i)
+                    times[i].push_back(again[i].wall_us);
+            }
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                std::sort(times[i].begin(), times[i].end());
+                results[i].wall_us = times[i][times[i].size() / 2];
+            }
+        }
+
+        std::printf("%4s %-8s %-8s %-4s %5s %10s %10s %6s %6s %9s %6s\n", "rank", "origin", "dest", "type",
+                    "slot", "labels", "dominated", "rounds", "marked", "wall_ms", "routes");
+        std::vector<QueryRecord> corpus;
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto &m = results[i];
+            std::string o = data->get_code(m.c.origin), d = data->get_code(m.c.dest);
+            std::printf("%4zu %-8s %-8s %-4s %02d:%02d %10zu %10zu %6d %6zu %9.3f %6zu%s\n", i + 1, o.c_str(),
+                        d.c_str(), PROFILE_NAMES[m.c.profile], m.c.slot / 60, m.c.slot % 60,
+                        m.stats.labels_created, m.stats.labels_dominated, m.stats.rounds, m.stats.peak_marked,
+                        m.wall_us / 1000.0, m.routes, m.stats.aborted ? " ABORTED" : (m.error ? " ERROR" : ""));
+            corpus.push_back({o, d, PROFILE_NAMES[m.c.profile], cfg.day_start + m.c.slot * 60.0});
+        }
+
+        if (args.has("out"))
+        {
+            write_query_log(corpus, args.require("out"));
+            std::fprintf(stderr, "corpus written: %s (%zu queries)\n", args.get("out").c_str(), corpus.size());
+        }
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "worst_case_sweep: %s\n", e.what());
+        return 1;
+    }
+}
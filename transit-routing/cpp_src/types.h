@@ -10,6 +10,7 @@ namespace pathfinding
 {
     // 최적화된 타입 정의
     using StationID = uint16_t;
+    using LineID = uint16_t; // DataContainer::line_id (노선명 정수 ID)
     using LabelIndex = int32_t;
 
     // 방향 Enum (1 byte)
@@ -74,6 +75,22 @@ namespace pathfinding
         StationID to_station_id; // 환승 시 도착하는 역 code
     };
 
+    // 도보 연결 (이름이 다른 인접 역 간, 역 ID 기준 인접 리스트의 원소)
+    struct Footpath
+    {
+        StationID to_station_id;
+        double distance;
+        // 장애 유형별 도보 시간 (분), 해당 유형의 허용 도보 시간을 넘으면 +inf
+        std::array<double, static_cast<size_t>(DisabilityType::COUNT)> minutes;
+    };
+
+    // 재구성된 경로의 정차 1개 (노선 ID는 DataContainer::line_name, 알 수 없는 노선은 -1)
+    struct PathStop
+    {
+        StationID station_id;
+        int32_t line_id;
+    };
+
     // Label (Memory Pool 최적화)
     struct Label
     {
@@ -100,4 +117,20 @@ namespace pathfinding
         double avg_congestion() const { return depth > 0 ? congestion_sum / depth : 0.0; }
     };
 
+    // 탐색 통계 (마지막 find_routes 호출 기준)
+    struct SearchStats
+    {
+        size_t labels_created = 0;   // label_pool_에 생성된 라벨 수
+        size_t labels_dominated = 0; // 생성 후 지배당해 버려진 라벨 수
+        int rounds = 0;              // 실제 수행된 라운드 수
+        size_t peak_marked = 0;      // 라운드 시작 시 마킹된 역 수의 최댓값
+        bool aborted = false;        // 큐 폭증으로 탐색 중단
+        size_t routes_reused = 0;    // reroute: 이전 탐색 트리에서 복구한 목적지 경로 수
+        int parallel_rounds = 0;     // 마킹된 역을 병렬로 스캔한 라운드 수
+        bool preempted = false;      // 라운드 경계 검사(RoundGuard)로 max_rounds 전에 종료
+        size_t labels_capped = 0;    // bag 상한(SearchEffort::max_bag_size)으로 버려진 라벨 수
+        int effort_level = 0;        // 적용된 탐색 강도 단계 (SearchEffort::level)
+        size_t labels_pruned = 0;    // reroute: 목적지 경로보다 나아질 수 없어 버려진 라벨 수 (목표 가지치기)
+    };
+
 } // namespace pathfinding
\ No newline at end of file
@@ -136,27 +136,72 @@ namespace pathfinding
         return 0.98;
     }
 
+    namespace
+    {
+        // std::localtime은 정적 버퍼를 공유하므로 다중 스레드 쿼리에서 데이터 경합 발생
+        // -> 호출자 버퍼를 쓰는 재진입 버전 사용
+        std::tm local_tm(double timestamp)
+        {
+            std::time_t t = static_cast<std::time_t>(timestamp);
+            std::tm tm_buf = {};
+#ifdef _WIN32
+            localtime_s(&tm_buf, &t);
+#else
+            localtime_r(&t, &tm_buf);
+#endif
+            return tm_buf;
+        }
+    }
+
     std::string PathfindingUtils::get_day_type(double timestamp)
     {
-        std::time_t t = static_cast<std::time_t>(timestamp);
-        std::tm *tm_ptr = std::localtime(&t);
+        std::tm tm = local_tm(timestamp);
 
-        // Windows/Linux 호환성을 위해 localtime_r 또는 localtime_s 권장되나
-        // 표준 C++에서는 localtime 후 즉시 사용하면 됨 (Thread-safe issue 주의)
-        if (tm_ptr->tm_wday == 0)
+        if (tm.tm_wday == 0)
             return "sun";
-        if (tm_ptr->tm_wday == 6)
+        if (tm.tm_wday == 6)
             return "sat";
         return "weekday";
     }
 
     std::string PathfindingUtils::get_time_column(double timestamp)
     {
-        std::time_t t = static_cast<std::time_t>(timestamp);
-        std::tm *tm_ptr = std::localtime(&t);
-
         // 30분 단위 슬롯 (0~1410)
-        int slot = (tm_ptr->tm_hour * 60 + tm_ptr->tm_min) / 30 * 30;
-        return "t_" + std::to_string(slot);
+        return "t_" + std::to_string(get_time_slot(timestamp) * 30);
+    }
+
+    int PathfindingUtils::get_time_slot(double timestamp)
+    {
+        std::tm tm = local_tm(timestamp);
+        return (tm.tm_hour * 60 + tm.tm_min) / 30;
+    }
+
+    // 역 이름 정규화 (예: "서울역(1호선)" -> "서울")
+    std::string PathfindingUtils::normalize_station_name(std::string name)
+    {
+        // 1. 괄호 '(' 제거 (예: "서울역(1호선)" -> "서울역")
+        size_t paren_pos = name.find('(');
+        if (paren_pos != std::string::npos)
+        {
+            name = name.substr(0, paren_pos);
+        }
+
+        // 2. "역" 글자 제거 (UTF-8에서 "역"은 3바이트: 0xEC, 0x97, 0xAD)
+        // 단순하게 끝이 "역"으로 끝나면 제거
+        std::string suffix = "역";
+        if (name.length() >= suffix.length())
+        {
+            if (name.compare(name.length() - suffix.length(), suffix.length(), suffix) == 0)
+            {
+                name = name.substr(0, name.length() - suffix.length());
+            }
+        }
+
+        // 3. 앞뒤 공백 제거 (간단 구현)
+        const char *ws = " \t\n\r\f\v";
+        name.erase(name.find_last_not_of(ws) + 1);
+        name.erase(0, name.find_first_not_of(ws));
+
+        return name;
     }
-}
\ No newline at end of file
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <unordered_map>
@@ -23,6 +24,13 @@ namespace pathfinding
             return R * c;
         }
 
+        // 역간 열차 주행 시간 (분): 평균 550m/분, 최소 1분
+        static constexpr double RIDE_METERS_PER_MINUTE = 550.0;
+        static inline double ride_minutes(double distance_m)
+        {
+            return std::max(distance_m / RIDE_METERS_PER_MINUTE, 1.0);
+        }
+
         static inline double normalize_score(double raw_score)
         {
             return 1.0 / (1.0 + std::exp(-0.3 * raw_score));
@@ -56,5 +64,10 @@ namespace pathfinding
 
         static std::string get_day_type(double timestamp);
         static std::string get_time_column(double timestamp);
+        // 현지 시각 30분 단위 슬롯 번호 (0~47, get_time_column의 t_{slot*30})
+        static int get_time_slot(double timestamp);
+
+        // 역 이름 정규화: 괄호 이후, 끝의 "역", 앞뒤 공백 제거 (역 이름 매칭/검색 키)
+        static std::string normalize_station_name(std::string name);
     };
 }
\ No newline at end of file
@@ -25,6 +25,18 @@ ext_modules = [
             'cpp_src/engine.cpp',
             'cpp_src/data_loader.cpp',
             'cpp_src/utils.cpp',
+            'cpp_src/snapshot.cpp',
+            'cpp_src/spatial_index.cpp',
+            'cpp_src/station_search.cpp',
+            'cpp_src/route_set.cpp',
+            'cpp_src/route_payload.cpp',
+            'cpp_src/result_cache.cpp',
+            'cpp_src/cache_warmer.cpp',
+            'cpp_src/query_sketch.cpp',
+            'cpp_src/cache_checkpointer.cpp',
+            'cpp_src/navigation_tracker.cpp',
+            'cpp_src/distance_kernels.cpp',
+            'cpp_src/query_pool.cpp',
         ],
         include_dirs=[
             'cpp_src',
@@ -57,6 +69,9 @@ class BuildExt(build_ext):
         if ct == 'unix':
             opts.append('-DVERSION_INFO="%s"' % self.distribution.get_version())
             opts.append('-fvisibility=hidden')
+            opts.append('-fno-math-errno')  # sqrt 루프 자동 벡터화 (distance_kernels)
+            opts.append('-pthread')  # QueryPool 워커 스레드
+            link_opts.append('-pthread')
 
         elif ct == 'msvc':
             opts.append('/DVERSION_INFO=\\"%s\\"' % self.distribution.get_version())
@@ -0,0 +1,256 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+"""
+Python McRaptor vs C++ McRaptorEngine 차등(differential) 성능/정확도 하네스
+
+합성 fixture 네트워크(DB/Redis 불필요)에서 무작위 OD 샘플을 두 엔진으로 실행하고
+- 파레토 집합 비교: (도착 시간, 환승 횟수) 비지배 집합이 허용 오차 내에서 일치하는지
+- 상위 3개 순위 비교: 환승 패턴(환승역 이름, from_line, to_line) 순서가 일치하는지
+- 쿼리 유형(장애 유형 x 최소 환승 횟수)별 속도 향상(Python 시간 / C++ 시간)
+을 보고합니다.
+
+C++ 최적화 전후 비교용으로 C++ 결과를 golden 파일로 저장/대조할 수도 있습니다.
+
+사용법 (transit-routing 디렉토리에서):
+    python tests/differential/differential_harness.py --pairs 500
+    python tests/differential/differential_harness.py --pairs 500 --save-golden golden.json
+    python tests/differential/differential_harness.py --pairs 500 --golden golden.json --skip-python
+
+불일치가 하나라도 있으면 exit code 1 (--max-mismatch-rate로 허용 비율 지정)
+"""
+
+import argparse
+import json
+import os
+import random
+import statistics
+import sys
+import time
+from collections import defaultdict
+from datetime import datetime
+from typing import Dict, List, Tuple
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.abspath(os.path.join(HERE, "..", "..")))
+sys.path.insert(0, HERE)
+
+from fixture_network import build_fixture_network  # noqa: E402
+
+PROFILES = ("PHY", "VIS", "AUD", "ELD")
+
+# 평일 08:30 (로컬 시간) => 출근 시간대 혼잡도
+DEFAULT_DEPARTURE = datetime(2025, 3, 12, 8, 30)
+
+
+def pareto_front(points: List[Tuple[float, int]]) -> List[Tuple[float, int]]:
+    """(도착 시간, 환승 횟수) 비지배 집합 (정렬된 리스트)"""
+    front = []
+    for t, k in sorted(set(points), key=lambda p: (p[1], p[0])):
+        if not any(ft <= t and fk <= k for ft, fk in front):
+            front.append((t, k))
+    return sorted(front)
+
+
+def fronts_match(a, b, time_tol: float) -> bool:
+    """두 파레토 집합이 환승 횟수별로 허용 오차 내 도착 시간을 가지는지"""
+    if len(a) != len(b):
+        return False
+    by_k_a = {k: t for t, k in a}
+    by_k_b = {k: t for t, k in b}
+    if by_k_a.keys() != by_k_b.keys():
+        return False
+    return all(abs(by_k_a[k] - by_k_b[k]) <= time_tol for k in by_k_a)
+
+
+def dedupe_patterns(patterns: List[tuple], limit: int = 3) -> List[tuple]:
+    """순위 순서를 유지한 채 중복 환승 패턴 제거 후 상위 limit개"""
+    seen, out = set(), []
+    for p in patterns:
+        if p not in seen:
+            seen.add(p)
+            out.append(p)
+        if len(out) == limit:
+            break
+    return out
+
+
+class CppRunner:
+    def __init__(self, cpp_module, net, max_rounds: int):
+        self.cpp = cpp_module
+        self.net = net
+        self.container = net.load_cpp(cpp_module)
+        self.max_rounds = max_rounds
+
+    def run(self, origin: str, dest: str, profile: str, departure: datetime):
+        engine = self.cpp.McRaptorEngine(self.container)
+        start = time.perf_counter()
+        routes = engine.find_routes(
+            origin, {dest}, departure.timestamp(), profile, self.max_rounds
+        )
+        ranked = engine.rank_routes(routes, profile) if routes else []
+        elapsed = time.perf_counter() - start
+
+        front = pareto_front([(round(r.arrival_time, 3), r.transfers) for r in routes])
+        patterns = []
+        for label in ranked:
+            seq = engine.reconstruct_route(label, self.container)
+            lines = engine.reconstruct_lines(label)
+            patterns.append(
+                tuple(
+                    (self.net.stations[seq[i + 1]]["name"], lines[i], lines[i + 1])
+                    for i in range(min(len(seq), len(lines)) - 1)
+                    if lines[i] != lines[i + 1]
+                )
+            )
+        return elapsed, front, dedupe_patterns(patterns)
+
+
+class PythonRunner:
+    def __init__(self, net, max_rounds: int):
+        self.net = net
+        self.engine = net.build_python_engine()
+        self.max_rounds = max_rounds
+
+    def run(self, origin: str, dest: str, profile: str, departure: datetime):
+        start = time.perf_counter()
+        routes = self.engine.find_routes(
+            origin, {dest}, departure, profile, self.max_rounds
+        )
+        ranked = self.engine.rank_routes(routes, profile) if routes else []
+        elapsed = time.perf_counter() - start
+
+        front = pareto_front([(round(r.arrival_time, 3), r.transfers) for r in routes])
+        patterns = [
+            tuple(
+                (self.net.stations[cd]["name"], f_line, t_line)
+                for cd, f_line, t_line in label.reconstruct_transfer_info()
+            )
+            for label, _score in ranked
+        ]
+        return elapsed, front, dedupe_patterns(patterns)
+
+
+def sample_queries(net, pairs: int, seed: int) -> List[Tuple[str, str, str]]:
+    rng = random.Random(seed)
+    codes = net.station_codes
+    queries = []
+    while len(queries) < pairs:
+        origin, dest = rng.sample(codes, 2)
+        if net.stations[origin]["name"] == net.stations[dest]["name"]:
+            continue  # 같은 환승역의 다른 노선 => 의미 없는 쿼리
+        queries.append((origin, dest, rng.choice(PROFILES)))
+    return queries
+
+
+def query_class(profile: str, front) -> str:
+    min_k = min((k for _, k in front), default=None)
+    if min_k is None:
+        return f"{profile}/none"
+    return f"{profile}/{min(min_k, 2)}{'+' if min_k >= 2 else ''}tr"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--pairs", type=int, default=200, help="OD 샘플 수")
+    parser.add_argument("--seed", type=int, default=42, help="OD 샘플 seed")
+    parser.add_argument("--net-seed", type=int, default=7, help="fixture 네트워크 seed")
+    parser.add_argument("--lines", type=int, default=6)
+    parser.add_argument("--stations-per-line", type=int, default=20)
+    parser.add_argument("--max-rounds", type=int, default=5)
+    parser.add_argument(
+        "--time-tolerance", type=float, default=1.0, help="도착 시간 허용 오차(분)"
+    )
+    parser.add_argument(
+        "--max-mismatch-rate",
+        type=float,
+        default=0.0,
+        help="파레토/상위 3개 불일치 비율이 이 값을 넘으면 exit code 1 (기본 0: 불일치 1건이라도 실패)",
+    )
+    parser.add_argument("--skip-python", action="store_true")
+    parser.add_argument("--save-golden", help="C++ 결과를 JSON으로 저장")
+    parser.add_argument("--golden", help="저장된 C++ 결과와 대조")
+    args = parser.parse_args()
+
+    import pathfinding_cpp
+
+    net = build_fixture_network(args.lines, args.stations_per_line, args.net_seed)
+    queries = sample_queries(net, args.pairs, args.seed)
+    print(
+        f"fixture: {len(net.stations)}개 역, {len(net.transfer_distances)}개 환승, "
+        f"OD 샘플 {len(queries)}개"
+    )
+
+    cpp_runner = CppRunner(pathfinding_cpp, net, args.max_rounds)
+    py_runner = None if args.skip_python else PythonRunner(net, args.max_rounds)
+    golden = None
+    if args.golden:
+        with open(args.golden, encoding="utf-8") as f:
+            golden = json.load(f)
+
+    cpp_times: Dict[str, List[float]] = defaultdict(list)
+    py_times: Dict[str, List[float]] = defaultdict(list)
+    mismatches: Dict[str, int] = defaultdict(int)
+    golden_out = []
+
+    for i, (origin, dest, profile) in enumerate(queries):
+        c_time, c_front, c_top = cpp_runner.run(origin, dest, profile, DEFAULT_DEPARTURE)
+        cls = query_class(profile, c_front)
+        cpp_times[cls].append(c_time)
+        golden_out.append(
+            {"query": [origin, dest, profile], "front": c_front, "top3": c_top}
+        )
+
+        if golden is not None:
+            g = golden[i]
+            g_front = [tuple(p) for p in g["front"]]
+            g_top = [tuple(tuple(step) for step in p) for p in g["top3"]]
+            if g["query"] != [origin, dest, profile]:
+                print("golden 파일의 쿼리 샘플이 다릅니다 (--seed/--pairs 확인)")
+                return 2
+            if not fronts_match(c_front, g_front, args.time_tolerance):
+                mismatches["golden_pareto"] += 1
+            if c_top != g_top:
+                mismatches["golden_top3"] += 1
+
+        if py_runner is not None:
+            p_time, p_front, p_top = py_runner.run(
+                origin, dest, profile, DEFAULT_DEPARTURE
+            )
+            py_times[cls].append(p_time)
+            if not fronts_match(c_front, p_front, args.time_tolerance):
+                mismatches["pareto"] += 1
+                if mismatches["pareto"] <= 5:
+                    print(f"  [pareto] {origin}->{dest} {profile}: C++={c_front} Py={p_front}")
+            if c_top != p_top:
+                mismatches["top3"] += 1
+
+    if args.save_golden:
+        with open(args.save_golden, "w", encoding="utf-8") as f:
+            json.dump(golden_out, f, ensure_ascii=False)
+        print(f"golden 저장: {args.save_golden}")
+
+    print(f"\n{'class':<12} {'n':>5} {'cpp_ms':>9} {'py_ms':>9} {'speedup':>8}")
+    for cls in sorted(cpp_times):
+        c_ms = statistics.median(cpp_times[cls]) * 1000
+        line = f"{cls:<12} {len(cpp_times[cls]):>5} {c_ms:>9.2f}"
+        if py_times.get(cls):
+            p_ms = statistics.median(py_times[cls]) * 1000
+            line += f" {p_ms:>9.2f} {p_ms / c_ms if c_ms > 0 else 0.0:>7.1f}x"
+        print(line)
+
+    total = len(queries)
+    print()
+    worst_rate = 0.0
+    for kind in ("pareto", "top3", "golden_pareto", "golden_top3"):
+        if kind in mismatches or (
+            kind.startswith("golden") and golden is not None
+        ) or (not kind.startswith("golden") and py_runner is not None):
+            rate = mismatches.get(kind, 0) / total if total else 0.0
+            worst_rate = max(worst_rate, rate)
+            print(f"{kind:<14} 불일치 {mismatches.get(kind, 0)}/{total} ({rate:.1%})")
+
+    return 1 if worst_rate > args.max_mismatch_rate else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,229 @@
+"""
+오프라인 차등 테스트용 합성 지하철 네트워크
+
+DB 없이 Python McRaptor와 C++ McRaptorEngine에 동일한 네트워크를 적재합니다.
+- 격자 형태로 교차하는 노선 (가로/세로 번갈아 배치, 교차 지점은 같은 역 이름 => 환승역)
+- 시간대별 혼잡도, 환승 거리, 편의시설 수치는 seed 기반 난수
+"""
+
+import random
+from dataclasses import dataclass, field
+from typing import Dict, List, Tuple, Any
+
+from app.core.config import CIRCULAR_LINES
+
+DAY_TYPES = ("weekday", "sat", "sun")
+TIME_SLOTS = [f"t_{i}" for i in range(0, 1440, 30)]
+FACILITY_KEYS = (
+    "charger_count",
+    "elevator_count",
+    "escalator_count",
+    "lift_count",
+    "movingwalk_count",
+    "safe_platform_count",
+    "sign_phone_count",
+    "toilet_count",
+    "helper_count",
+)
+
+
+@dataclass
+class FixtureNetwork:
+    """합성 네트워크 원천 데이터 (두 엔진의 입력 형식으로 변환)"""
+
+    # station_cd -> {name, line, lat, lng}
+    stations: Dict[str, Dict[str, Any]] = field(default_factory=dict)
+    # line -> [station_cd, ...] (노선 순서)
+    ordered_lines: Dict[str, List[str]] = field(default_factory=dict)
+    # (station_cd, from_line, to_line) -> 환승 거리(m)
+    transfer_distances: Dict[Tuple[str, str, str], float] = field(default_factory=dict)
+    # (station_cd, line, direction, day_type) -> {t_0: 0.0~1.0, ...}
+    congestion: Dict[Tuple[str, str, str, str], Dict[str, float]] = field(
+        default_factory=dict
+    )
+    # station_cd -> 편의시설 개수 {elevator_count: 2, ...}
+    facility_counts: Dict[str, Dict[str, float]] = field(default_factory=dict)
+
+    @property
+    def station_codes(self) -> List[str]:
+        return list(self.stations.keys())
+
+    # ------------------------------------------------------------------
+    # C++ 엔진 입력 (PathfindingServiceCPP._initialize_cpp_data와 동일한 형식)
+    # ------------------------------------------------------------------
+    def load_cpp(self, cpp_module):
+        """pathfinding_cpp.DataContainer 생성 및 적재"""
+        stations_dict = {
+            cd: {
+                "name": info["name"],
+                "line": info["line"],
+                "latitude": info["lat"],
+                "longitude": info["lng"],
+            }
+            for cd, info in self.stations.items()
+        }
+
+        line_stations_dict = {}
+        station_order_dict = {}
+        for line, cds in self.ordered_lines.items():
+            down_line = list(reversed(cds))
+            for idx, cd in enumerate(cds):
+                d_idx = down_line.index(cd)
+                line_stations_dict[(cd, line)] = {
+                    "up": cds[idx + 1 :],
+                    "down": down_line[d_idx + 1 :],
+                }
+                station_order_dict[(cd, line)] = idx
+
+        transfers_dict = {
+            key: {"distance": dist} for key, dist in self.transfer_distances.items()
+        }
+
+        facility_rows = [
+            {"station_cd_list": [cd], **counts}
+            for cd, counts in self.facility_counts.items()
+        ]
+
+        container = cpp_module.DataContainer()
+        container.load_from_python(
+            stations_dict,
+            line_stations_dict,
+            station_order_dict,
+            transfers_dict,
+            self.congestion,
+        )
+        container.update_facility_scores(facility_rows)
+        return container
+
+    # ------------------------------------------------------------------
+    # Python 엔진 입력 (DB 로딩 단계를 건너뛰고 McRaptor 속성을 직접 구성)
+    # ------------------------------------------------------------------
+    def build_python_engine(self):
+        """DB 접근 없이 app.algorithms.mc_raptor.McRaptor 인스턴스 생성"""
+        from app.algorithms.mc_raptor import McRaptor
+        from app.algorithms.anp_weights import ANPWeightCalculator
+        from app.algorithms.distance_calculator import DistanceCalculator
+
+        anp = ANPWeightCalculator.__new__(ANPWeightCalculator)
+        anp.pairwise_matrices = {
+            "PHY": anp._get_phy_matrix(),
+            "VIS": anp._get_vis_matrix(),
+            "AUD": anp._get_aud_matrix(),
+            "ELD": anp._get_eld_matrix(),
+        }
+        anp._facility_preferences_cache = anp._get_default_facility_preferences()
+        anp.congestion_data = dict(self.congestion)
+
+        engine = McRaptor.__new__(McRaptor)
+        engine.distance_calculator = DistanceCalculator()
+        engine.anp_calculator = anp
+        engine.disability_type = "PHY"
+        engine.max_labels_per_state = 50
+
+        engine.stations = {
+            cd: {
+                "station_name": info["name"],
+                "line": info["line"],
+                "latitude": info["lat"],
+                "longitude": info["lng"],
+            }
+            for cd, info in self.stations.items()
+        }
+
+        engine.station_order_map = {}
+        engine.line_stations = {}
+        for line, cds in self.ordered_lines.items():
+            is_circular = line in CIRCULAR_LINES
+            for i, cd in enumerate(cds):
+                engine.station_order_map[(cd, line)] = i
+                up_stations = cds[:i][::-1]
+                down_stations = cds[i + 1 :]
+                engine.line_stations[(cd, line)] = {
+                    "up": up_stations,
+                    "down": down_stations,
+                    "in": down_stations if is_circular else [],
+                    "out": up_stations if is_circular else [],
+                }
+
+        engine.transfers = {}
+        for key, dist in self.transfer_distances.items():
+            engine.transfers[key] = {
+                "transfer_distance": dist,
+                "facility_scores": self._python_facility_scores(key[0]),
+            }
+        return engine
+
+    def _python_facility_scores(self, station_cd: str) -> Dict[str, Dict[str, float]]:
+        """편의시설 개수 -> Python 엔진의 유형별 시설 점수(0~5)"""
+        counts = self.facility_counts.get(station_cd, {})
+
+        def score(*keys):
+            return min(5.0, sum(counts.get(k, 0.0) for k in keys))
+
+        base = {
+            "elevator": score("elevator_count", "lift_count"),
+            "escalator": score("escalator_count", "movingwalk_count"),
+            "transfer_walk": score("movingwalk_count", "safe_platform_count"),
+            "other_facil": score("toilet_count", "charger_count", "sign_phone_count"),
+            "staff_help": score("helper_count"),
+        }
+        return {dtype: dict(base) for dtype in ("PHY", "VIS", "AUD", "ELD")}
+
+
+def build_fixture_network(
+    num_lines: int = 6, stations_per_line: int = 20, seed: int = 7
+) -> FixtureNetwork:
+    """
+    격자형 합성 네트워크 생성
+
+    Args:
+        num_lines: 노선 수 (짝수 번째는 가로, 홀수 번째는 세로)
+        stations_per_line: 노선당 역 수
+        seed: 난수 seed (동일 seed => 동일 네트워크)
+    """
+    rng = random.Random(seed)
+    net = FixtureNetwork()
+    name_to_stations: Dict[str, List[Tuple[str, str]]] = {}
+    next_code = 1000
+
+    for l in range(num_lines):
+        line = f"{l + 1}호선"
+        cds = []
+        for i in range(stations_per_line):
+            # 가로 노선은 y=l, 세로 노선은 x=l 고정 => 교차점에서 같은 역 이름
+            gx, gy = (i, l) if l % 2 == 0 else (l, i)
+            name = f"격자{gx}_{gy}"
+            cd = f"{next_code:04d}"
+            next_code += 1
+
+            net.stations[cd] = {
+                "name": name,
+                "line": line,
+                # 격자 간격 약 1km
+                "lat": 37.45 + gy * 0.009 + rng.uniform(-0.0005, 0.0005),
+                "lng": 126.90 + gx * 0.011 + rng.uniform(-0.0005, 0.0005),
+            }
+            net.facility_counts[cd] = {
+                key: float(rng.randint(0, 3)) for key in FACILITY_KEYS
+            }
+            name_to_stations.setdefault(name, []).append((cd, line))
+            cds.append(cd)
+
+            for direction in ("up", "down"):
+                for day in DAY_TYPES:
+                    net.congestion[(cd, line, direction, day)] = {
+                        slot: round(rng.uniform(0.1, 1.2), 3) for slot in TIME_SLOTS
+                    }
+        net.ordered_lines[line] = cds
+
+    for pairs in name_to_stations.values():
+        if len(pairs) < 2:
+            continue
+        for from_cd, from_line in pairs:
+            for _, to_line in pairs:
+                if from_line != to_line:
+                    net.transfer_distances[(from_cd, from_line, to_line)] = round(
+                        rng.uniform(60.0, 280.0), 1
+                    )
+
+    return net
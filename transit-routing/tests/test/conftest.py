@@ -57,6 +57,10 @@ def mock_redis_session_manager(mocker):
     # from app.db.redis_client import RedisSessionManager => 실제 객체를 Mocking해서 return 하면 안됨
 
     mock_manager = mocker.MagicMock()
+    # 일괄 조회(MGET)는 get_session 설정을 따르도록 연결
+    mock_manager.get_sessions.side_effect = lambda user_ids: {
+        user_id: mock_manager.get_session(user_id) for user_id in user_ids
+    }
 
     return mock_manager
 
@@ -142,3 +142,44 @@ class TestDataCache:
         assert isinstance(station["station_cd"], str)
         assert isinstance(station["name"], str)
         assert isinstance(station["line"], str)
+
+    @patch("app.db.cache._cache_init", True)
+    @patch("app.db.cache._station_name_index", None)
+    def test_search_stations_by_name_ranking(self):
+        """역 검색 순위: 정확 > 접두 > 부분 > 초성 (C++ 인덱스 미사용 경로)"""
+        import app.db.cache as cache_module
+        from app.db.cache import search_stations_by_name
+
+        names = ["강남구청", "신논현", "강남", "서울역", "역삼", "교대"]
+        stations = [
+            {"station_cd": f"{i:010d}", "name": name, "line": "2호선"}
+            for i, name in enumerate(names)
+        ]
+        with patch.object(cache_module, "_stations_list_cache", stations):
+            assert [s["name"] for s in search_stations_by_name("강남")] == ["강남", "강남구청"]
+            # 끝의 "역"은 정규화로 제거
+            assert [s["name"] for s in search_stations_by_name("서울역")] == ["서울역"]
+            assert [s["name"] for s in search_stations_by_name("ㄱㄴ")] == ["강남", "강남구청"]
+            assert [s["name"] for s in search_stations_by_name("강ㄴ")] == ["강남", "강남구청"]
+            # 초성 부분 일치는 초성 접두 일치 뒤
+            assert [s["name"] for s in search_stations_by_name("ㄴ")] == ["강남", "신논현", "강남구청"]
+            assert search_stations_by_name("ㄱㄴ", limit=1)[0]["station_cd"] == "0000000002"
+            assert search_stations_by_name("  ") == []
+
+    @patch("app.db.cache._cache_init", True)
+    @patch("app.db.cache._station_name_index", None)
+    def test_search_stations_by_name_raw_name(self):
+        """정규화로 비는 질의("역")와 괄호 안 별칭("이수")은 원래 이름으로 일치"""
+        import app.db.cache as cache_module
+        from app.db.cache import search_stations_by_name
+
+        names = ["역삼", "역촌", "서울역", "총신대입구(이수)", "이수"]
+        stations = [
+            {"station_cd": f"{i:010d}", "name": name, "line": "2호선"}
+            for i, name in enumerate(names)
+        ]
+        with patch.object(cache_module, "_stations_list_cache", stations):
+            # 한 글자 입력 "역": 접두 일치 먼저, 부분 일치("서울역")는 뒤
+            assert [s["name"] for s in search_stations_by_name("역")] == ["역삼", "역촌", "서울역"]
+            assert [s["name"] for s in search_stations_by_name("이수")] == ["이수", "총신대입구(이수)"]
+            assert [s["name"] for s in search_stations_by_name("총신대입구")] == ["총신대입구(이수)"]
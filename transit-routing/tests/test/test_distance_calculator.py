@@ -188,3 +188,49 @@ class TestDistanceCalculator:
 
         assert distance < (north_south + east_west)
         assert distance > max(north_south, east_west)
+
+    @pytest.mark.parametrize("native", [True, False])
+    def test_one_to_many_matches_scalar(self, calculator, monkeypatch, native):
+        """배치 거리 = 단건 haversine (C++ 커널 / NumPy 구현 모두)"""
+        import numpy as np
+        from app.algorithms import distance_calculator as module
+
+        if not native:
+            monkeypatch.setattr(module, "_native", None)
+        elif module._native is None:
+            pytest.skip("pathfinding_cpp 미설치")
+
+        lat, lon = 37.5546788, 126.9706188  # 서울역
+        lats = [37.5546788, 37.4979462, 37.5003706, 35.1796, 0.0]
+        lons = [126.9706188, 127.0276368, 127.0363573, 129.0756, 1.0]
+
+        distances = calculator.one_to_many(lat, lon, lats, lons)
+
+        assert isinstance(distances, np.ndarray)
+        assert distances.shape == (5,)
+        for d, (lat2, lon2) in zip(distances, zip(lats, lons)):
+            assert d == pytest.approx(
+                calculator.calculate_distance(lat, lon, lat2, lon2), rel=1e-9, abs=1e-6
+            )
+
+    @pytest.mark.parametrize("native", [True, False])
+    def test_many_to_many_shape(self, calculator, monkeypatch, native):
+        """거리 행렬 (len(A), len(B)), 행 i = one_to_many(A[i])"""
+        from app.algorithms import distance_calculator as module
+
+        if not native:
+            monkeypatch.setattr(module, "_native", None)
+        elif module._native is None:
+            pytest.skip("pathfinding_cpp 미설치")
+
+        lats_a, lons_a = [37.5546788, 37.4979462], [126.9706188, 127.0276368]
+        lats_b = [37.5003706, 37.4841611, 37.5546788]
+        lons_b = [127.0363573, 127.0346, 126.9706188]
+
+        matrix = calculator.many_to_many(lats_a, lons_a, lats_b, lons_b)
+
+        assert matrix.shape == (2, 3)
+        assert matrix[0, 2] == pytest.approx(0.0, abs=1e-6)
+        for i in range(2):
+            row = calculator.one_to_many(lats_a[i], lons_a[i], lats_b, lons_b)
+            assert list(matrix[i]) == pytest.approx(list(row), rel=1e-9, abs=1e-6)
@@ -20,6 +20,9 @@ class TestGuidanceService:
         mock = MagicMock()
         # 기본적으로 100m 거리 반환
         mock.calculate_distance.return_value = 100.0
+        mock.one_to_many.side_effect = lambda lat, lon, lats, lons: np.full(
+            len(lats), 100.0
+        )
         return mock
 
     @pytest.fixture
@@ -183,6 +186,36 @@ class TestGuidanceService:
             assert "도착" in guidance["message"]
             assert guidance["destination"] == sample_session_data["destination"]
 
+    def test_native_unknown_handle_falls_back_to_python(
+        self, service, seoul_gps_coords, mock_redis_session_manager, sample_session_data
+    ):
+        """NavigationTracker 핸들이 조회 후 해제되면(UNKNOWN) 도착으로 오판하지 않고 Python 매칭"""
+        mock_redis_session_manager.get_session.return_value = sample_session_data
+        coords = seoul_gps_coords["valid"]["seoul_station"]
+
+        tracker = MagicMock()
+        tracker.DEVIATED, tracker.ARRIVED, tracker.UNKNOWN = 1, 2, 4
+        tracker.start.return_value = 7
+        tracker.update.return_value = {
+            "progress_index": np.array([-1], dtype=np.int32),
+            "flags": np.array([4], dtype=np.uint8),
+            "distance_to_route": np.zeros(1),
+            "distance_to_next": np.zeros(1),
+            "eta_seconds": np.zeros(1),
+        }
+        service.tracker = tracker
+
+        with patch.object(service, "find_nearest_station") as mock_find:
+            mock_find.return_value = sample_session_data["route_sequence"][0]
+
+            guidance = service.get_navigation_guidance(
+                "user123", coords["lat"], coords["lon"]
+            )
+
+        tracker.update.assert_called_once()
+        assert not guidance.get("arrived")
+        assert guidance["current_station"] == sample_session_data["route_sequence"][0]
+
     def test_get_navigation_guidance_transfer_station(
         self, service, seoul_gps_coords, mock_redis_session_manager, sample_session_data
     ):
@@ -281,6 +314,19 @@ class TestGuidanceService:
             # update_location이 호출되었는지 확인
             mock_redis_session_manager.update_location.assert_called_once()
 
+    def test_find_nearest_stations_batch(self, service, seoul_gps_coords):
+        """일괄 조회 결과가 단건 조회와 일치하는지 테스트"""
+        points = list(seoul_gps_coords["valid"].values())
+        lats = [p["lat"] for p in points]
+        lons = [p["lon"] for p in points]
+
+        nearest = service.find_nearest_stations(lats, lons, k=2)
+
+        assert len(nearest) == len(points)
+        for p, codes in zip(points, nearest):
+            assert codes[0] == service.find_nearest_station(p["lat"], p["lon"])
+            assert all(cd in service.stations for cd in codes)
+
     def test_kdtree_performance(self, service):
         """KD-Tree 성능 테스트 (빠른 검색)"""
         import time
@@ -20,6 +20,7 @@ class TestRedisSessionManager:
             mock_redis_class.return_value = mock_redis_client
             manager = RedisSessionManager()
             manager.redis_client = mock_redis_client
+            manager.binary_client = mock_redis_client
             return manager
 
     def test_create_session(self, redis_manager, sample_route_data, mock_redis_client):
@@ -97,6 +98,16 @@ class TestRedisSessionManager:
 
         assert session is None
 
+    def test_get_sessions_single_mget(self, redis_manager, sample_session_data, mock_redis_client):
+        """세션 일괄 조회 - MGET 1회, 없는 세션은 None"""
+        mock_redis_client.mget.return_value = [json.dumps(sample_session_data), None]
+
+        sessions = redis_manager.get_sessions(["user123", "user456", "user123"])
+
+        mock_redis_client.mget.assert_called_once_with(["session:user123", "session:user456"])
+        assert sessions["user123"]["route_id"] == sample_session_data["route_id"]
+        assert sessions["user456"] is None
+
     def test_delete_session_success(self, redis_manager, mock_redis_client):
         """세션 삭제 - 성공"""
         mock_redis_client.delete.return_value = 1
@@ -244,3 +255,44 @@ class TestRedisSessionManager:
                     session_data = json.loads(session_data_json)
                     # 선택된 경로 순위가 3으로 변경되었는지 확인
                     assert session_data["selected_route_rank"] == 3
+
+    def test_get_cached_route_json(self, redis_manager, mock_redis_client):
+        """JSON 캐시 값은 그대로 디코딩"""
+        mock_redis_client.get.return_value = json.dumps(
+            {"origin": "강남"}, ensure_ascii=False
+        ).encode("utf-8")
+
+        assert redis_manager.get_cached_route("route:a:b:PHY") == {"origin": "강남"}
+
+    def test_get_cached_route_binary_payload(self, redis_manager, mock_redis_client):
+        """바이너리 페이로드는 디코더로 변환, 디코더가 없거나 실패하면 캐시 미스"""
+        from app.db.redis_client import ROUTE_PAYLOAD_MAGIC
+
+        payload = ROUTE_PAYLOAD_MAGIC + b"\x01rest"
+        mock_redis_client.get.return_value = payload
+        decoder = MagicMock(return_value={"origin": "강남"})
+
+        assert redis_manager.get_cached_route("k", decode_binary=decoder) == {
+            "origin": "강남"
+        }
+        decoder.assert_called_once_with(payload)
+
+        assert redis_manager.get_cached_route("k") is None
+
+        decoder.side_effect = RuntimeError("network fingerprint mismatch")
+        assert redis_manager.get_cached_route("k", decode_binary=decoder) is None
+
+    def test_cache_route_with_payload(
+        self, redis_manager, sample_route_data, mock_redis_client
+    ):
+        """미리 직렬화된 payload가 있으면 JSON 인코딩 없이 그대로 저장"""
+        with patch.object(redis_manager, "_update_analytics") as mock_analytics:
+            result = redis_manager.cache_route(
+                "route:a:b:PHY", sample_route_data, ttl=60, payload=b"\x00RSB\x01"
+            )
+
+        assert result is True
+        mock_redis_client.setex.assert_called_once_with(
+            "route:a:b:PHY", 60, b"\x00RSB\x01"
+        )
+        mock_analytics.assert_called_once_with(sample_route_data)
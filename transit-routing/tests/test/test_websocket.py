@@ -2,6 +2,7 @@
 WebSocket 엔드포인트 테스트
 """
 
+import asyncio
 import pytest
 import json
 from unittest.mock import MagicMock, patch, AsyncMock
@@ -216,7 +217,7 @@ class TestWebSocketHandlers:
         mock_manager.send_error = AsyncMock()
 
         mock_service = MagicMock()
-        mock_service.get_navigation_guidance.return_value = {
+        mock_service.get_navigation_guidance_batch.return_value = [{
             "current_station": "1000000100",
             "current_station_name": "서울역",
             "next_station": "2000000201",
@@ -226,7 +227,7 @@ class TestWebSocketHandlers:
             "progress_percent": 50,
             "is_transfer": False,
             "message": "강남역 방향으로 이동 중",
-        }
+        }]
 
         data = {"latitude": 37.5546788, "longitude": 126.9706188}
 
@@ -234,12 +235,13 @@ class TestWebSocketHandlers:
              patch("app.api.v1.endpoints.websocket.save_location_history"):
 
             mock_redis = mock_get_redis.return_value
-            mock_redis.get_session.return_value = sample_session_data
+            mock_redis.get_sessions.return_value = {"user123": sample_session_data}
 
             await handle_location_update("user123", data, mock_service)
 
-            # 안내 생성 호출 확인
-            mock_service.get_navigation_guidance.assert_called_once()
+            # 세션 일괄 조회 + 안내 일괄 생성 호출 확인
+            mock_redis.get_sessions.assert_called_once_with(["user123"])
+            mock_service.get_navigation_guidance_batch.assert_called_once()
 
             # 메시지 전송 확인
             mock_manager.send_message.assert_called_once()
@@ -252,12 +254,12 @@ class TestWebSocketHandlers:
         mock_manager.send_error = AsyncMock()
 
         mock_service = MagicMock()
-        mock_service.get_navigation_guidance.return_value = {
+        mock_service.get_navigation_guidance_batch.return_value = [{
             "recalculate": True,
             "message": "경로를 이탈했습니다",
             "current_location": "9999999999",
             "nearest_station": "다른역",
-        }
+        }]
 
         data = {"latitude": 37.5, "longitude": 127.0}
 
@@ -265,7 +267,7 @@ class TestWebSocketHandlers:
              patch("app.api.v1.endpoints.websocket.save_navigation_event"):
 
             mock_redis = mock_get_redis.return_value
-            mock_redis.get_session.return_value = sample_session_data
+            mock_redis.get_sessions.return_value = {"user123": sample_session_data}
 
             await handle_location_update("user123", data, mock_service)
 
@@ -274,6 +276,53 @@ class TestWebSocketHandlers:
             message = call_args[1]
             assert message["type"] == "route_deviation"
 
+    @pytest.mark.asyncio
+    @patch("app.api.v1.endpoints.websocket.manager")
+    async def test_handle_location_update_batched_per_tick(
+        self, mock_manager, sample_session_data
+    ):
+        """위치 업데이트 - 같은 틱의 업데이트는 세션 조회/안내 계산 1회로 처리"""
+        mock_manager.send_message = AsyncMock()
+        mock_manager.send_error = AsyncMock()
+
+        guidance = {
+            "current_station": "1000000100",
+            "current_station_name": "서울역",
+            "remaining_stations": 1,
+            "message": "강남역 방향으로 이동 중",
+        }
+        mock_service = MagicMock()
+        mock_service.get_navigation_guidance_batch.side_effect = (
+            lambda updates, sessions=None: [dict(guidance) for _ in updates]
+        )
+
+        data = {"latitude": 37.5546788, "longitude": 126.9706188}
+
+        with patch("app.api.v1.endpoints.websocket.get_redis_client") as mock_get_redis, \
+             patch("app.api.v1.endpoints.websocket.save_location_history"):
+
+            mock_redis = mock_get_redis.return_value
+            mock_redis.get_sessions.return_value = {
+                "user1": sample_session_data,
+                "user2": sample_session_data,
+            }
+
+            await asyncio.gather(
+                handle_location_update("user1", data, mock_service),
+                handle_location_update("user2", data, mock_service),
+                handle_location_update("user3", data, mock_service),
+            )
+
+            mock_redis.get_sessions.assert_called_once_with(["user1", "user2", "user3"])
+            # 세션이 없는 user3은 안내 계산에서 제외
+            mock_service.get_navigation_guidance_batch.assert_called_once()
+            updates = mock_service.get_navigation_guidance_batch.call_args[0][0]
+            assert [u[0] for u in updates] == ["user1", "user2"]
+
+            assert mock_manager.send_message.call_count == 2
+            mock_manager.send_error.assert_called_once()
+            assert mock_manager.send_error.call_args[0][2] == "NO_ACTIVE_SESSION"
+
     @pytest.mark.asyncio
     @patch("app.api.v1.endpoints.websocket.manager")
     async def test_handle_switch_route_success(self, mock_manager, sample_session_data):
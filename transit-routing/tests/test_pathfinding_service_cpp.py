@@ -1,11 +1,13 @@
 # PathfindingServiceCPP 테스트
 
 import pytest
+import sys
 import logging
 from datetime import datetime
 
 from app.services.pathfinding_service_cpp import PathfindingServiceCPP
 from app.core.exceptions import StationNotFoundException, RouteNotFoundException
+from app.core.config import settings
 
 logger = logging.getLogger(__name__)
 
@@ -137,6 +139,64 @@ class TestPathfindingServiceCPP:
             # 성능 기준: 첫 계산은 2초 이내 (C++ 최적화)
             assert elapsed_time < 2000, f"응답시간 초과: {elapsed_time:.1f}ms > 2000ms"
 
+    def test_calculate_route_progressive(self, service):
+        """점진적 결과 전달 테스트 (find_routes_streaming)"""
+        service.redis_client.invalidate_route_cache("route:cpp:*")
+        updates = []
+
+        result = service.calculate_route(
+            origin_name="강남",
+            destination_name="서울역",
+            disability_type="PHY",
+            on_update=updates.append,
+        )
+
+        assert result is not None
+        assert len(updates) > 0
+        # 라운드 순서대로 전달되며, 각 중간 결과도 응답과 동일한 경로 형식
+        rounds = [u["round"] for u in updates]
+        assert rounds == sorted(rounds)
+        assert all(len(u["routes"]) > 0 for u in updates)
+        assert updates[0]["routes"][0]["rank"] == 1
+        # 마지막 중간 결과 = 최종 결과
+        assert updates[-1]["total_routes_found"] == result["total_routes_found"]
+
+        logger.info(f"✓ 점진적 결과 테스트 통과: {len(updates)}회 전달, 라운드={rounds}")
+
+    def test_progressive_route_with_concurrent_update(self, service):
+        """점진적 결과 전달 중 혼잡도 갱신: 콜백(GIL)과 쓰기 잠금 대기가 교착되지 않음"""
+        import threading
+        import time
+
+        service.redis_client.invalidate_route_cache("route:cpp:*")
+        version = service.data_container.data_version
+        writers = []
+
+        def on_update(update):
+            # 탐색 스레드가 읽기 잠금을 쥔 채 콜백 실행 중 -> 다른 스레드의 갱신은 잠금 해제까지 대기
+            if not writers:
+                writer = threading.Thread(
+                    target=service.data_container.update_congestion, args=({},)
+                )
+                writer.start()
+                writers.append(writer)
+                time.sleep(0.2)  # GIL 양보 (갱신 스레드가 쓰기 잠금 대기에 들어가도록)
+
+        result = service.calculate_route(
+            origin_name="강남",
+            destination_name="서울역",
+            disability_type="PHY",
+            on_update=on_update,
+        )
+
+        assert result is not None
+        assert writers
+        writers[0].join(timeout=10)
+        assert not writers[0].is_alive()
+        assert service.data_container.data_version == version + 1
+
+        logger.info("✓ 점진적 결과 + 동시 갱신 테스트 통과")
+
     def test_calculate_route_cache_hit(self, service):
         """캐시 히트 성능 테스트"""
         import time
@@ -159,6 +219,1125 @@ class TestPathfindingServiceCPP:
         # 캐시 히트는 50ms 이내 (Redis 조회)
         assert elapsed_time < 50, f"캐시 응답시간 초과: {elapsed_time:.1f}ms > 50ms"
 
+    def test_resume_routes_matches_full_search(self, service):
+        """라운드 확장(resume_routes) 결과 = 처음부터 더 많은 라운드로 탐색한 결과"""
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("홍대입구")
+        departure_time = datetime.now().timestamp()
+
+        full_engine = service.cpp_module.McRaptorEngine(service.data_container)
+        full = full_engine.find_routes(
+            origin_cd, {destination_cd}, departure_time, "PHY", 5
+        )
+
+        engine = service.cpp_module.McRaptorEngine(service.data_container)
+        engine.find_routes(origin_cd, {destination_cd}, departure_time, "PHY", 3)
+        assert engine.completed_rounds <= 3
+        resumed = engine.resume_routes(5)
+
+        def key(label):
+            return (round(label.arrival_time, 6), label.transfers, label.current_line)
+
+        assert sorted(map(key, resumed)) == sorted(map(key, full))
+        assert engine.last_stats.labels_created == full_engine.last_stats.labels_created
+
+        logger.info(f"✓ 라운드 확장 테스트 통과: {len(resumed)}개 경로")
+
+    @pytest.mark.asyncio
+    async def test_find_routes_async(self, service):
+        """비동기 탐색: 워커 풀 결과 = 동기 탐색+정렬 결과, 동시 요청 다수를 await"""
+        import asyncio
+
+        from app.db.cache import get_station_cd_by_name
+
+        pairs = [("강남", "서울역"), ("강남", "잠실"), ("강남", "홍대입구")]
+        departure_time = datetime.now().timestamp()
+
+        def key(label):
+            return (round(label.arrival_time, 6), label.transfers, round(label.score, 9))
+
+        for origin, destination in pairs:
+            origin_cd = get_station_cd_by_name(origin)
+            destination_cd = get_station_cd_by_name(destination)
+
+            sync_engine = service.cpp_module.McRaptorEngine(service.data_container)
+            expected = sync_engine.rank_routes(
+                sync_engine.find_routes(
+                    origin_cd, {destination_cd}, departure_time, "PHY", 5
+                ),
+                "PHY",
+            )
+            engine, ranked = await service.query_pool.find_routes_async(
+                origin_cd, {destination_cd}, departure_time, "PHY", 5
+            )
+            assert list(map(key, ranked)) == list(map(key, expected))
+            assert engine.reconstruct_route(ranked[0], service.data_container)[0] == origin_cd
+
+        # 스레드 수보다 훨씬 많은 동시 요청
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("서울역")
+        results = await asyncio.gather(
+            *[
+                service.query_pool.find_routes_async(
+                    origin_cd, {destination_cd}, departure_time, "ELD", 5
+                )
+                for _ in range(64)
+            ]
+        )
+        assert len({tuple(map(key, ranked)) for _, ranked in results}) == 1
+
+        # 서비스 레벨: calculate_route와 동일한 응답 형식
+        result = await service.calculate_route_async("강남", "서울역", "PHY")
+        assert result["routes"][0]["rank"] == 1
+        with pytest.raises(StationNotFoundException):
+            await service.calculate_route_async("존재하지않는역", "서울역", "PHY")
+
+        logger.info(
+            f"✓ 비동기 탐색 테스트 통과: 워커 {service.query_pool.thread_count}개, "
+            f"동시 요청 {len(results)}개"
+        )
+
+    @pytest.mark.asyncio
+    async def test_query_pool_admission(self, service):
+        """과부하 제어: 전체 대기열 상한 초과 요청은 탐색 없이 QueryRejected, 통계에 반영"""
+        import asyncio
+
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("홍대입구")
+        departure_time = datetime.now().timestamp()
+        Priority = service.cpp_module.QueryPriority
+
+        pool = service.cpp_module.QueryPool(
+            service.data_container, 1, max_queue=2, max_wait_ms=0
+        )
+        assert pool.max_queue == 2
+        # 우선순위를 섞어도 상한은 대기 작업 합계에 적용
+        results = await asyncio.gather(
+            *[
+                pool.find_routes_async(
+                    origin_cd,
+                    {destination_cd},
+                    departure_time,
+                    "PHY",
+                    5,
+                    priority=Priority.HIGH if i % 2 else Priority.NORMAL,
+                )
+                for i in range(32)
+            ],
+            return_exceptions=True,
+        )
+        rejected = [r for r in results if isinstance(r, service.cpp_module.QueryRejected)]
+        answered = [r for r in results if isinstance(r, tuple)]
+
+        assert rejected and answered
+        assert len(rejected) + len(answered) == len(results)
+        assert all(ranked for _, ranked in answered)
+
+        stats = pool.stats()
+        assert stats.submitted == len(results)
+        assert stats.rejected == len(rejected)
+        assert stats.completed == len(answered)
+        assert stats.peak_queued <= 2
+        assert stats.queued == 0
+        assert stats.wait_ms_p99 >= stats.wait_ms_p50 >= 0
+        assert stats.service_ms_avg > 0
+
+        # 서비스 메트릭
+        summary = service.query_pool_stats()
+        assert summary["max_queue"] == settings.CPP_QUERY_MAX_QUEUE
+        assert "p99" in summary["wait_ms"]
+
+        pool.shutdown()
+        logger.info(
+            f"✓ 과부하 제어 테스트 통과: 처리 {len(answered)}건, 거절 {len(rejected)}건"
+        )
+
+    @pytest.mark.asyncio
+    async def test_query_pool_priority(self, service):
+        """우선순위: HIGH 요청은 대기 중인 NORMAL 요청보다 먼저 실행, 클래스별 통계"""
+        import asyncio
+
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("홍대입구")
+        departure_time = datetime.now().timestamp()
+        Priority = service.cpp_module.QueryPriority
+
+        pool = service.cpp_module.QueryPool(service.data_container, 1)
+        finished = []
+
+        async def query(tag, priority):
+            await pool.find_routes_async(
+                origin_cd,
+                {destination_cd},
+                departure_time,
+                "PHY",
+                5,
+                priority=priority,
+            )
+            finished.append(tag)
+
+        tasks = [
+            asyncio.ensure_future(query(f"normal{i}", Priority.NORMAL))
+            for i in range(8)
+        ]
+        tasks.append(asyncio.ensure_future(query("high", Priority.HIGH)))
+        await asyncio.gather(*tasks)
+
+        # 워커 1개: 이미 실행 중인 NORMAL 최대 1~2건 이후 바로 HIGH
+        assert finished.index("high") <= 2
+
+        stats = pool.stats()
+        high = stats.for_priority(Priority.HIGH)
+        normal = stats.for_priority(Priority.NORMAL)
+        assert (high.completed, normal.completed) == (1, 8)
+        assert high.wait_ms_p99 <= normal.wait_ms_p99
+        assert normal.latency_ms_p99 >= normal.service_ms_p99
+
+        pool.shutdown()
+
+        # 서비스 레벨: 세션 재탐색을 HIGH로 워커 풀에서 수행
+        updates = []
+        session_id = "priority-test-session"
+        high_before = service.query_pool_stats()["classes"]["high"]["completed"]
+        # 위치 기반 출발은 Redis 캐시를 사용하지 않으므로 항상 워커 풀에서 탐색
+        await service.calculate_route_async(
+            "강남",
+            "홍대입구",
+            "PHY",
+            origin_location=(37.4979, 127.0276),
+            session_id=session_id,
+            priority="high",
+        )
+        assert session_id in service._session_engines  # 재탐색용 엔진 보관
+        result = await service.calculate_route_async(
+            "역삼",
+            "홍대입구",
+            "PHY",
+            origin_location=(37.5006, 127.0364),
+            on_update=updates.append,
+            session_id=session_id,
+            priority="high",
+        )
+        service.release_session(session_id)
+        assert result["routes"]
+        assert updates and updates[-1]["routes"]
+        high_after = service.query_pool_stats()["classes"]["high"]["completed"]
+        assert high_after - high_before == 2
+
+        logger.info(f"✓ 우선순위 테스트 통과: 완료 순서 {finished}")
+
+    @pytest.mark.asyncio
+    async def test_query_pool_low_yields_to_high(self, service):
+        """LOW(예열) 작업은 HIGH 작업이 대기하면 라운드 경계에서 바로 종료"""
+        import asyncio
+        import time
+
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("홍대입구")
+        departure_time = datetime.now().timestamp()
+        Priority = service.cpp_module.QueryPriority
+
+        pool = service.cpp_module.QueryPool(service.data_container, 1)
+        low = pool.submit(
+            origin_cd, {destination_cd}, departure_time, "ELD", 8, priority=Priority.LOW
+        )
+        while pool.running == 0:
+            time.sleep(0.0005)
+        high = pool.submit(
+            origin_cd, {destination_cd}, departure_time, "PHY", 5, priority=Priority.HIGH
+        )
+        await asyncio.gather(asyncio.wrap_future(low), asyncio.wrap_future(high))
+
+        stats = pool.stats()
+        assert stats.for_priority(Priority.LOW).preempted == 1
+        assert stats.for_priority(Priority.HIGH).completed == 1
+        pool.shutdown()
+
+    @pytest.mark.asyncio
+    async def test_session_engine_kept_on_failure(self, service, monkeypatch):
+        """세션 재탐색이 오류/취소로 끝나도 보관된 탐색 엔진 유지"""
+        import asyncio
+
+        session_id = "keep-engine-session"
+        location = (37.4979, 127.0276)
+        service.calculate_route(
+            "강남", "서울역", "PHY", origin_location=location, session_id=session_id
+        )
+        engine = service._session_engines[session_id]
+
+        # 엔진을 꺼낸 뒤 오류
+        def fail(query):
+            raise RuntimeError("injected")
+
+        with monkeypatch.context() as m:
+            m.setattr(service, "_query_ids", fail)
+            with pytest.raises(RuntimeError):
+                service.calculate_route(
+                    "역삼",
+                    "서울역",
+                    "PHY",
+                    origin_location=(37.5006, 127.0364),
+                    session_id=session_id,
+                )
+        assert service._session_engines[session_id] is engine
+
+        # 시간 초과 취소: 워커가 탐색을 마친 뒤 엔진이 되돌아옴
+        with pytest.raises(asyncio.TimeoutError):
+            await asyncio.wait_for(
+                service.calculate_route_async(
+                    "역삼",
+                    "서울역",
+                    "PHY",
+                    origin_location=(37.5006, 127.0364),
+                    session_id=session_id,
+                    priority="high",
+                ),
+                timeout=0.001,
+            )
+        for _ in range(1000):
+            if session_id in service._session_engines:
+                break
+            await asyncio.sleep(0.01)
+        assert service._session_engines[session_id] is engine
+        service.release_session(session_id)
+
+        logger.info("✓ 세션 엔진 유지 테스트 통과")
+
+    @pytest.mark.asyncio
+    async def test_calculate_route_async_blocking_io_off_loop(self, service, monkeypatch):
+        """비동기 경로 계산: 역 조회/캐시 조회/캐시 저장은 이벤트 루프 밖에서 수행"""
+        import threading
+
+        loop_thread = threading.get_ident()
+        calls = {}
+
+        def recorder(name, original):
+            def call(*args, **kwargs):
+                calls[name] = threading.get_ident()
+                return original(*args, **kwargs)
+
+            return call
+
+        for name in ("_resolve_query", "_finish_query"):
+            monkeypatch.setattr(service, name, recorder(name, getattr(service, name)))
+        # 캐시 미스로 두어 워커 풀 탐색과 캐시 저장까지 진행
+        monkeypatch.setattr(
+            service, "_cached_result", recorder("_cached_result", lambda *args: None)
+        )
+
+        result = await service.calculate_route_async("강남", "잠실", "PHY")
+        assert result["routes"]
+        assert set(calls) == {"_resolve_query", "_cached_result", "_finish_query"}
+        assert all(ident != loop_thread for ident in calls.values())
+
+    @pytest.mark.asyncio
+    async def test_load_adaptive_effort(self, service):
+        """부하 적응: 대기열이 쌓이면 완화된 탐색 강도로 실행하고 결과에 단계 기록"""
+        import asyncio
+
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("서울역")
+        departure_time = datetime.now().timestamp()
+
+        # 엔진 단위: 완화 지배 + bag 상한은 라벨 수를 줄이고 경로는 유지
+        full = service.cpp_module.McRaptorEngine(service.data_container)
+        full_routes = full.find_routes(origin_cd, {destination_cd}, departure_time, "PHY", 5)
+        reduced = service.cpp_module.McRaptorEngine(service.data_container)
+        effort = service.cpp_module.SearchEffort()
+        effort.level, effort.epsilon, effort.max_bag_size = 2, 0.05, 8
+        reduced.effort = effort
+        reduced_routes = reduced.find_routes(
+            origin_cd, {destination_cd}, departure_time, "PHY", 5
+        )
+        assert full.last_stats.effort_level == 0
+        assert reduced.last_stats.effort_level == 2
+        assert full_routes and reduced_routes
+        assert reduced.last_stats.labels_created <= full.last_stats.labels_created
+
+        # 풀 단위: 워커 1개에 대기 작업이 있으면 1단계
+        pool = service.cpp_module.QueryPool(
+            service.data_container,
+            1,
+            effort_levels=[{"queue_per_worker": 1, "epsilon": 0.05, "max_bag_size": 8}],
+        )
+        assert pool.effort_level_count == 1
+        results = await asyncio.gather(
+            *[
+                pool.find_routes_async(
+                    origin_cd, {destination_cd}, departure_time, "PHY", 5
+                )
+                for _ in range(8)
+            ]
+        )
+        levels = [engine.last_stats.effort_level for engine, _ in results]
+        assert 1 in levels
+        assert all(ranked for _, ranked in results)
+        # 반환된 엔진의 이후 직접 탐색은 전체 탐색
+        assert all(engine.effort.level == 0 for engine, _ in results)
+
+        stats = pool.stats()
+        assert sum(stats.effort_counts) == len(results)
+        assert stats.effort_counts[1] == levels.count(1)
+        pool.shutdown()
+
+        logger.info(f"✓ 부하 적응 테스트 통과: 단계 {levels}")
+
+    def test_parallel_rounds_match_sequential(self, service):
+        """라운드 내 병렬 스캔: 스레드 수와 무관하게 순차 탐색과 동일한 라벨/통계"""
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("역삼")
+        destination_cd = get_station_cd_by_name("신촌")
+        departure_time = datetime.now().timestamp()
+
+        def search(threads):
+            engine = service.cpp_module.McRaptorEngine(service.data_container)
+            engine.parallel_threads = threads
+            assert engine.parallel_threads == threads
+            routes = engine.find_routes(
+                origin_cd, {destination_cd}, departure_time, "ELD", 8
+            )
+            return engine, [
+                (label.arrival_time, label.transfers, label.current_line)
+                for label in routes
+            ]
+
+        sequential_engine, sequential = search(1)
+        parallel_engine, parallel = search(4)
+
+        assert parallel == sequential
+        assert sequential_engine.last_stats.parallel_rounds == 0
+        assert (
+            parallel_engine.last_stats.labels_created
+            == sequential_engine.last_stats.labels_created
+        )
+        assert (
+            parallel_engine.last_stats.labels_dominated
+            == sequential_engine.last_stats.labels_dominated
+        )
+
+        logger.info(
+            f"✓ 병렬 라운드 테스트 통과: {len(parallel)}개 경로, "
+            f"병렬 라운드 {parallel_engine.last_stats.parallel_rounds}회"
+        )
+
+        # 여러 엔진이 동시에 병렬 라운드 수행 (공용 보조 스레드를 나눠 써도 같은 결과)
+        from concurrent.futures import ThreadPoolExecutor
+
+        with ThreadPoolExecutor(max_workers=4) as executor:
+            concurrent = list(executor.map(lambda _: search(4)[1], range(8)))
+        assert all(routes == sequential for routes in concurrent)
+
+    def test_reroute_reuses_previous_search(self, service):
+        """경로 이탈 재탐색: 이전 탐색 트리의 잔여 경로 복구 + 새 탐색보다 나쁘지 않은 결과를 더 적은 라벨로"""
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("서울역")
+        departure_time = datetime.now().timestamp()
+
+        engine = service.cpp_module.McRaptorEngine(service.data_container)
+        engine.target_pruning = True
+        routes = engine.find_routes(
+            origin_cd, {destination_cd}, departure_time, "PHY", 5
+        )
+        best = engine.rank_routes(routes, "PHY")[0]
+        sequence = engine.reconstruct_route(best, service.data_container)
+        current_cd = sequence[len(sequence) // 2]
+
+        updates = []
+        rerouted = engine.reroute(
+            current_cd,
+            {destination_cd},
+            departure_time + 600,
+            "PHY",
+            5,
+            lambda round_no, labels: updates.append(round_no),
+        )
+        assert engine.last_stats.routes_reused > 0
+        assert updates[0] == 0  # 복구 경로가 탐색 전에 먼저 전달됨
+
+        fresh_engine = service.cpp_module.McRaptorEngine(service.data_container)
+        fresh = fresh_engine.find_routes(
+            current_cd, {destination_cd}, departure_time + 600, "PHY", 5
+        )
+        assert min(l.arrival_time for l in rerouted) <= min(
+            l.arrival_time for l in fresh
+        ) + 1e-6
+        # 목표 가지치기(opt-in): 복구 경로가 상한 -> 현재 역에서의 새 탐색보다 적은 라벨로 탐색
+        assert (
+            engine.last_stats.labels_created < fresh_engine.last_stats.labels_created
+        )
+
+        logger.info(
+            f"✓ 재탐색 테스트 통과: {engine.last_stats.routes_reused}개 경로 복구, "
+            f"{len(rerouted)}개 경로"
+        )
+
+    def test_reroute_ranking_matches_fresh_search(self, service):
+        """경로 이탈 재탐색(기본값, 목표 가지치기 없음): ELD 상위 3개 순위가 새 탐색보다 나쁘지 않음"""
+        from app.db.cache import get_station_cd_by_name
+
+        departure_time = datetime.now().timestamp()
+        for origin, destination in [("강남", "서울역"), ("사당", "홍대입구"), ("신도림", "잠실")]:
+            origin_cd = get_station_cd_by_name(origin)
+            destination_cd = get_station_cd_by_name(destination)
+
+            engine = service.cpp_module.McRaptorEngine(service.data_container)
+            assert not engine.target_pruning
+            routes = engine.find_routes(
+                origin_cd, {destination_cd}, departure_time, "ELD", 5
+            )
+            best = engine.rank_routes(routes, "ELD")[0]
+            sequence = engine.reconstruct_route(best, service.data_container)
+            current_cd = sequence[len(sequence) // 2]
+            if current_cd == destination_cd:
+                continue
+
+            rerouted = engine.rank_routes(
+                engine.reroute(current_cd, {destination_cd}, departure_time + 600, "ELD", 5),
+                "ELD",
+            )[:3]
+            assert engine.last_stats.labels_pruned == 0
+
+            fresh_engine = service.cpp_module.McRaptorEngine(service.data_container)
+            fresh = fresh_engine.rank_routes(
+                fresh_engine.find_routes(
+                    current_cd, {destination_cd}, departure_time + 600, "ELD", 5
+                ),
+                "ELD",
+            )[:3]
+
+            # 복구 경로는 실제 가능한 경로이므로 순위별 점수가 새 탐색 이하
+            assert len(rerouted) >= len(fresh)
+            for r, f in zip(rerouted, fresh):
+                assert r.score <= f.score + 1e-9
+
+        logger.info("✓ 재탐색 순위 테스트 통과 (ELD)")
+
+    def test_multi_origin_access_legs(self, service):
+        """위치 기반 출발: 주변 역 다중 출발 탐색은 각 역 단독 출발(도보 시간 포함)보다 나쁘지 않음"""
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("서울역")
+        departure_time = datetime.now().timestamp()
+        info = service.stations[origin_cd]
+        lat, lon = info["lat"] + 0.002, info["lng"] + 0.002
+
+        engine = service.cpp_module.McRaptorEngine(service.data_container)
+        by_code = engine.find_routes(
+            origin_cd, {destination_cd}, departure_time, "PHY", 5
+        )
+        by_leg = engine.find_routes(
+            [(origin_cd, 0.0)], {destination_cd}, departure_time, "PHY", 5
+        )
+
+        def key(label):
+            return (round(label.arrival_time, 6), label.transfers, label.current_line)
+
+        assert sorted(map(key, by_leg)) == sorted(map(key, by_code))
+
+        legs = service._access_legs(lat, lon)
+        assert legs and all(d <= settings.CPP_ACCESS_RADIUS_M for _, d in legs[1:])
+        assert [d for _, d in legs] == sorted(d for _, d in legs)
+
+        multi = engine.find_routes(legs, {destination_cd}, departure_time, "PHY", 5)
+        best_multi = min(l.arrival_time for l in multi)
+        for leg in legs:
+            single = engine.find_routes(
+                [leg], {destination_cd}, departure_time, "PHY", 5
+            )
+            if single:
+                assert best_multi <= min(l.arrival_time for l in single) + 1e-6
+
+        result = service.calculate_route(
+            "강남", "서울역", "PHY", origin_location=(lat, lon)
+        )
+        access = dict(legs)
+        for route in result["routes"]:
+            assert route["access_distance_m"] == pytest.approx(
+                access[route["route_sequence"][0]], abs=0.1
+            )
+
+        logger.info(
+            f"✓ 다중 출발 테스트 통과: 출발 후보 {len(legs)}개, "
+            f"최단 도착 {best_multi:.1f}분"
+        )
+
+    def test_integer_id_query(self, service):
+        """정수 ID 질의: resolve_ids 변환 후 find_routes_ids == 역 코드 find_routes"""
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("서울역")
+        departure_time = datetime.now().timestamp()
+
+        ids = service.data_container.resolve_ids([origin_cd, destination_cd, "없는코드"])
+        assert ids[0] >= 0 and ids[1] >= 0 and ids[2] == -1
+        assert service.data_container.get_codes(ids[:2]) == [origin_cd, destination_cd]
+
+        engine = service.cpp_module.McRaptorEngine(service.data_container)
+        by_code = engine.find_routes(
+            origin_cd, {destination_cd}, departure_time, "PHY", 5
+        )
+        by_id = engine.find_routes_ids(
+            ids[:1], ids[1:2], departure_time, "PHY", 5
+        )
+
+        def key(label):
+            return (round(label.arrival_time, 6), label.transfers, label.current_line)
+
+        assert sorted(map(key, by_id)) == sorted(map(key, by_code))
+
+        ranked = engine.rank_routes(by_id, "PHY")
+        route_ids = engine.reconstruct_route_ids(ranked[0])
+        assert service.data_container.get_codes(route_ids) == engine.reconstruct_route(
+            ranked[0], service.data_container
+        )
+
+        # 접근 거리: 목록 입력과 동일
+        by_leg = engine.find_routes(
+            [(origin_cd, 300.0)], {destination_cd}, departure_time, "PHY", 5
+        )
+        by_id_leg = engine.find_routes_ids(
+            ids[:1], ids[1:2], departure_time, "PHY", 5, access_m=[300.0]
+        )
+        assert sorted(map(key, by_id_leg)) == sorted(map(key, by_leg))
+
+        with pytest.raises(ValueError):
+            engine.find_routes_ids(ids[2:], ids[1:2], departure_time, "PHY", 5)
+
+        logger.info(
+            f"✓ 정수 ID 질의 테스트 통과: {len(by_id)}개 경로, "
+            f"직접 색인표={service.data_container.has_code_table}"
+        )
+
+    def test_route_set_views(self, service):
+        """RouteSet: 정렬/재구성 결과 == rank_routes + reconstruct_*, 배열은 읽기 전용 뷰"""
+        from app.db.cache import get_station_cd_by_name
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("서울역")
+        departure_time = datetime.now().timestamp()
+        ids = service.data_container.resolve_ids([origin_cd, destination_cd])
+
+        engine = service.cpp_module.McRaptorEngine(service.data_container)
+        route_set = engine.find_route_set(
+            ids[:1], ids[1:2], departure_time, "PHY", 5
+        )
+        ranked = engine.rank_routes(
+            engine.find_routes(origin_cd, {destination_cd}, departure_time, "PHY", 5),
+            "PHY",
+        )
+        assert len(route_set) == len(ranked) > 0
+
+        offsets = route_set.path_offsets
+        assert offsets[0] == 0 and offsets[-1] == len(route_set.path_stations)
+        assert len(route_set.path_lines) == len(route_set.path_stations)
+        for i, label in enumerate(ranked):
+            assert route_set.route_codes(i, service.data_container) == (
+                engine.reconstruct_route(label, service.data_container)
+            )
+            assert route_set.route_lines(i, service.data_container) == (
+                engine.reconstruct_lines(label)
+            )
+            assert list(route_set.station_ids(i)) == list(
+                route_set.path_stations[offsets[i] : offsets[i + 1]]
+            )
+            assert route_set.arrival_time[i] == pytest.approx(label.arrival_time)
+            assert route_set.transfers[i] == label.transfers
+            assert route_set.score[i] == pytest.approx(label.score)
+            assert route_set.label(i).arrival_time == pytest.approx(label.arrival_time)
+
+        names = service.data_container.line_names
+        for line_id in route_set.line_ids(0):
+            assert line_id < 0 or service.data_container.line_id(names[line_id]) == line_id
+
+        # (역 ID, 노선 ID) 정차 배열 == RouteSet 경로
+        stops = engine.reconstruct_stops(ranked[0])
+        assert stops.shape == (len(route_set.station_ids(0)), 2)
+        assert list(stops[:, 0]) == list(route_set.station_ids(0))
+        assert list(stops[:, 1]) == list(route_set.line_ids(0))
+
+        # 뷰는 읽기 전용이고 RouteSet 메모리를 공유 (엔진이 다음 탐색을 해도 유효)
+        scores = route_set.score
+        with pytest.raises(ValueError):
+            scores[0] = 0.0
+        engine.find_routes(destination_cd, {origin_cd}, departure_time, "PHY", 5)
+        assert scores[0] == pytest.approx(ranked[0].score)
+
+        with pytest.raises(IndexError):
+            route_set.label(len(route_set))
+
+        logger.info(
+            f"✓ RouteSet 테스트 통과: {len(route_set)}개 경로, "
+            f"역 {len(route_set.path_stations)}개"
+        )
+
+    def test_route_payload_roundtrip(self, service):
+        """캐시 페이로드: binary 디코딩 결과와 to_json이 Python 응답 딕셔너리와 동일"""
+        import json
+        from app.db.cache import get_station_cd_by_name
+        from app.db.redis_client import ROUTE_PAYLOAD_MAGIC
+
+        origin_cd = get_station_cd_by_name("강남")
+        destination_cd = get_station_cd_by_name("서울역")
+        ids = service.data_container.resolve_ids([origin_cd, destination_cd])
+        engine = service.cpp_module.McRaptorEngine(service.data_container)
+        route_set = engine.find_route_set(
+            ids[:1], ids[1:2], datetime.now().timestamp(), "PHY", 5
+        )
+        assert len(route_set) > 0
+
+        query = {
+            "origin": "강남",
+            "origin_cd": origin_cd,
+            "destination": "서울역",
+            "destination_cd": destination_cd,
+        }
+        expected = service._route_result(
+            *query.values(),
+            service._build_routes_info(route_set, 3),
+            len(route_set),
+            0,
+        )
+
+        payload = route_set.encode(service.data_container, *query.values())
+        assert payload.startswith(ROUTE_PAYLOAD_MAGIC)
+        assert service.cpp_module.ROUTE_PAYLOAD_MAGIC == ROUTE_PAYLOAD_MAGIC
+        assert service._decode_cached_route(payload) == expected
+
+        as_json = route_set.to_json(service.data_container, *query.values())
+        assert json.loads(as_json) == json.loads(json.dumps(expected))
+        assert len(payload) < len(as_json)
+
+        # 손상된 페이로드는 RuntimeError (캐시 미스로 처리)
+        with pytest.raises(RuntimeError):
+            service.cpp_module.decode_route_payload(
+                payload[:-1], service.data_container
+            )
+
+        logger.info(
+            f"✓ 캐시 페이로드 테스트 통과: binary={len(payload)}B, json={len(as_json)}B"
+        )
+
+    def test_cache_warmup_fills_result_cache(self, service):
+        """캐시 예열: 대상 결과가 결과 캐시에 저장되고, 데이터 버전이 바뀌면 다시 예열"""
+        from app.db.cache import get_station_cd_by_name
+
+        pairs = [("강남", "서울역"), ("사당", "홍대입구"), ("신도림", "잠실")]
+        targets = []
+        for origin, destination in pairs:
+            origin_cd = get_station_cd_by_name(origin)
+            destination_cd = get_station_cd_by_name(destination)
+            targets.append(
+                service.cpp_module.WarmupTarget(
+                    service._cache_key(origin_cd, destination_cd, "PHY"),
+                    origin,
+                    origin_cd,
+                    destination,
+                    destination_cd,
+                    "PHY",
+                    weight=len(targets),
+                )
+            )
+
+        cache = service.cpp_module.ResultCache(service.data_container, 16)
+        warmer = service.cpp_module.CacheWarmer(
+            service.query_pool,
+            service.data_container,
+            cache,
+            targets,
+            recheck_seconds=1.0,
+        )
+        try:
+            assert warmer.wait(timeout=60)
+            stats = warmer.stats()
+            assert stats.runs == 1 and stats.cached == len(targets)
+            for target in targets:
+                payload = cache.get(target.cache_key)
+                assert payload is not None
+                result = service._decode_cached_route(payload)
+                assert result["origin_cd"] == target.origin_cd
+                assert result["destination_cd"] == target.destination_cd
+                assert result["routes_returned"] > 0
+
+            # 점수 갱신 -> 이전 버전 항목은 조회 시 폐기, 예열기가 새 버전으로 재계산
+            version = service.data_container.data_version
+            service.data_container.update_congestion({})
+            assert service.data_container.data_version == version + 1
+            assert cache.get(targets[0].cache_key) is None
+            assert cache.stats().stale == 1
+
+            assert warmer.wait(timeout=60)
+            assert warmer.stats().runs == 2
+            assert all(t.cache_key in cache for t in targets)
+
+            # 대상 교체 -> 새 대상만 계산 (이미 최신 항목이 있는 대상은 건너뜀)
+            origin_cd = get_station_cd_by_name("역삼")
+            destination_cd = get_station_cd_by_name("사당")
+            added = service.cpp_module.WarmupTarget(
+                service._cache_key(origin_cd, destination_cd, "VIS"),
+                "역삼",
+                origin_cd,
+                "사당",
+                destination_cd,
+                "VIS",
+            )
+            submitted = warmer.stats().submitted
+            warmer.set_targets(targets + [added])
+            assert warmer.wait(timeout=60)
+            stats = warmer.stats()
+            assert stats.targets == len(targets) + 1
+            assert stats.submitted == submitted + 1
+            assert added.cache_key in cache
+        finally:
+            warmer.stop()
+
+        logger.info(
+            f"✓ 캐시 예열 테스트 통과: {len(targets)}개, "
+            f"{warmer.stats().last_run_ms:.0f}ms"
+        )
+
+    def test_cache_warmup_refresh_from_query_sketch(self, service, monkeypatch):
+        """예열 대상 갱신: 시작 이후 기록된 질의 집계 상위 항목이 예열 대상에 반영"""
+        import time
+        from app.db.cache import get_station_cd_by_name
+
+        monkeypatch.setattr(settings, "CPP_WARMUP_PAIRS", 200)
+        if settings.CPP_RESULT_CACHE_SIZE <= 0:
+            pytest.skip("결과 캐시 비활성화")
+
+        origin_cd = get_station_cd_by_name("신도림")
+        destination_cd = get_station_cd_by_name("잠실")
+        for _ in range(5):
+            service.query_sketch.record(origin_cd, destination_cd, "ELD", time.time())
+        cache_key = service._cache_key(origin_cd, destination_cd, "ELD")
+
+        # 갱신 스레드와 같은 방식으로 잠금을 쥐고 호출 (완료 시 해제)
+        assert service._warmup_refresh_lock.acquire(blocking=False)
+        service._refresh_cache_warmer()
+        assert not service._warmup_refresh_lock.locked()
+
+        assert service.cache_warmer is not None
+        assert service.cache_warmer.wait(timeout=60)
+        assert cache_key in service.result_cache
+
+        logger.info(
+            f"✓ 예열 대상 갱신 테스트 통과: {service.cache_warmer.stats().targets}개 대상"
+        )
+
+    def test_query_sketch_heavy_hitters(self, service):
+        """질의 빈도 집계: 상위 항목/추정값이 정확한 빈도와 일치하고, 창이 지나면 폐기"""
+        import random
+        from collections import Counter
+        from app.db.cache import get_station_cd_by_name
+
+        codes = [
+            get_station_cd_by_name(name)
+            for name in ("강남", "역삼", "서울역", "사당", "홍대입구", "잠실")
+        ]
+        sketch = service.cpp_module.QuerySketch(
+            service.data_container, top_k=8, window_seconds=600, epochs=4
+        )
+        base = 1_700_000_000.0
+        slot = sketch.time_slot(base)
+        # (출발, 도착, 장애 유형)별 빈도가 서로 다른 질의를 섞어서 기록
+        frequencies = {
+            (codes[0], codes[3], "PHY"): 400,
+            (codes[1], codes[4], "VIS"): 250,
+            (codes[2], codes[5], "PHY"): 120,
+            (codes[0], codes[3], "ELD"): 60,
+            (codes[4], codes[1], "AUD"): 30,
+            (codes[5], codes[2], "PHY"): 10,
+        }
+        queries = [key for key, n in frequencies.items() for _ in range(n)]
+        random.Random(7).shuffle(queries)
+        exact = Counter()
+        for i, (o, d, dtype) in enumerate(queries):
+            exact[(o, d, dtype)] += 1
+            assert sketch.record(o, d, dtype, base + i * 0.01)
+        assert not sketch.record("없는역", codes[0], "PHY", base)
+        assert sketch.total == len(queries)
+
+        top = sketch.top(5)
+        expected = exact.most_common(5)
+        assert [(o, d, t) for o, d, t, _, _ in top] == [k for k, _ in expected]
+        assert all(s == slot for _, _, _, s, _ in top)
+        assert [c for *_, c in top] == [c for _, c in expected]
+        assert sketch.estimate(codes[0], codes[3], "PHY", slot) >= exact[
+            (codes[0], codes[3], "PHY")
+        ]
+
+        # 창(600초) 이후 기록 -> 이전 집계 폐기
+        sketch.record(codes[0], codes[1], "VIS", base + 1200)
+        assert sketch.total == 1
+        assert len(sketch.top()) == 1
+
+        logger.info(f"✓ 질의 빈도 집계 테스트 통과: 상위 {top[0]}")
+
+    def test_result_cache_persistence(self, service, tmp_path):
+        """결과 캐시 파일: 같은 네트워크/데이터면 최근 항목부터 복원, 지문이 다르면 복원하지 않음"""
+        path = str(tmp_path / "result_cache.bin")
+        data = service.data_container
+        version = data.data_version
+
+        cache = service.cpp_module.ResultCache(data, 8)
+        assert cache.load(path) == 0  # 파일 없음
+        for i in range(10):
+            cache.put(f"key:{i}", bytes([i]) * 16, version)
+        cache.put("stale", b"x", version - 1)
+
+        checkpointer = service.cpp_module.CacheCheckpointer(
+            cache, path, interval_seconds=3600
+        )
+        assert checkpointer.checkpoint()
+        assert checkpointer.stats().last_entries == 8  # 용량 8, 오래된 버전 항목 제외
+        checkpointer.stop()  # 변경 없음 -> 다시 저장하지 않음
+        assert checkpointer.stats().saves == 1
+
+        restored = service.cpp_module.ResultCache(data, 8)
+        assert restored.load(path) == 8
+        assert restored.stats().restored == 8
+        assert "stale" not in restored
+        for i in range(2, 10):
+            assert restored.get(f"key:{i}") == bytes([i]) * 16
+
+        # 용량이 작으면 최근 사용 항목 우선
+        small = service.cpp_module.ResultCache(data, 3)
+        assert small.load(path) == 3
+        assert all(f"key:{i}" in small for i in (7, 8, 9))
+
+        # 내용이 같은 갱신 (data_version만 증가) -> 지문 동일, 새 버전 항목으로 복원
+        fingerprint = data.content_fingerprint
+        data.update_congestion({})
+        assert data.content_fingerprint == fingerprint
+        again = service.cpp_module.ResultCache(data, 8)
+        assert again.load(path) == 8
+        assert "key:9" in again
+
+        # 다른 데이터로 저장된 파일 (내용 지문 불일치) -> 복원하지 않음
+        with open(path, "r+b") as f:
+            f.seek(24)
+            f.write((fingerprint ^ 1).to_bytes(8, sys.byteorder))  # 호스트 바이트 순서
+        assert service.cpp_module.ResultCache(data, 8).load(path) == 0
+
+        with open(path, "r+b") as f:
+            f.write(b"NOTCACHE")
+        with pytest.raises(RuntimeError):
+            service.cpp_module.ResultCache(data, 8).load(path)
+
+        logger.info("✓ 결과 캐시 파일 저장/복원 테스트 통과")
+
+    def test_footpath_graph(self, service):
+        """도보 연결: 이름이 다른 인접 역만, 장애 유형별 허용 도보 시간 이내, 양방향"""
+        from app.algorithms.distance_calculator import DistanceCalculator
+
+        calc = DistanceCalculator()
+        limit = settings.CPP_FOOTPATH_MAX_MINUTES
+        checked = 0
+        for station_cd, info in list(service.stations.items())[:300]:
+            for to_cd, distance, minutes in service.data_container.get_footpaths(
+                station_cd, "PHY"
+            ):
+                to_info = service.stations[to_cd]
+                assert to_info["line"] != info["line"]
+                assert 0 < minutes <= limit + 1e-9
+                assert distance == pytest.approx(
+                    calc.calculate_distance(
+                        info["lat"], info["lng"], to_info["lat"], to_info["lng"]
+                    ),
+                    abs=1.0,
+                )
+                back = service.data_container.get_footpaths(to_cd, "PHY")
+                assert station_cd in [cd for cd, _, _ in back]
+                # 보행 속도가 빠른 유형일수록 같은 연결의 도보 시간이 짧음
+                aud = dict(
+                    (cd, m)
+                    for cd, _, m in service.data_container.get_footpaths(
+                        station_cd, "AUD"
+                    )
+                )
+                assert aud[to_cd] < minutes
+                checked += 1
+
+        logger.info(
+            f"✓ 도보 연결 테스트 통과: 전체 {service.data_container.footpath_count}개, "
+            f"PHY 검증 {checked}개"
+        )
+
+    def test_query_log_background_writer(self, service, tmp_path, monkeypatch):
+        """쿼리 로그: 요청 경로는 큐에 넣기만 하고 기록 스레드가 열어 둔 파일에 순서대로 기록"""
+        path = tmp_path / "queries.csv"
+        monkeypatch.setattr(settings, "CPP_QUERY_LOG_PATH", str(path))
+        monkeypatch.setattr(service, "_query_log_queue", None)
+        monkeypatch.setattr(service, "_query_log_thread", None)
+        service._start_query_log()
+        writer = service._query_log_thread
+        assert writer is not None and writer.is_alive()
+
+        for i in range(100):
+            service._record_query("0222", f"{i:04d}", "PHY", 1.0)
+        service._query_log_queue.put(None)  # 남은 줄 기록 후 종료
+        writer.join(timeout=5)
+        assert not writer.is_alive()
+
+        lines = path.read_text(encoding="utf-8").splitlines()
+        assert len(lines) == 100
+        assert lines[0] == "0222,0000,PHY,1.000"
+        assert lines[-1] == "0222,0099,PHY,1.000"
+
+    def test_footpath_minutes_applied_at_load(self, service, tmp_path):
+        """적재 시 footpath_minutes로 도보 연결 1회 구축 (적재 후 build_footpaths와 같은 결과)"""
+        path = str(tmp_path / "network.snap")
+        service.data_container.save_snapshot(path)
+
+        loaded = service.cpp_module.DataContainer()
+        loaded.load_snapshot(path, footpath_minutes=3.0)
+        rebuilt = service.cpp_module.DataContainer()
+        rebuilt.load_snapshot(path)
+        rebuilt.build_footpaths(3.0)
+        assert loaded.footpath_count == rebuilt.footpath_count
+
+        # 서비스 적재는 설정값으로 구축된 상태 그대로 사용
+        configured = service.cpp_module.DataContainer()
+        configured.load_snapshot(
+            path, footpath_minutes=settings.CPP_FOOTPATH_MAX_MINUTES
+        )
+        assert configured.footpath_count == service.data_container.footpath_count
+
+    def test_distance_matrix(self, service):
+        """역 간 거리 행렬: 읽기 전용 float32 뷰, haversine 커널과 일치"""
+        import numpy as np
+
+        matrix = service.data_container.distance_matrix
+        n = len(service.stations)
+        assert matrix.shape == (n, n)
+        assert matrix.dtype == np.float32
+        assert not matrix.flags.writeable
+        assert np.allclose(matrix, matrix.T)
+
+        codes = [service.data_container.get_code(i) for i in range(0, n, 97)]
+        lats = np.array([service.stations[cd]["lat"] for cd in codes])
+        lons = np.array([service.stations[cd]["lng"] for cd in codes])
+        expected = service.cpp_module.haversine_many_to_many(lats, lons, lats, lons)
+        rows = np.arange(0, n, 97)
+        assert np.allclose(matrix[np.ix_(rows, rows)], expected, rtol=1e-6, atol=0.5)
+
+        logger.info(f"✓ 거리 행렬 테스트 통과: {n}x{n}")
+
+    def test_spatial_index_matches_brute_force(self, service):
+        """공간 인덱스 배치 조회: 전체 역 haversine 전수 비교와 동일한 결과"""
+        import numpy as np
+
+        from app.algorithms.distance_calculator import DistanceCalculator
+
+        rng = np.random.default_rng(42)
+        lats = rng.uniform(37.45, 37.70, 500)
+        lons = rng.uniform(126.80, 127.15, 500)
+
+        ids, dists = service.spatial_index.nearest(lats, lons, 3)
+        assert ids.shape == (500, 3)
+        assert np.all(np.diff(dists, axis=1) >= 0)
+
+        offsets, within_ids, within_dists = service.spatial_index.within(
+            lats, lons, 1000.0
+        )
+        assert len(offsets) == 501
+        assert np.all(within_dists <= 1000.0)
+
+        calc = DistanceCalculator()
+        codes = service.data_container.get_codes(ids[:, 0])
+        for i in range(0, 500, 50):
+            brute = min(
+                calc.calculate_distance(lats[i], lons[i], info["lat"], info["lng"])
+                for info in service.stations.values()
+            )
+            assert dists[i, 0] == pytest.approx(brute, abs=1.0)
+            assert codes[i] in service.stations
+
+        logger.info(
+            f"✓ 공간 인덱스 테스트 통과: {len(service.spatial_index)}개 역, "
+            f"반경 1km 결과 {len(within_ids)}건"
+        )
+
+    def test_station_name_index_matches_python_search(self, service):
+        """역 이름 자동완성: C++ 인덱스와 Python 검색의 순위 동일, 초성 검색"""
+        from app.db import cache
+
+        stations = cache.get_stations_list()
+        index = service.cpp_module.StationNameIndex(
+            [s["station_cd"] for s in stations], [s["name"] for s in stations]
+        )
+        assert len(index) == len(stations)
+
+        for keyword in ["강남", "서울역", "역", "ㄱㄴ", "강ㄴ", "ㅅㅇ", "입구", "이수", "없는역이름"]:
+            native = index.search(keyword, 20)
+            python = [s["station_cd"] for s in cache._search_stations_py(keyword, 20)]
+            assert native == python, keyword
+
+        names = [cache.get_station_name_by_code(cd) for cd in index.search("ㄱㄴ", 10)]
+        assert "강남" in names
+        assert index.search("강남", 1) == [cache.get_station_cd_by_name("강남")]
+        # 정규화로 비는 한 글자 입력 "역"도 "역"으로 시작하는 역을 먼저 반환
+        prefix = [cache.get_station_name_by_code(cd) for cd in index.search("역", 3)]
+        assert prefix and all(name.startswith("역") for name in prefix)
+        # 괄호 안 별칭은 원래 이름 키로 일치
+        alias = service.cpp_module.StationNameIndex(["1", "2"], ["총신대입구(이수)", "사당"])
+        assert alias.search("이수", 5) == ["1"]
+
+        logger.info(f"✓ 역 이름 검색 인덱스 테스트 통과: {index.key_count}개 이름")
+
+    def test_navigation_tracker_batch(self, service):
+        """안내 추적: 경로 역 좌표 배치 업데이트 -> 진행 인덱스/도착/이탈 판정"""
+        import numpy as np
+        from app.db.cache import get_station_cd_by_name
+
+        engine = service.cpp_module.McRaptorEngine(service.data_container)
+        routes = engine.find_routes(
+            get_station_cd_by_name("강남"),
+            {get_station_cd_by_name("서울역")},
+            datetime.now().timestamp(),
+            "PHY",
+            5,
+        )
+        best = engine.rank_routes(routes, "PHY")[0]
+        sequence = engine.reconstruct_route(best, service.data_container)
+
+        tracker = service.cpp_module.NavigationTracker(service.data_container, 800.0)
+        handle = tracker.start(sequence)
+        assert len(tracker) == 1
+
+        lats = np.array([service.stations[cd]["lat"] for cd in sequence] + [37.0])
+        lons = np.array([service.stations[cd]["lng"] for cd in sequence] + [127.5])
+        handles = np.full(len(lats), handle, dtype=np.int32)
+        result = tracker.update(handles, lats, lons)
+
+        flags = result["flags"]
+        assert flags[-1] & tracker.DEVIATED
+        assert flags[-2] & tracker.ARRIVED
+        # 같은 좌표의 환승역은 앞쪽 역으로 매칭됨
+        for i, cd in enumerate(sequence[:-1]):
+            matched = sequence[result["progress_index"][i]]
+            assert service.stations[matched]["lat"] == service.stations[cd]["lat"]
+        assert np.all(np.diff(result["eta_seconds"][:-2]) <= 1e-6)
+
+        assert tracker.end(handle)
+        assert tracker.update(handles[:1], lats[:1], lons[:1])["flags"][0] & tracker.UNKNOWN
+
+        logger.info(f"✓ 안내 추적 테스트 통과: 경로 {len(sequence)}개 역")
+
     def test_station_not_found(self, service):
         """존재하지 않는 역 테스트"""
         with pytest.raises(StationNotFoundException) as exc_info: